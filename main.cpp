@@ -1,13 +1,22 @@
 #include <iostream>
 #include <filesystem>
-#include <fstream>
 #include <string>
 #include <stdexcept>
 #include <cstdlib>
 #include <vector>
-#include <map>
 #include <cctype>
 #include <cstdio>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace fs = std::filesystem;
 
@@ -15,26 +24,164 @@ namespace fs = std::filesystem;
 int main(int argc, char* argv[])
 {
     std::string project_path, project_name;
+    bool use_modules = false;
+    bool quiet = false;     // --quiet: no progress output
+    bool batch = false;     // --batch: queue every file, then write them all concurrently
+    
+    // Files queued in batch mode, written by write_pending_files: embedded templates are kept as views
+    // of the literals, generated files own their text
+    struct PendingFile
+    {
+        fs::path path;
+        std::string_view content;
+        std::string generated;
+    };
+    std::vector<PendingFile> pending_files;
     
     // Helper method to execute system commands
-    auto execute_command = [](const std::string& command)
+    auto execute_command = [&](const std::string& command)
     {
-        std::cout << "Executing: " << command << std::endl;
+        if (!quiet)
+        {
+            std::cout << "Executing: " << command << std::endl;
+        }
         return std::system(command.c_str());
     };
     
-    // Write content to file
-    auto write_file = [](const fs::path& file_path, const std::string& content)
+    // Write content to a new file with one open, as few writes as the kernel allows and one close
+    auto write_whole_file = [](const fs::path& file_path, std::string_view content)
+    {
+        int fd = ::open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw std::runtime_error("ERROR! Could not create file: " + file_path.string() + " (" + std::strerror(errno) + ")");
+        }
+        while (!content.empty())
+        {
+            ssize_t written = ::write(fd, content.data(), content.size());
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (written <= 0)
+            {
+                int error = errno;
+                ::close(fd);
+                throw std::runtime_error("ERROR! Could not write file: " + file_path.string() + " (" + std::strerror(error) + ")");
+            }
+            content.remove_prefix(static_cast<size_t>(written));
+        }
+        if (::close(fd) != 0)
+        {
+            throw std::runtime_error("ERROR! Could not write file: " + file_path.string() + " (" + std::strerror(errno) + ")");
+        }
+    };
+    
+    // Write an embedded template to file (in batch mode it is only queued; write_pending_files writes it)
+    auto write_file = [&](const fs::path& file_path, std::string_view content)
+    {
+        if (batch)
+        {
+            pending_files.push_back({ file_path, content, {} });
+            return;
+        }
+        write_whole_file(file_path, content);
+        if (!quiet)
+        {
+            std::cout << "Created: " << file_path << '\n';
+        }
+    };
+    
+    // Write generated text to file; a queued file keeps the text until it is written
+    auto write_generated_file = [&](const fs::path& file_path, std::string content)
     {
-        std::ofstream file(file_path);
-        if (!file.is_open())
+        if (batch)
         {
-            throw std::runtime_error("ERROR! Could not create file: " + file_path.string());
+            pending_files.push_back({ file_path, {}, std::move(content) });
+            return;
+        }
+        write_file(file_path, content);
+    };
+    
+    // Substitute the {{NAME}} placeholders of a template in one pass into a buffer sized up front;
+    // anything else in braces, and placeholders without a substitution, are copied as they are
+    auto render = [](std::string_view text, std::initializer_list<std::pair<std::string_view, std::string_view>> substitutions)
+    {
+        auto for_each_piece = [&](auto&& emit)
+        {
+            size_t copied = 0;
+            for (size_t open = text.find("{{"); open != std::string_view::npos; open = text.find("{{", open + 1))
+            {
+                size_t close = open + 2;
+                while (close < text.size() && (std::isupper(static_cast<unsigned char>(text[close])) || text[close] == '_'))
+                {
+                    ++close;
+                }
+                if (close == open + 2 || text.substr(close, 2) != "}}")
+                {
+                    continue;
+                }
+                std::string_view placeholder = text.substr(open, close + 2 - open);
+                for (const auto& [name, value] : substitutions)
+                {
+                    if (name == placeholder)
+                    {
+                        emit(text.substr(copied, open - copied));
+                        emit(value);
+                        copied = open + placeholder.size();
+                        break;
+                    }
+                }
+            }
+            emit(text.substr(copied));
+        };
+        size_t size = 0;
+        for_each_piece([&](std::string_view piece) { size += piece.size(); });
+        std::string rendered;
+        rendered.reserve(size);
+        for_each_piece([&](std::string_view piece) { rendered += piece; });
+        return rendered;
+    };
+    
+    // Write every queued file, spread over the hardware threads (files are independent, so order does not matter)
+    auto write_pending_files = [&]()
+    {
+        std::atomic<size_t> next{ 0 };
+        std::exception_ptr failure;
+        std::mutex failure_mutex;
+        auto write_some = [&]()
+        {
+            for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < pending_files.size(); i = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                try
+                {
+                    const PendingFile& file = pending_files[i];
+                    write_whole_file(file.path, file.generated.empty() ? file.content : std::string_view{ file.generated });
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(failure_mutex);
+                    if (!failure)
+                    {
+                        failure = std::current_exception();
+                    }
+                }
+            }
+        };
+        size_t workers = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), (pending_files.size() + 7) / 8);
+        {
+            std::vector<std::jthread> threads;
+            for (size_t w = 1; w < workers; ++w)
+            {
+                threads.emplace_back(write_some);
+            }
+            write_some();
+        }
+        pending_files.clear();
+        if (failure)
+        {
+            std::rethrow_exception(failure);
         }
-        file << content;
-        file.flush();
-        file.close();
-        std::cout << "Created: " << file_path << std::endl;
     };
     
     // Helper method to sanitize project name for C++ identifiers
@@ -57,10 +204,13 @@ int main(int argc, char* argv[])
         return sanitized;
     };
 
-    // Create directory structure
+    // Create directory structure: the project root with its missing parents, then one mkdir per subdirectory
     auto create_directory_structure = [&]()
     {
-        std::cout << "Creating directory structure..." << std::endl;
+        if (!quiet)
+        {
+            std::cout << "Creating directory structure...\n";
+        }
         
         std::vector<std::string> directories = {
             project_path,
@@ -70,23 +220,488 @@ int main(int argc, char* argv[])
             project_path + "/build",
             project_path + "/build/debug",
             project_path + "/build/release",
-            project_path + "/tests"
+            project_path + "/build/bench",
+            project_path + "/tests",
+            project_path + "/bench",
+            project_path + "/.vscode"
         };
+        if (use_modules)
+        {
+            directories.push_back(project_path + "/include/core/modules");
+        }
         
+        fs::create_directories(directories.front());
         for (const auto& dir : directories)
         {
-            fs::create_directories(dir);
-            std::cout << "Created directory: " << dir << std::endl;
+            // parents come first in the list, so every directory after the root is a single mkdir
+            fs::create_directory(dir);
+            if (!quiet)
+            {
+                std::cout << "Created directory: " << dir << '\n';
+            }
         }
     };
     
     // Create template header files
     auto copy_template_headers = [&]()
     {
-        std::cout << "Creating template header files..." << std::endl;
+        if (!quiet)
+        {
+            std::cout << "Creating template header files...\n";
+        }
         
+        // tracing.hpp content (hot-path zones, counters and histograms with Chrome trace export)
+        constexpr std::string_view tracing_content = R"(
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <deque>
+#include <string>
+#include <cstring>
+#include <charconv>
+#include <chrono>
+#include <bit>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+/**********************************************************************************************
+*
+*                   			    Tracing Header
+*                   			-----------------------
+*    		This header provides low-overhead hot-path instrumentation.
+*    		It includes:
+*    		- Scoped zones (CORE_TRACE_SCOPE / trace::Zone), counters and instant events
+*    		  recorded with TSC timestamps into per-thread lock-free ring buffers.
+*    		- Log-linear histograms (CORE_TRACE_HISTOGRAM / trace::Histogram) with percentiles.
+*    		- Export of everything recorded to Chrome trace / Perfetto JSON.
+*    		Everything records only when POORIAYOUSEFI_CORE_TRACING is defined (./builder --trace);
+*    		otherwise the macros expand to nothing and the classes are empty.
+*
+*                   			Developed by: Pooria Yousefi
+*				   				Date: 2025-06-26
+*				   				License: MIT
+*
+**********************************************************************************************/
+
+// Events kept per thread (a power of two); a full buffer overwrites its oldest events
+#if !defined(POORIAYOUSEFI_CORE_TRACE_BUFFER_EVENTS)
+#define POORIAYOUSEFI_CORE_TRACE_BUFFER_EVENTS 16384
+#endif
+
+namespace pooriayousefi::core
+{
+    namespace trace
+    {
+#if defined(POORIAYOUSEFI_CORE_TRACING)
+        inline constexpr bool enabled = true;
+#else
+        inline constexpr bool enabled = false;
+#endif
+
+        // Time-stamp counter (cntvct on AArch64); unserialized, converted to time when exporting
+        inline uint64_t now() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+            uint64_t ticks;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+            return ticks;
+#else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        enum class Kind : uint32_t { zone, counter, instant };
+
+        // name must have static storage duration (a string literal); value is a zone's end or a counter's value
+        struct Event
+        {
+            const char* name;
+            uint64_t begin;
+            uint64_t value;
+            Kind kind;
+            uint32_t reserved;
+        };
+
+        // Single-producer ring: only the owning thread writes, the exporter reads whatever has been published.
+        // Exporting while the owner keeps tracing may observe events that are being overwritten.
+        class ThreadBuffer
+        {
+        public:
+            static constexpr inline size_t capacity = POORIAYOUSEFI_CORE_TRACE_BUFFER_EVENTS;
+            static_assert(std::has_single_bit(capacity), "POORIAYOUSEFI_CORE_TRACE_BUFFER_EVENTS must be a power of two");
+
+            ThreadBuffer(uint32_t thread_id, uint32_t index) :m_events{ std::make_unique<Event[]>(capacity) }, m_written{ 0 }, m_thread_id{ thread_id }, m_index{ index } {}
+
+            inline void push(const Event& event) noexcept
+            {
+                uint64_t i = m_written.load(std::memory_order_relaxed);
+                m_events[i & (capacity - 1)] = event;
+                m_written.store(i + 1, std::memory_order_release);
+            }
+
+            // Calls f(event) for each retained event, oldest first
+            template<class F> void for_each(F&& f) const
+            {
+                uint64_t written = m_written.load(std::memory_order_acquire);
+                for (uint64_t i = written > capacity ? written - capacity : 0; i < written; ++i)
+                    f(m_events[i & (capacity - 1)]);
+            }
+
+            void clear() noexcept { m_written.store(0, std::memory_order_release); }
+            uint32_t thread_id() const noexcept { return m_thread_id; }
+            uint32_t index() const noexcept { return m_index; }
+
+        private:
+            std::unique_ptr<Event[]> m_events;
+            std::atomic<uint64_t> m_written;
+            uint32_t m_thread_id;
+            uint32_t m_index;
+        };
+
+        // Lock-free histogram of unsigned values: 8 linear buckets per power of two (<= 12.5% relative error)
+        class Histogram
+        {
+        public:
+            static constexpr inline size_t sub_buckets = 8;
+            static constexpr inline size_t number_of_buckets = sub_buckets * 62;
+
+            explicit Histogram(const char* name) :m_name{ name }, m_buckets{}, m_count{ 0 }, m_sum{ 0 }, m_min{ UINT64_MAX }, m_max{ 0 } {}
+
+            inline void record([[maybe_unused]] uint64_t value) noexcept
+            {
+                if constexpr (enabled)
+                {
+                    m_buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+                    m_count.fetch_add(1, std::memory_order_relaxed);
+                    m_sum.fetch_add(value, std::memory_order_relaxed);
+                    uint64_t seen = m_min.load(std::memory_order_relaxed);
+                    while (value < seen && !m_min.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+                    seen = m_max.load(std::memory_order_relaxed);
+                    while (value > seen && !m_max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+                }
+            }
+
+            const char* name() const noexcept { return m_name; }
+            uint64_t count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+            uint64_t sum() const noexcept { return m_sum.load(std::memory_order_relaxed); }
+            uint64_t min() const noexcept { return count() == 0 ? 0 : m_min.load(std::memory_order_relaxed); }
+            uint64_t max() const noexcept { return m_max.load(std::memory_order_relaxed); }
+            double mean() const noexcept { return count() == 0 ? 0.0 : static_cast<double>(sum()) / static_cast<double>(count()); }
+
+            // Lower bound of the bucket holding the p-th percentile (0 to 100)
+            uint64_t percentile(double p) const noexcept
+            {
+                uint64_t total = count();
+                if (total == 0)
+                    return 0;
+                auto rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total - 1)) + 1;
+                uint64_t seen = 0;
+                for (size_t i = 0; i < number_of_buckets; ++i)
+                {
+                    seen += m_buckets[i].load(std::memory_order_relaxed);
+                    if (seen >= rank)
+                        return lower_bound_of(i);
+                }
+                return max();
+            }
+
+            void clear() noexcept
+            {
+                for (auto& bucket : m_buckets)
+                    bucket.store(0, std::memory_order_relaxed);
+                m_count.store(0, std::memory_order_relaxed);
+                m_sum.store(0, std::memory_order_relaxed);
+                m_min.store(UINT64_MAX, std::memory_order_relaxed);
+                m_max.store(0, std::memory_order_relaxed);
+            }
+
+        private:
+            static constexpr size_t bucket_of(uint64_t value) noexcept
+            {
+                if (value < sub_buckets)
+                    return static_cast<size_t>(value);
+                size_t exponent = static_cast<size_t>(std::bit_width(value)) - 1;
+                return (exponent - 2) * sub_buckets + static_cast<size_t>((value >> (exponent - 3)) & (sub_buckets - 1));
+            }
+
+            static constexpr uint64_t lower_bound_of(size_t bucket) noexcept
+            {
+                if (bucket < sub_buckets)
+                    return bucket;
+                size_t exponent = bucket / sub_buckets + 2;
+                return (uint64_t{ sub_buckets } | (bucket % sub_buckets)) << (exponent - 3);
+            }
+
+            const char* m_name;
+            std::atomic<uint64_t> m_buckets[number_of_buckets];
+            std::atomic<uint64_t> m_count;
+            std::atomic<uint64_t> m_sum;
+            std::atomic<uint64_t> m_min;
+            std::atomic<uint64_t> m_max;
+        };
+
+// GCC 12 importers of a module reference its thread_local variables as ordinary globals (the link fails) and
+// crash compiling its inline std::string code, so a module interface defines the thread-local accessor and the
+// exporters out of line and importers only call them
+#if defined(POORIAYOUSEFI_CORE_MODULE_INTERFACE)
+#define POORIAYOUSEFI_CORE_TRACE_OUT_OF_LINE
+#else
+#define POORIAYOUSEFI_CORE_TRACE_OUT_OF_LINE inline
+#endif
+
+        namespace detail
+        {
+            POORIAYOUSEFI_CORE_TRACE_OUT_OF_LINE ThreadBuffer*& local_buffer() noexcept
+            {
+                static thread_local ThreadBuffer* buffer{ nullptr };
+                return buffer;
+            }
+        }
+
+        // Owns every thread's buffer and every histogram. Buffers outlive their threads, so a trace written
+        // after joining workers still has their events; the registry itself is never destroyed, so threads
+        // tracing during static destruction stay safe.
+        class Registry
+        {
+        public:
+            static Registry& instance()
+            {
+                static Registry* registry = new Registry{};
+                return *registry;
+            }
+
+            inline ThreadBuffer& local()
+            {
+                ThreadBuffer*& buffer = detail::local_buffer();
+                if (buffer == nullptr)
+                {
+                    std::scoped_lock lock{ m_mutex };
+                    auto index = static_cast<uint32_t>(m_buffers.size());
+                    m_buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(::syscall(SYS_gettid)), index));
+                    buffer = m_buffers.back().get();
+                }
+                return *buffer;
+            }
+
+            Histogram& histogram(const char* name)
+            {
+                std::scoped_lock lock{ m_mutex };
+                for (auto& histogram : m_histograms)
+                    if (std::strcmp(histogram.name(), name) == 0)
+                        return histogram;
+                return m_histograms.emplace_back(name);
+            }
+
+            void clear()
+            {
+                std::scoped_lock lock{ m_mutex };
+                for (auto& buffer : m_buffers)
+                    buffer->clear();
+                for (auto& histogram : m_histograms)
+                    histogram.clear();
+            }
+
+            // Chrome trace event format (chrome://tracing, ui.perfetto.dev): zones are complete ("X") events,
+            // counters "C" events, instants "i" events, histograms summarized under otherData
+            std::string to_chrome_json()
+            {
+                std::scoped_lock lock{ m_mutex };
+                double ticks_per_us = calibrate();
+                std::string pid = std::to_string(::getpid());
+                std::string out{ "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" };
+                bool first = true;
+                auto open_event = [&](const char* name, const char* phase, uint32_t tid)
+                {
+                    out += first ? "\n{\"name\":" : ",\n{\"name\":";
+                    first = false;
+                    append_string(out, name);
+                    out += ",\"ph\":\"";
+                    out += phase;
+                    out += "\",\"pid\":" + pid + ",\"tid\":" + std::to_string(tid);
+                };
+                auto append_time = [&](const char* key, double ticks)
+                {
+                    out += key;
+                    append_number(out, ticks / ticks_per_us);
+                };
+                for (const auto& buffer : m_buffers)
+                {
+                    open_event("thread_name", "M", buffer->thread_id());
+                    out += ",\"args\":{\"name\":\"thread " + std::to_string(buffer->index()) + "\"}}";
+                    buffer->for_each([&](const Event& event)
+                    {
+                        auto begin = static_cast<double>(static_cast<int64_t>(event.begin - m_epoch));
+                        switch (event.kind)
+                        {
+                        case Kind::zone:
+                            open_event(event.name, "X", buffer->thread_id());
+                            append_time(",\"ts\":", begin);
+                            append_time(",\"dur\":", static_cast<double>(event.value - event.begin));
+                            out += ",\"cat\":\"core\"}";
+                            break;
+                        case Kind::counter:
+                            open_event(event.name, "C", buffer->thread_id());
+                            append_time(",\"ts\":", begin);
+                            out += ",\"args\":{\"value\":" + std::to_string(static_cast<int64_t>(event.value)) + "}}";
+                            break;
+                        case Kind::instant:
+                            open_event(event.name, "i", buffer->thread_id());
+                            append_time(",\"ts\":", begin);
+                            out += ",\"s\":\"t\"}";
+                            break;
+                        }
+                    });
+                }
+                out += "\n],\"otherData\":{\"histograms\":{";
+                first = true;
+                for (const auto& histogram : m_histograms)
+                {
+                    out += first ? "\n" : ",\n";
+                    first = false;
+                    append_string(out, histogram.name());
+                    out += ":{\"count\":" + std::to_string(histogram.count()) + ",\"min\":" + std::to_string(histogram.min()) +
+                        ",\"max\":" + std::to_string(histogram.max()) + ",\"mean\":";
+                    append_number(out, histogram.mean());
+                    out += ",\"p50\":" + std::to_string(histogram.percentile(50.0)) + ",\"p90\":" + std::to_string(histogram.percentile(90.0)) +
+                        ",\"p99\":" + std::to_string(histogram.percentile(99.0)) + "}";
+                }
+                out += "}}}\n";
+                return out;
+            }
+
+        private:
+            Registry() :m_mutex{}, m_buffers{}, m_histograms{}, m_epoch{ now() }, m_epoch_time{ std::chrono::steady_clock::now() } {}
+
+            // Ticks per microsecond since the registry was created (at least 10 ms, to keep the ratio precise)
+            double calibrate() const
+            {
+                auto elapsed = std::chrono::steady_clock::now() - m_epoch_time;
+                while (elapsed < std::chrono::milliseconds{ 10 })
+                    elapsed = std::chrono::steady_clock::now() - m_epoch_time;
+                uint64_t ticks = now() - m_epoch;
+                return static_cast<double>(ticks) / std::chrono::duration<double, std::micro>(elapsed).count();
+            }
+
+            static void append_number(std::string& out, double value)
+            {
+                char buffer[64];
+                auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 3);
+                out.append(buffer, error == std::errc{} ? end : buffer);
+            }
+
+            static void append_string(std::string& out, const char* value)
+            {
+                out += '"';
+                for (; *value != '\0'; ++value)
+                {
+                    if (*value == '"' || *value == '\\')
+                        out += '\\';
+                    if (static_cast<unsigned char>(*value) >= 0x20)
+                        out += *value;
+                }
+                out += '"';
+            }
+
+            std::mutex m_mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+            std::deque<Histogram> m_histograms;
+            uint64_t m_epoch;
+            std::chrono::steady_clock::time_point m_epoch_time;
+        };
+
+#if defined(POORIAYOUSEFI_CORE_TRACING)
+        // Records a complete event from construction to destruction on the calling thread
+        class Zone
+        {
+        public:
+            explicit Zone(const char* name) noexcept :m_name{ name }, m_begin{ now() } {}
+            Zone(const Zone&) = delete;
+            Zone& operator=(const Zone&) = delete;
+            ~Zone() { Registry::instance().local().push(Event{ m_name, m_begin, now(), Kind::zone, 0 }); }
+
+        private:
+            const char* m_name;
+            uint64_t m_begin;
+        };
+
+        // A start time carried across a suspension, closed by span()
+        struct Stamp
+        {
+            uint64_t begin{ 0 };
+        };
+
+        inline Stamp stamp() noexcept { return Stamp{ now() }; }
+        inline void span(const char* name, Stamp start) { Registry::instance().local().push(Event{ name, start.begin, now(), Kind::zone, 0 }); }
+        inline void counter(const char* name, int64_t value) { Registry::instance().local().push(Event{ name, now(), static_cast<uint64_t>(value), Kind::counter, 0 }); }
+        inline void instant(const char* name) { Registry::instance().local().push(Event{ name, now(), 0, Kind::instant, 0 }); }
+#else
+        class Zone
+        {
+        public:
+            constexpr explicit Zone(const char*) noexcept {}
+            Zone(const Zone&) = delete;
+            Zone& operator=(const Zone&) = delete;
+        };
+
+        struct Stamp {};
+
+        constexpr Stamp stamp() noexcept { return Stamp{}; }
+        constexpr void span(const char*, Stamp) noexcept {}
+        constexpr void counter(const char*, int64_t) noexcept {}
+        constexpr void instant(const char*) noexcept {}
+#endif
+
+        // The histogram registered under name (created on first use; keep the reference, the lookup takes a lock)
+        POORIAYOUSEFI_CORE_TRACE_OUT_OF_LINE Histogram& histogram(const char* name) { return Registry::instance().histogram(name); }
+
+        POORIAYOUSEFI_CORE_TRACE_OUT_OF_LINE std::string to_chrome_json() { return Registry::instance().to_chrome_json(); }
+
+        // Writes to_chrome_json() to path; false if the file cannot be written
+        POORIAYOUSEFI_CORE_TRACE_OUT_OF_LINE bool write_chrome_trace(const char* path)
+        {
+            std::string json = to_chrome_json();
+            std::FILE* file = std::fopen(path, "wb");
+            if (file == nullptr)
+                return false;
+            bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+            return std::fclose(file) == 0 && written;
+        }
+
+        // Drops every recorded event and histogram sample
+        POORIAYOUSEFI_CORE_TRACE_OUT_OF_LINE void clear() { Registry::instance().clear(); }
+    }
+}
+
+// Macros are not exported by modules: importers of pooriayousefi.core use trace::Zone and friends directly
+#if defined(POORIAYOUSEFI_CORE_TRACING)
+#define POORIAYOUSEFI_CORE_TRACE_CONCAT_IMPL(a, b) a##b
+#define POORIAYOUSEFI_CORE_TRACE_CONCAT(a, b) POORIAYOUSEFI_CORE_TRACE_CONCAT_IMPL(a, b)
+#define CORE_TRACE_SCOPE(name) ::pooriayousefi::core::trace::Zone POORIAYOUSEFI_CORE_TRACE_CONCAT(core_trace_zone_, __LINE__){ name }
+#define CORE_TRACE_COUNTER(name, value) ::pooriayousefi::core::trace::counter(name, static_cast<int64_t>(value))
+#define CORE_TRACE_INSTANT(name) ::pooriayousefi::core::trace::instant(name)
+#define CORE_TRACE_HISTOGRAM(name, value) \
+    do \
+    { \
+        static ::pooriayousefi::core::trace::Histogram& core_trace_histogram = ::pooriayousefi::core::trace::histogram(name); \
+        core_trace_histogram.record(static_cast<uint64_t>(value)); \
+    } while (false)
+#else
+#define CORE_TRACE_SCOPE(name) static_cast<void>(0)
+#define CORE_TRACE_COUNTER(name, value) static_cast<void>(0)
+#define CORE_TRACE_INSTANT(name) static_cast<void>(0)
+#define CORE_TRACE_HISTOGRAM(name, value) static_cast<void>(0)
+#endif
+)";
+
         // asyncops.hpp content
-        std::string asyncops_content = R"(
+        constexpr std::string_view asyncops_content = R"(
 #pragma once
 #include <stdexcept>
 #include <exception>
@@ -99,7 +714,23 @@ int main(int argc, char* argv[])
 #include <utility>
 #include <semaphore>
 #include <memory>
+#include <memory_resource>
 #include <cassert>
+#include <atomic>
+#include <array>
+#include <tuple>
+#include <optional>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <cstddef>
+#include <algorithm>
+#include <ranges>
+#include <iterator>
+#include <type_traits>
+#include <bit>
+#include "tracing.hpp"
+#include "memory.hpp"
 
 /**********************************************************************************************
 *
@@ -107,11 +738,23 @@ int main(int argc, char* argv[])
 *                   			-----------------------
 *    			This header provides utilities for asynchronous programming
 *    			using C++20 coroutines. It includes:
-*    			- A Generator class template for creating coroutine-based generators.
+*    			- A Generator class template for creating coroutine-based generators
+*    			  (reference-yielding, recursive via elements_of, an input_range).
+*    			- Coroutine frame allocation that recycles frames per thread or uses
+*    			  an allocator passed as (std::allocator_arg, alloc).
+*    			- ObjectPool and ConcurrentObjectPool class templates that construct
+*    			  objects in place in chunked storage and recycle their slots.
 *    			- A GeneratorFactory class template for managing pools of objects.
 *    			- An awaitable Task class template for defining asynchronous tasks.
 *    			- A SyncWaitTask class template and sync_wait function for synchronously
 *    			  waiting on asynchronous tasks to complete.
+*    			- A work-stealing ThreadPool whose schedule() awaitable resumes a
+*    			  coroutine on one of its workers.
+*    			- when_all functions for awaiting several tasks fanned out across a pool.
+*    			- Lock-free SpscRing / MpmcRing ring buffers and the SpscChannel / MpmcChannel
+*    			  built on them, with try_, blocking and co_await-able send / receive.
+*    			- Generator, Task, sync_wait, ThreadPool and when_all resume points recorded
+*    			  as tracing.hpp zones when POORIAYOUSEFI_CORE_TRACING is defined.
 *
 *                   			Developed by: Pooria Yousefi
 *				   				Date: 2025-06-26
@@ -122,1101 +765,9217 @@ int main(int argc, char* argv[])
 // namespace pooriayousefi::core
 namespace pooriayousefi::core
 {
-    template<class T> 
-	struct Generator
+// GCC 12 cannot write a thread_local with a destructor into a module interface (internal compiler error),
+// so module builds with it allocate frames straight from the heap
+#if defined(POORIAYOUSEFI_CORE_MODULE_INTERFACE) && defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 13
+#define POORIAYOUSEFI_CORE_NO_FRAME_CACHE
+#endif
+
+	// Per-thread cache of freed coroutine frames in 64-byte size classes. Frames freed on another thread
+	// (e.g. a Task finished on a pool worker) land in that thread's cache; each class keeps a bounded number.
+	class RecyclingFrameAllocator
 	{
-		struct Promise
+	public:
+		static constexpr inline size_t granularity = 64;
+		static constexpr inline size_t number_of_size_classes = 32;
+		static constexpr inline size_t max_cached_frames_per_class = 64;
+
+#if defined(POORIAYOUSEFI_CORE_NO_FRAME_CACHE)
+		static inline void* allocate(size_t size) { return ::operator new(size); }
+		static inline void deallocate(void* ptr, size_t size) noexcept { ::operator delete(ptr, size); }
+	};
+#else
+
+		static inline void* allocate(size_t size)
 		{
-			T current_value;
-			inline decltype(auto) initial_suspend() { return std::suspend_always{}; }
-			inline decltype(auto) final_suspend() noexcept { return std::suspend_always{}; }
-			inline decltype(auto) get_return_object() { return Generator{ std::coroutine_handle<Promise>::from_promise(*this) }; }
-			inline decltype(auto) return_void() { return std::suspend_never{}; }
-			inline decltype(auto) yield_value(T&& value) noexcept { current_value = value; return std::suspend_always{}; }
-			inline void unhandled_exception() { std::terminate(); }
+			size_t size_class = (size + granularity - 1) / granularity;
+			if (size_class > number_of_size_classes || tls_cache_destroyed)
+				return ::operator new(size_class * granularity);
+			auto& bin = cache().bins[size_class - 1];
+			if (bin.head == nullptr)
+				return ::operator new(size_class * granularity);
+			--bin.count;
+			return std::exchange(bin.head, bin.head->next);
+		}
+
+		static inline void deallocate(void* ptr, size_t size) noexcept
+		{
+			size_t size_class = (size + granularity - 1) / granularity;
+			if (size_class > number_of_size_classes || tls_cache_destroyed)
+				return ::operator delete(ptr, size_class * granularity);
+			auto& bin = cache().bins[size_class - 1];
+			if (bin.count == max_cached_frames_per_class)
+				return ::operator delete(ptr, size_class * granularity);
+			++bin.count;
+			bin.head = ::new (ptr) FreeFrame{ bin.head };
+		}
+
+	private:
+		struct FreeFrame
+		{
+			FreeFrame* next;
 		};
-        using promise_type = Promise;
-		struct Sentinel {};
-		struct Iterator
+
+		struct Bin
 		{
-			using iterator_category = std::input_iterator_tag;
-			using value_type = T;
-			using difference_type = ptrdiff_t;
-			using pointer = T*;
-			using reference = T&;
-			using const_reference = const T&;
-			std::coroutine_handle<promise_type> handle;
-			explicit Iterator(std::coroutine_handle<promise_type>& h) :handle{ h } {}
-			inline Iterator& operator++()
+			FreeFrame* head{ nullptr };
+			size_t count{ 0 };
+		};
+
+		struct Cache
+		{
+			std::array<Bin, number_of_size_classes> bins{};
+			~Cache()
 			{
-				handle.resume();
-				return *this;
+				for (size_t i = 0; i < bins.size(); ++i)
+					while (bins[i].head != nullptr)
+						::operator delete(std::exchange(bins[i].head, bins[i].head->next), (i + 1) * granularity);
+				tls_cache_destroyed = true;
 			}
-			inline void operator++(int) { (void)operator++(); }
-			inline reference operator*() { return handle.promise().current_value; }
-			inline pointer operator->() { return std::addressof(operator*()); }
-			inline const_reference operator*() const { return handle.promise().current_value; }
-			inline pointer operator->() const { return std::addressof(operator*()); }
-			inline bool operator==(Sentinel) { return handle.done(); }
-			inline bool operator==(Sentinel) const { return handle.done(); }
 		};
-		std::coroutine_handle<promise_type> handle;
-		explicit Generator(std::coroutine_handle<promise_type> h) :handle{ h } {}
-		~Generator() { if (handle) handle.destroy(); }
-		Generator(const Generator&) = delete;
-		Generator(Generator&& other) noexcept :handle(other.handle) { other.handle = nullptr; }
-		constexpr Generator& operator=(const Generator&) = delete;
-		constexpr Generator& operator=(Generator&& other) noexcept { handle = other.handle; other.handle = nullptr; return *this; }
-		inline T get_value() { return handle.promise().current_value; }
-		inline bool next() { handle.resume(); return !handle.done(); }
-		inline bool resume() { handle.resume(); return !handle.done(); }
-		inline decltype(auto) begin()
-		{
-			handle.resume();
-			return Iterator{ handle };
-		}
-		inline decltype(auto) end() { return Sentinel{}; }
-		inline T get_next_value()
+
+		// Frames destroyed by other thread_local destructors after the cache is gone go straight to the heap
+		static inline thread_local bool tls_cache_destroyed{ false };
+
+		static inline Cache& cache()
 		{
-			next();
-			if (handle.done()) throw std::out_of_range{ "Generator exhausted" };
-			return get_value();
+			static thread_local Cache thread_cache{};
+			return thread_cache;
 		}
 	};
+#endif
 
-    template<class T, size_t N = 128> 
-	class GeneratorFactory
+	// Base class for promise types that routes coroutine frame allocation through RecyclingFrameAllocator,
+	// or through a caller-supplied allocator when the coroutine's first parameters are
+	// (std::allocator_arg_t, const Alloc&) (after the object parameter for member coroutines).
+	// A trailer behind each frame records how to free it, since operator delete only gets the frame size.
+	struct CoroutineFrameAllocation
 	{
-	public:
-        using Pool = std::vector<T>;
-        using Pools = std::forward_list<Pool>;
-        static constexpr inline size_t number_of_objects_in_each_pool = N;
+	private:
+		struct FrameTrailer
+		{
+			void (*deallocate)(void* frame, size_t size) noexcept;
+		};
 
-		GeneratorFactory():m_pools{}, m_object_counter{ 0 }
+		struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) FrameBlock
 		{
-			m_pools.emplace_front(Pool(number_of_objects_in_each_pool, T{}));
-		}
+			std::byte bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+		};
 
-		virtual ~GeneratorFactory()
+		static constexpr size_t trailer_offset(size_t size) noexcept
 		{
-			for (auto& pool : m_pools)
-			{
-				pool.clear();
-			}
-			m_pools.clear();
+			return (size + alignof(FrameTrailer) - 1) / alignof(FrameTrailer) * alignof(FrameTrailer);
 		}
 
-		inline Generator<std::shared_ptr<T>> generate()
+		static constexpr size_t allocator_offset(size_t size) noexcept
 		{
-			while (true)
-			{
-                if (m_object_counter < number_of_objects_in_each_pool)
-                {
-                    co_yield std::make_shared<T>(m_pools.begin()->data()[m_object_counter++]);
-                }
-                else
-                {
-                    m_pools.emplace_front(Pool(number_of_objects_in_each_pool, T{}));
-                    m_object_counter = 0;
-                }
-			}
+			return (trailer_offset(size) + sizeof(FrameTrailer) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+		}
+
+		template<class Alloc> using BlockAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<FrameBlock>;
+
+		template<class Alloc> static constexpr size_t number_of_blocks(size_t size) noexcept
+		{
+			return (allocator_offset(size) + sizeof(BlockAllocator<Alloc>) + sizeof(FrameBlock) - 1) / sizeof(FrameBlock);
+		}
+
+		static inline FrameTrailer& trailer(void* frame, size_t size) noexcept
+		{
+			return *std::launder(reinterpret_cast<FrameTrailer*>(static_cast<std::byte*>(frame) + trailer_offset(size)));
+		}
+
+		static inline void deallocate_recycled(void* frame, size_t size) noexcept
+		{
+			RecyclingFrameAllocator::deallocate(frame, trailer_offset(size) + sizeof(FrameTrailer));
+		}
+
+		template<class Alloc> static void deallocate_with(void* frame, size_t size) noexcept
+		{
+			auto* stored = std::launder(reinterpret_cast<BlockAllocator<Alloc>*>(static_cast<std::byte*>(frame) + allocator_offset(size)));
+			BlockAllocator<Alloc> allocator{ std::move(*stored) };
+			stored->~BlockAllocator<Alloc>();
+			std::allocator_traits<BlockAllocator<Alloc>>::deallocate(allocator, static_cast<FrameBlock*>(frame), number_of_blocks<Alloc>(size));
+		}
+
+		template<class Alloc> static void* allocate_with(size_t size, const Alloc& alloc)
+		{
+			static_assert(alignof(BlockAllocator<Alloc>) <= alignof(std::max_align_t), "over-aligned frame allocators are not supported");
+			BlockAllocator<Alloc> allocator{ alloc };
+			void* frame = std::allocator_traits<BlockAllocator<Alloc>>::allocate(allocator, number_of_blocks<Alloc>(size));
+			::new (static_cast<std::byte*>(frame) + allocator_offset(size)) BlockAllocator<Alloc>{ std::move(allocator) };
+			::new (static_cast<std::byte*>(frame) + trailer_offset(size)) FrameTrailer{ &deallocate_with<Alloc> };
+			return frame;
+		}
+
+	public:
+		static inline void* operator new(size_t size)
+		{
+			void* frame = RecyclingFrameAllocator::allocate(trailer_offset(size) + sizeof(FrameTrailer));
+			::new (static_cast<std::byte*>(frame) + trailer_offset(size)) FrameTrailer{ &deallocate_recycled };
+			return frame;
+		}
+
+		// Free coroutine: R f(std::allocator_arg_t, const Alloc&, ...)
+		template<class Alloc, class... Args> static inline void* operator new(size_t size, std::allocator_arg_t, const Alloc& alloc, Args&&...)
+		{
+			return allocate_with(size, alloc);
+		}
+
+		// Member coroutine: R C::f(std::allocator_arg_t, const Alloc&, ...)
+		template<class This, class Alloc, class... Args> static inline void* operator new(size_t size, This&&, std::allocator_arg_t, const Alloc& alloc, Args&&...)
+		{
+			return allocate_with(size, alloc);
+		}
+
+		static inline void operator delete(void* frame, size_t size) noexcept
+		{
+			trailer(frame, size).deallocate(frame, size);
 		}
-	private:
-		Pools m_pools;
-		size_t m_object_counter;
 	};
 
-	template<class T> 
-    struct Task
+	// Wraps a range so that co_yield elements_of(range) yields each of its elements;
+	// an rvalue Generator of the same type is resumed directly instead of being iterated
+	template<class R>
+	struct elements_of
+	{
+		R range;
+	};
+	template<class R> elements_of(R&&) -> elements_of<R&&>;
+
+	// Generator<Ref, Val> in the spirit of std::generator: the promise stores a pointer to the yielded object,
+	// so neither yielding nor dereferencing copies it. Unlike std::generator, Generator<T> dereferences to T&
+	// (not T&&) so that 'for (auto& x : gen)' keeps working; use Generator<T&&> for move semantics.
+	// Nested generators (co_yield elements_of(gen)) are resumed directly from the iterator, so every
+	// element costs O(1) regardless of the nesting depth.
+    template<class Ref, class Val = void>
+	struct Generator :std::ranges::view_interface<Generator<Ref, Val>>
 	{
-		struct promise_type
+		using value_type = std::conditional_t<std::is_void_v<Val>, std::remove_cvref_t<Ref>, Val>;
+		using reference = std::conditional_t<std::is_void_v<Val>, std::conditional_t<std::is_reference_v<Ref>, Ref, Ref&>, Ref>;
+		using yielded = std::conditional_t<std::is_reference_v<reference>, reference, const reference&>;
+
+		struct Promise :CoroutineFrameAllocation
 		{
-			std::variant<std::monostate, T, std::exception_ptr> result;
-			std::coroutine_handle<> continuation;
-			constexpr decltype(auto) get_return_object() noexcept { return Task{ *this }; }
-			constexpr void return_value(T value) { result.template emplace<1>(std::move(value)); }
-			constexpr void unhandled_exception() noexcept { result.template emplace<2>(std::current_exception()); }
-			constexpr decltype(auto) initial_suspend() { return std::suspend_always{}; }
-			struct awaitable
+			using yielded_object = std::remove_reference_t<yielded>;
+
+			std::add_pointer_t<yielded> value{ nullptr };
+			// The outermost generator's promise (this one unless nested) and, on the root, the innermost running generator
+			Promise* root{ this };
+			std::coroutine_handle<Promise> active{};
+			std::coroutine_handle<Promise> parent{};
+			std::exception_ptr error{ nullptr };
+
+			// Holds a copy of a yielded lvalue that cannot be referenced as 'yielded' directly
+			struct CopyAwaitable
+			{
+				std::remove_cvref_t<yielded> copy;
+				Promise& promise;
+				constexpr bool await_ready() noexcept { return false; }
+				inline void await_suspend(std::coroutine_handle<>) noexcept { promise.root->value = std::addressof(copy); }
+				constexpr void await_resume() noexcept {}
+			};
+
+			struct NestedAwaitable
+			{
+				Generator nested;
+				inline bool await_ready() noexcept { return !nested.handle; }
+				inline std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
+				{
+					auto& promise = nested.handle.promise();
+					promise.root = h.promise().root;
+					promise.parent = h;
+					promise.root->active = nested.handle;
+					return nested.handle;
+				}
+				inline void await_resume()
+				{
+					if (nested.handle && nested.handle.promise().error)
+						std::rethrow_exception(nested.handle.promise().error);
+				}
+			};
+
+			struct FinalAwaitable
 			{
 				constexpr bool await_ready() noexcept { return false; }
-				constexpr decltype(auto) await_suspend(std::coroutine_handle<promise_type> h) noexcept
+				inline std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
 				{
-					return h.promise().continuation;
+					auto& promise = h.promise();
+					if (!promise.parent)
+						return std::noop_coroutine();
+					promise.root->active = promise.parent;
+					return promise.parent;
 				}
 				constexpr void await_resume() noexcept {}
 			};
-			constexpr decltype(auto) final_suspend() noexcept { return awaitable{}; }
+
+			inline decltype(auto) initial_suspend() { return std::suspend_always{}; }
+			inline decltype(auto) final_suspend() noexcept { return FinalAwaitable{}; }
+			inline decltype(auto) get_return_object()
+			{
+				active = std::coroutine_handle<Promise>::from_promise(*this);
+				return Generator{ active };
+			}
+			inline void return_void() noexcept {}
+
+			inline decltype(auto) yield_value(yielded x) noexcept
+			{
+				root->value = std::addressof(x);
+				return std::suspend_always{};
+			}
+
+			// Generator<T>: temporaries are referenced in place; they live until the generator is resumed
+			inline decltype(auto) yield_value(std::remove_cv_t<yielded_object>&& x) noexcept
+				requires (std::is_lvalue_reference_v<yielded> && !std::is_const_v<yielded_object>)
+			{
+				root->value = std::addressof(x);
+				return std::suspend_always{};
+			}
+
+			inline decltype(auto) yield_value(const std::remove_cv_t<yielded_object>& x)
+				requires (!std::is_const_v<yielded_object> && std::is_copy_constructible_v<std::remove_cv_t<yielded_object>>)
+			{
+				return CopyAwaitable{ x, *this };
+			}
+
+			template<class R> inline decltype(auto) yield_value(elements_of<R> x)
+			{
+				if constexpr (std::is_same_v<std::remove_cvref_t<R>, Generator> && !std::is_lvalue_reference_v<R>)
+					return NestedAwaitable{ std::move(x.range) };
+				else
+					return NestedAwaitable{ iterate(x.range) };
+			}
+
+			template<class Range> static Generator iterate(Range& range)
+			{
+				for (auto&& element : range)
+					co_yield std::forward<decltype(element)>(element);
+			}
+
+			inline void unhandled_exception()
+			{
+				if (root == this)
+					throw;
+				error = std::current_exception();
+			}
+		};
+        using promise_type = Promise;
+		using Sentinel = std::default_sentinel_t;
+		struct Iterator
+		{
+			using iterator_concept = std::input_iterator_tag;
+			using value_type = Generator::value_type;
+			using difference_type = ptrdiff_t;
+			using reference = Generator::reference;
+			using pointer = std::add_pointer_t<reference>;
+			std::coroutine_handle<promise_type> handle;
+			Iterator() noexcept :handle{} {}
+			explicit Iterator(std::coroutine_handle<promise_type> h) noexcept :handle{ h } {}
+			inline Iterator& operator++()
+			{
+				trace::Zone zone{ "Generator::resume" };
+				handle.promise().active.resume();
+				return *this;
+			}
+			inline void operator++(int) { (void)operator++(); }
+			inline reference operator*() const { return static_cast<reference>(*handle.promise().value); }
+			inline pointer operator->() const requires std::is_reference_v<reference> { return std::addressof(operator*()); }
+			inline bool operator==(std::default_sentinel_t) const { return handle.done(); }
 		};
 		std::coroutine_handle<promise_type> handle;
-		explicit Task(promise_type& p) noexcept :handle{ std::coroutine_handle<promise_type>::from_promise(p) } {}
-		Task(Task&& t) noexcept :handle{ t.handle } {}
-		~Task() { if (handle) handle.destroy(); }
-		constexpr bool await_ready() { return false; }
-		constexpr decltype(auto) await_suspend(std::coroutine_handle<> c)
+		Generator() noexcept :handle{} {}
+		explicit Generator(std::coroutine_handle<promise_type> h) :handle{ h } {}
+		~Generator() { if (handle) handle.destroy(); }
+		Generator(const Generator&) = delete;
+		Generator(Generator&& other) noexcept :handle(other.handle) { other.handle = nullptr; }
+		constexpr Generator& operator=(const Generator&) = delete;
+		Generator& operator=(Generator&& other) noexcept
 		{
-			handle.promise().continuation = c;
-			return handle;
+			if (this != std::addressof(other))
+			{
+				if (handle)
+					handle.destroy();
+				handle = std::exchange(other.handle, nullptr);
+			}
+			return *this;
 		}
-		constexpr T await_resume()
+		inline value_type get_value()
 		{
-			auto& result = handle.promise().result;
-			if (result.index() == 1)
-				return std::get<1>(std::move(result));
+			// Move-only values (e.g. pooled handles) are handed out rather than copied
+			if constexpr (std::is_copy_constructible_v<value_type>)
+				return static_cast<reference>(*handle.promise().value);
 			else
-				std::rethrow_exception(std::get<2>(std::move(result)));
+				return std::move(*handle.promise().value);
+		}
+		inline bool next()
+		{
+			trace::Zone zone{ "Generator::resume" };
+			handle.promise().active.resume();
+			return !handle.done();
+		}
+		inline bool resume() { return next(); }
+		inline Iterator begin()
+		{
+			trace::Zone zone{ "Generator::resume" };
+			handle.promise().active.resume();
+			return Iterator{ handle };
+		}
+		inline Sentinel end() const noexcept { return std::default_sentinel; }
+		inline value_type get_next_value()
+		{
+			next();
+			if (handle.done()) throw std::out_of_range{ "Generator exhausted" };
+			return get_value();
 		}
 	};
-	template<> 
-    struct Task<void>
+
+    // Fixed-size slot storage shared by ObjectPool and ConcurrentObjectPool: chunks of N slots that are never
+    // moved or freed while the pool lives, so handed-out pointers stay valid. Chunks come from a
+    // std::pmr::memory_resource (e.g. a memory::Arena), the default resource unless one is given.
+	template<class T, size_t N>
+	struct ObjectPoolStorage
 	{
-		struct promise_type
+		union Slot
 		{
-			std::exception_ptr e;
-			std::coroutine_handle<> continuation;
-			inline decltype(auto) get_return_object() noexcept { return Task{ *this }; }
-			constexpr void return_void() {}
-			inline void unhandled_exception() noexcept { e = std::current_exception(); }
-			constexpr decltype(auto) initial_suspend() { return std::suspend_always{}; }
-			struct awaitable
-			{
-				constexpr bool await_ready() noexcept { return false; }
-				inline decltype(auto) await_suspend(std::coroutine_handle<promise_type> h) noexcept
-				{
-					return h.promise().continuation;
-				}
-				constexpr void await_resume() noexcept {}
-			};
-			constexpr decltype(auto) final_suspend() noexcept { return awaitable{}; }
+			Slot* next;
+			alignas(T) std::byte storage[sizeof(T)];
 		};
-		std::coroutine_handle<promise_type> handle;
-		explicit Task(promise_type& p) noexcept :handle{ std::coroutine_handle<promise_type>::from_promise(p) } {}
-		Task(Task&& t) noexcept :handle{ t.handle } {}
-		~Task() { if (handle) handle.destroy(); }
-		constexpr bool await_ready() { return false; }
-		inline decltype(auto) await_suspend(std::coroutine_handle<> c)
+
+		std::pmr::memory_resource* resource;
+		std::vector<Slot*> chunks;
+
+		explicit ObjectPoolStorage(std::pmr::memory_resource* chunk_resource = std::pmr::get_default_resource()) noexcept
+			:resource{ chunk_resource }, chunks{} {}
+		ObjectPoolStorage(const ObjectPoolStorage&) = delete;
+		ObjectPoolStorage& operator=(const ObjectPoolStorage&) = delete;
+		~ObjectPoolStorage()
 		{
-			handle.promise().continuation = c;
-			return handle;
+			for (Slot* chunk : chunks)
+				resource->deallocate(chunk, N * sizeof(Slot), alignof(Slot));
 		}
-		inline void await_resume()
+
+		// Allocate one more chunk and thread its slots into a free list; returns the list head
+		inline Slot* grow()
 		{
-			if (handle.promise().e)
-				std::rethrow_exception(handle.promise().e);
+			chunks.reserve(chunks.size() + 1);
+			auto* chunk = static_cast<Slot*>(resource->allocate(N * sizeof(Slot), alignof(Slot)));
+			chunks.push_back(chunk);
+			for (size_t i = 0; i + 1 < N; ++i)
+				chunk[i].next = std::addressof(chunk[i + 1]);
+			chunk[N - 1].next = nullptr;
+			return chunk;
 		}
-	};
 
-	template<class T> using ResultType = decltype(std::declval<T&>().await_resume());
+		template<class... Args> static inline T* construct(Slot* slot, Args&&... args)
+		{
+			return ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+		}
 
-	template<class T> 
-    struct SyncWaitTask
+		static inline Slot* destroy(T* object) noexcept
+		{
+			object->~T();
+			return reinterpret_cast<Slot*>(object);
+		}
+
+		inline size_t capacity() const noexcept { return chunks.size() * N; }
+	};
+
+	// Move-only owning handle to a pooled object; destroying it destroys the object and returns its slot.
+	// The pool must outlive every handle it gave out.
+	template<class T, class Pool>
+	class PoolHandle
 	{
-		struct promise_type
+	public:
+		PoolHandle() noexcept :m_pool{ nullptr }, m_object{ nullptr } {}
+		PoolHandle(Pool* pool, T* object) noexcept :m_pool{ pool }, m_object{ object } {}
+		PoolHandle(const PoolHandle&) = delete;
+		PoolHandle(PoolHandle&& other) noexcept :m_pool{ std::exchange(other.m_pool, nullptr) }, m_object{ std::exchange(other.m_object, nullptr) } {}
+		PoolHandle& operator=(const PoolHandle&) = delete;
+		PoolHandle& operator=(PoolHandle&& other) noexcept
 		{
-			T* value{ nullptr };
-			std::exception_ptr error{ nullptr };
-			std::binary_semaphore sema4{ 0 };
-			inline SyncWaitTask get_return_object() noexcept { return SyncWaitTask{ *this }; }
-			constexpr void unhandled_exception() noexcept { error = std::current_exception(); }
-			constexpr decltype(auto) yield_value(T&& x) noexcept
+			if (this != std::addressof(other))
 			{
-				value = std::addressof(x);
-				return final_suspend();
+				reset();
+				m_pool = std::exchange(other.m_pool, nullptr);
+				m_object = std::exchange(other.m_object, nullptr);
 			}
-			constexpr decltype(auto) initial_suspend() noexcept { return std::suspend_always{}; }
-			struct awaitable
-			{
-				constexpr bool await_ready() noexcept { return false; }
-				constexpr void await_suspend(std::coroutine_handle<promise_type> h) noexcept { h.promise().sema4.release(); }
-				constexpr void await_resume() noexcept {}
-			};
-			constexpr decltype(auto) final_suspend() noexcept { return awaitable{}; }
-			constexpr void return_void() noexcept { assert(false); }
-		};
-		std::coroutine_handle<promise_type> handle;
-		explicit SyncWaitTask(promise_type& p) noexcept :handle{ std::coroutine_handle<promise_type>::from_promise(p) } {}
-		SyncWaitTask(SyncWaitTask&& t) noexcept :handle{ t.handle } {}
-		~SyncWaitTask() { if (handle) handle.destroy(); }
-		inline T&& get()
+			return *this;
+		}
+		~PoolHandle() { reset(); }
+
+		inline void reset() noexcept
 		{
-			auto& p = handle.promise();
-			handle.resume();
-			p.sema4.acquire();
-			if (p.error)
-				std::rethrow_exception(p.error);
-			return static_cast<T&&>(*p.value);
+			if (m_object)
+				m_pool->release(std::exchange(m_object, nullptr));
+			m_pool = nullptr;
 		}
+
+		inline T* get() const noexcept { return m_object; }
+		inline T& operator*() const noexcept { return *m_object; }
+		inline T* operator->() const noexcept { return m_object; }
+		explicit operator bool() const noexcept { return m_object != nullptr; }
+
+	private:
+		Pool* m_pool;
+		T* m_object;
 	};
 
-	template<class T> ResultType<T> sync_wait(T&& Task)
+	// Single-threaded object pool: objects are constructed in place in chunked storage and their slots
+	// are recycled through an intrusive free list, so steady-state acquire/release never touches the heap
+	template<class T, size_t N = 128>
+	class ObjectPool
 	{
-		if constexpr (std::is_void_v<ResultType<T>>)
+	public:
+		using Handle = PoolHandle<T, ObjectPool>;
+		static constexpr inline size_t number_of_objects_in_each_chunk = N;
+
+		ObjectPool() :m_storage{}, m_free{ nullptr }, m_in_use{ 0 } {}
+		explicit ObjectPool(std::pmr::memory_resource* resource) :m_storage{ resource }, m_free{ nullptr }, m_in_use{ 0 } {}
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+		virtual ~ObjectPool() { assert(m_in_use == 0 && "ObjectPool destroyed while handles are alive"); }
+
+		template<class... Args> inline Handle acquire(Args&&... args)
 		{
-			struct empty_type {};
-			auto coro = [&]() -> SyncWaitTask<empty_type>
-				{
-					co_await std::forward<T>(Task);
-					co_yield empty_type{};
-					assert(false);
-				};
-			coro().get();
+			if (m_free == nullptr)
+				m_free = m_storage.grow();
+			auto* slot = std::exchange(m_free, m_free->next);
+			T* object = nullptr;
+			try
+			{
+				object = Storage::construct(slot, std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				slot->next = m_free;
+				m_free = slot;
+				throw;
+			}
+			++m_in_use;
+			return Handle{ this, object };
 		}
-		else
+
+		inline void release(T* object) noexcept
 		{
-			auto coro = [&]() -> SyncWaitTask<ResultType<T>>
-				{
-					co_yield co_await std::forward<T>(Task);
-					assert(false);
-				};
-			return coro().get();
+			auto* slot = Storage::destroy(object);
+			slot->next = m_free;
+			m_free = slot;
+			--m_in_use;
 		}
-	}
-}
-)";
 
-        // raiiiofsw.hpp content
-        std::string raiiiofsw_content = R"(
-#pragma once
-#include <type_traits>
-#include <filesystem>
-#include <stdexcept>
-#include <typeinfo>
-#include <fstream>
-#include <string>
+		inline size_t capacity() const noexcept { return m_storage.capacity(); }
+		inline size_t in_use() const noexcept { return m_in_use; }
 
-/**********************************************************************************************
-*
-*                   			RAII Input/Output File Stream Wrapper
-*                   			-----------------------
-*    			This header provides a RAII wrapper for basic input/output
-*    			file streams. It includes:
-*    			- A BasicInputFileStreamWrapper class template for managing file streams.
-*    			- A BasicOutputFileStreamWrapper class template for managing file streams.
-*    			- Specialization for std::byte for binary file streams.
-*
-*                   			Developed by: Pooria Yousefi
-*				   				Date: 2025-06-26
-*				   				License: MIT
-*
-**********************************************************************************************/
+	private:
+		using Storage = ObjectPoolStorage<T, N>;
+		Storage m_storage;
+		typename Storage::Slot* m_free;
+		size_t m_in_use;
+	};
 
-namespace pooriayousefi::core
-{
-	namespace raii
+	// Thread-safe object pool: every thread keeps a small cache of free slots per pool and only takes the
+	// shared lock to move a batch of N slots between its cache and the shared free list. Handles may be
+	// released on any thread. A thread's cached slots go back to the pool when the thread exits.
+	template<class T, size_t N = 128>
+	class ConcurrentObjectPool
 	{
-		template<typename Elem, typename Traits = std::char_traits<Elem>, typename Alloc = std::allocator<Elem>>
-		struct BasicInputFileStreamWrapper
+	private:
+		using Storage = ObjectPoolStorage<T, N>;
+		using Slot = typename Storage::Slot;
+
+		struct Shared
 		{
-			using file_stream_type = std::basic_ifstream<Elem, Traits>;
-			using type = BasicInputFileStreamWrapper<Elem, Traits, Alloc>;
-			using string_type = std::basic_string<Elem, Traits, Alloc>;
-			using stream_buffer_iterator = std::istreambuf_iterator<Elem, Traits>;
+			std::mutex mutex{};
+			Storage storage{};
+			std::vector<Slot*> free{};
+		};
 
-			file_stream_type file_stream;
-
-			BasicInputFileStreamWrapper() :file_stream{} {}
-			virtual ~BasicInputFileStreamWrapper() { if (is_open()) close(); }
-
-			template<typename T> constexpr type& operator>>(T& value) { file_stream >> value; return *this; }
+		struct Cache
+		{
+			uint64_t pool_id;
+			std::weak_ptr<Shared> shared;
+			std::vector<Slot*> slots;
+		};
 
-			bool is_open() { return file_stream.is_open(); }
-			void close() { file_stream.close(); }
-			void open(std::filesystem::path file_path, std::ios_base::openmode open_mode = std::ios_base::in)
+		// Per-thread caches for every pool this thread touched; a destroyed pool's entry just expires
+		struct ThreadCaches
+		{
+			std::vector<Cache> caches{};
+			~ThreadCaches()
 			{
-				file_stream.open(file_path, std::ios_base::in | open_mode);
-				if (!is_open())
-					throw std::runtime_error(
-						std::string{
-							std::string{ "ERROR! Cannot open "} +
-							file_path.string() +
-							std::string{ " file in raii::BasicInputFileStreamWrapper<" } +
-							std::string{ typeid(Elem).name() } +
-							std::string{ ", " } +
-							std::string{ typeid(Traits).name() } +
-							std::string{ ", " } +
-							std::string{ typeid(Alloc).name() } +
-							std::string{ ">::open() method." }
-						}.c_str()
-					);
+				for (auto& cache : caches)
+				{
+					if (auto shared = cache.shared.lock())
+					{
+						std::scoped_lock lock{ shared->mutex };
+						shared->free.insert(shared->free.end(), cache.slots.begin(), cache.slots.end());
+					}
+				}
 			}
 		};
 
-		template<>
-		struct BasicInputFileStreamWrapper<std::byte>
+	public:
+		using Handle = PoolHandle<T, ConcurrentObjectPool>;
+		static constexpr inline size_t number_of_objects_in_each_chunk = N;
+
+		ConcurrentObjectPool() :m_shared{ std::make_shared<Shared>() }, m_id{ next_pool_id() } {}
+		ConcurrentObjectPool(const ConcurrentObjectPool&) = delete;
+		ConcurrentObjectPool& operator=(const ConcurrentObjectPool&) = delete;
+		virtual ~ConcurrentObjectPool() = default;
+
+		template<class... Args> inline Handle acquire(Args&&... args)
 		{
-			using file_stream_type = std::basic_ifstream<std::byte>;
-			using type = BasicInputFileStreamWrapper<std::byte>;
-			using string_type = std::basic_string<std::byte>;
-			using stream_buffer_iterator = std::istreambuf_iterator<std::byte>;
+			auto& slots = local_cache().slots;
+			if (slots.empty())
+				refill(slots);
+			T* object = Storage::construct(slots.back(), std::forward<Args>(args)...);
+			slots.pop_back();
+			return Handle{ this, object };
+		}
 
-			file_stream_type file_stream;
+		inline void release(T* object) noexcept
+		{
+			auto& slots = local_cache().slots;
+			slots.push_back(Storage::destroy(object));
+			if (slots.size() >= 2 * N)
+				flush(slots);
+		}
 
-			BasicInputFileStreamWrapper() :file_stream{} {}
-			virtual ~BasicInputFileStreamWrapper() { if (is_open()) close(); }
+		inline size_t capacity() const
+		{
+			std::scoped_lock lock{ m_shared->mutex };
+			return m_shared->storage.capacity();
+		}
 
-			template<typename T> constexpr type& operator>>(T& value) { file_stream >> value; return *this; }
+	private:
+		static inline uint64_t next_pool_id() noexcept
+		{
+			static std::atomic<uint64_t> counter{ 0 };
+			return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
 
-			bool is_open() { return file_stream.is_open(); }
-			void close() { file_stream.close(); }
-			void open(std::filesystem::path file_path, std::ios_base::openmode open_mode = std::ios_base::in | std::ios_base::binary)
+		inline Cache& local_cache()
+		{
+			static thread_local ThreadCaches thread_caches{};
+			auto& caches = thread_caches.caches;
+			// Most threads use one or two pools; keep the last one used at the front
+			if (!caches.empty() && caches.front().pool_id == m_id)
+				return caches.front();
+			for (auto it = caches.begin(); it != caches.end();)
 			{
-				file_stream.open(file_path, std::ios_base::in | std::ios_base::binary | open_mode);
-				if (!is_open())
-					throw std::runtime_error(
-						std::string{
-							std::string{"ERROR! Cannot open "} +
-							file_path.string() +
-							std::string{" file in raii::BasicInputFileStreamWrapper<std::byte>::open() method." }
-						}.c_str()
-					);
+				if (it->pool_id == m_id)
+				{
+					std::iter_swap(caches.begin(), it);
+					return caches.front();
+				}
+				it = it->shared.expired() ? caches.erase(it) : std::next(it);
 			}
-		};
+			caches.insert(caches.begin(), Cache{ m_id, m_shared, {} });
+			caches.front().slots.reserve(2 * N);
+			return caches.front();
+		}
 
-		template<typename Elem, typename Traits = std::char_traits<Elem>, typename Alloc = std::allocator<Elem>>
-		struct BasicOutputFileStreamWrapper
+		inline void refill(std::vector<Slot*>& slots)
 		{
-			using file_stream_type = std::basic_ofstream<Elem, Traits>;
-			using type = BasicOutputFileStreamWrapper<Elem, Traits, Alloc>;
-			using string_type = std::basic_string<Elem, Traits, Alloc>;
-			using stream_buffer_iterator = std::ostreambuf_iterator<Elem, Traits>;
+			std::scoped_lock lock{ m_shared->mutex };
+			auto& free = m_shared->free;
+			if (free.empty())
+			{
+				for (Slot* slot = m_shared->storage.grow(); slot != nullptr; slot = slot->next)
+					free.push_back(slot);
+			}
+			size_t count = std::min(N, free.size());
+			slots.insert(slots.end(), free.end() - count, free.end());
+			free.resize(free.size() - count);
+		}
 
-			file_stream_type file_stream;
+		inline void flush(std::vector<Slot*>& slots)
+		{
+			std::scoped_lock lock{ m_shared->mutex };
+			m_shared->free.insert(m_shared->free.end(), slots.end() - N, slots.end());
+			slots.resize(slots.size() - N);
+		}
 
-			BasicOutputFileStreamWrapper() :file_stream{} {}
-			virtual ~BasicOutputFileStreamWrapper() { if (is_open()) close(); }
+		std::shared_ptr<Shared> m_shared;
+		uint64_t m_id;
+	};
 
-			template<typename T> constexpr type& operator<<(const T& value) { file_stream << value; return *this; }
-			template<typename T> constexpr type& operator<<(T&& value) noexcept { file_stream << value; return *this; }
+    template<class T, size_t N = 128>
+	class GeneratorFactory
+	{
+	public:
+        using Pool = ObjectPool<T, N>;
+        using Handle = typename Pool::Handle;
+        static constexpr inline size_t number_of_objects_in_each_pool = N;
 
-			bool is_open() { return file_stream.is_open(); }
-			void close() { file_stream.flush(); file_stream.close(); }
-			void open(std::filesystem::path file_path, std::ios_base::openmode open_mode = std::ios_base::out)
-			{
-				file_stream.open(file_path, std::ios::out | open_mode);
-				if (!is_open())
-					throw std::runtime_error(
-						std::string{
-							std::string{"ERROR! Cannot open "} +
-							file_path.string() +
-							std::string{" file in raii::BasicOutputFileStreamWrapper<"} +
-							std::string{typeid(Elem).name()} +
-							std::string{", "} +
-							std::string{typeid(Traits).name()} +
-							std::string{", "} +
-							std::string{ typeid(Alloc).name() } +
-							std::string{ "::open() method." }
-						}.c_str()
-					);
-			}
-		};
+		GeneratorFactory():m_pool{} {}
+		// Pool chunks come from resource, e.g. memory::thread_arena() or a memory::Arena that outlives the factory
+		explicit GeneratorFactory(std::pmr::memory_resource* resource) :m_pool{ resource } {}
 
-		template<>
-		struct BasicOutputFileStreamWrapper<std::byte>
-		{
-			using file_stream_type = std::basic_ofstream<std::byte>;
-			using type = BasicOutputFileStreamWrapper<std::byte>;
-			using string_type = std::basic_string<std::byte>;
-			using stream_buffer_iterator = std::ostreambuf_iterator<std::byte>;
+		virtual ~GeneratorFactory() = default;
 
-			file_stream_type file_stream;
+		// Yields default-constructed pooled objects; a handle's slot is reused once the handle is destroyed
+		inline Generator<Handle> generate()
+		{
+			while (true)
+			{
+                co_yield m_pool.acquire();
+			}
+		}
 
-			BasicOutputFileStreamWrapper() :file_stream{} {}
-			virtual ~BasicOutputFileStreamWrapper() { if (is_open()) close(); }
+		inline Pool& pool() noexcept { return m_pool; }
 
-			template<typename T> constexpr type& operator<<(const T& value) { file_stream << value; return *this; }
-			template<typename T> constexpr type& operator<<(T&& value) noexcept { file_stream << value; return *this; }
+	private:
+		Pool m_pool;
+	};
 
-			bool is_open() { return file_stream.is_open(); }
-			void close() { file_stream.flush(); file_stream.close(); }
-			void open(std::filesystem::path file_path, std::ios_base::openmode open_mode = std::ios_base::out | std::ios_base::binary)
+	namespace detail
+	{
+		// Final awaiter of Task: symmetric transfer to the awaiting coroutine, a tail call instead of a nested resume(),
+		// so chains of co_await run in constant stack space. A task resumed without an awaiter just stops.
+		struct TaskFinalAwaitable
+		{
+			constexpr bool await_ready() noexcept { return false; }
+			template<class Promise>
+			inline std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
 			{
-				file_stream.open(file_path, std::ios::out | std::ios_base::binary | open_mode);
-				if (!is_open())
-					throw std::runtime_error(
-						std::string{
-							std::string{"ERROR! Cannot open "} +
-							file_path.string() +
-							std::string{" file in raii::BasicOutputFileStreamWrapper<std::byte>::open() method." }
-						}.c_str()
-					);
+				std::coroutine_handle<> continuation = h.promise().continuation;
+				return continuation ? continuation : std::noop_coroutine();
 			}
+			constexpr void await_resume() noexcept {}
 		};
+	}
 
-		namespace native
+	// Lazily started: the body runs only once the task is awaited, on the awaiting thread
+	template<class T> 
+    struct Task
+	{
+		struct promise_type :CoroutineFrameAllocation
 		{
-			namespace narrow_encoded 
+			// The value shares no storage with the exception, so a successful await_resume is one test and a move
+			union { T value; };
+			std::exception_ptr error{};
+			bool has_value{ false };
+			std::coroutine_handle<> continuation;
+			[[no_unique_address]] trace::Stamp awaited;
+			promise_type() noexcept {}
+			promise_type(const promise_type&) = delete;
+			promise_type& operator=(const promise_type&) = delete;
+			~promise_type() { if (has_value) std::destroy_at(std::addressof(value)); }
+			constexpr decltype(auto) get_return_object() noexcept { return Task{ *this }; }
+			template<class U = T> inline void return_value(U&& result) noexcept(std::is_nothrow_constructible_v<T, U&&>)
 			{
-				using InputFileStreamWrapper = BasicInputFileStreamWrapper<char>;
-				using OutputFileStreamWrapper = BasicOutputFileStreamWrapper<char>;
+				std::construct_at(std::addressof(value), std::forward<U>(result));
+				has_value = true;
 			}
-			namespace wide_encoded
+			inline void unhandled_exception() noexcept { error = std::current_exception(); }
+			constexpr decltype(auto) initial_suspend() { return std::suspend_always{}; }
+			constexpr decltype(auto) final_suspend() noexcept { return detail::TaskFinalAwaitable{}; }
+		};
+		std::coroutine_handle<promise_type> handle;
+		explicit Task(promise_type& p) noexcept :handle{ std::coroutine_handle<promise_type>::from_promise(p) } {}
+		Task(Task&& t) noexcept :handle{ std::exchange(t.handle, nullptr) } {}
+		~Task() { if (handle) handle.destroy(); }
+		constexpr bool await_ready() noexcept { return false; }
+		// Starts the task by symmetric transfer
+		inline std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) noexcept
+		{
+			handle.promise().continuation = c;
+			handle.promise().awaited = trace::stamp();
+			return handle;
+		}
+		inline T await_resume()
+		{
+			// With tracing, a zone from co_await to resumption on the resuming thread
+			trace::span("Task", handle.promise().awaited);
+			auto& promise = handle.promise();
+			if (promise.error) [[unlikely]]
+				std::rethrow_exception(promise.error);
+			return std::move(promise.value);
+		}
+	};
+	template<> 
+    struct Task<void>
+	{
+		struct promise_type :CoroutineFrameAllocation
+		{
+			std::exception_ptr e;
+			std::coroutine_handle<> continuation;
+			[[no_unique_address]] trace::Stamp awaited;
+			inline decltype(auto) get_return_object() noexcept { return Task{ *this }; }
+			constexpr void return_void() {}
+			inline void unhandled_exception() noexcept { e = std::current_exception(); }
+			constexpr decltype(auto) initial_suspend() { return std::suspend_always{}; }
+			constexpr decltype(auto) final_suspend() noexcept { return detail::TaskFinalAwaitable{}; }
+		};
+		std::coroutine_handle<promise_type> handle;
+		explicit Task(promise_type& p) noexcept :handle{ std::coroutine_handle<promise_type>::from_promise(p) } {}
+		Task(Task&& t) noexcept :handle{ std::exchange(t.handle, nullptr) } {}
+		~Task() { if (handle) handle.destroy(); }
+		constexpr bool await_ready() noexcept { return false; }
+		inline std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) noexcept
+		{
+			handle.promise().continuation = c;
+			handle.promise().awaited = trace::stamp();
+			return handle;
+		}
+		inline void await_resume()
+		{
+			trace::span("Task", handle.promise().awaited);
+			if (handle.promise().e) [[unlikely]]
+				std::rethrow_exception(handle.promise().e);
+		}
+	};
+
+	template<class T> using ResultType = decltype(std::declval<T&>().await_resume());
+
+	template<class T> 
+    struct SyncWaitTask
+	{
+		struct promise_type :CoroutineFrameAllocation
+		{
+			T* value{ nullptr };
+			std::exception_ptr error{ nullptr };
+			std::binary_semaphore sema4{ 0 };
+			inline SyncWaitTask get_return_object() noexcept { return SyncWaitTask{ *this }; }
+			constexpr void unhandled_exception() noexcept { error = std::current_exception(); }
+			constexpr decltype(auto) yield_value(T&& x) noexcept
 			{
-				using InputFileStreamWrapper = BasicInputFileStreamWrapper<wchar_t>;
-				using OutputFileStreamWrapper = BasicOutputFileStreamWrapper<wchar_t>;
+				value = std::addressof(x);
+				return final_suspend();
 			}
+			constexpr decltype(auto) initial_suspend() noexcept { return std::suspend_always{}; }
+			struct awaitable
+			{
+				constexpr bool await_ready() noexcept { return false; }
+				constexpr void await_suspend(std::coroutine_handle<promise_type> h) noexcept { h.promise().sema4.release(); }
+				constexpr void await_resume() noexcept {}
+			};
+			constexpr decltype(auto) final_suspend() noexcept { return awaitable{}; }
+			constexpr void return_void() noexcept { assert(false); }
+		};
+		std::coroutine_handle<promise_type> handle;
+		explicit SyncWaitTask(promise_type& p) noexcept :handle{ std::coroutine_handle<promise_type>::from_promise(p) } {}
+		SyncWaitTask(SyncWaitTask&& t) noexcept :handle{ std::exchange(t.handle, nullptr) } {}
+		~SyncWaitTask() { if (handle) handle.destroy(); }
+		inline T&& get()
+		{
+			auto& p = handle.promise();
+			trace::Zone zone{ "sync_wait" };
+			handle.resume();
+			p.sema4.acquire();
+			if (p.error)
+				std::rethrow_exception(p.error);
+			return static_cast<T&&>(*p.value);
 		}
-        #if __cplusplus >= 202002L
-		namespace utf8
+	};
+
+	template<class T> ResultType<T> sync_wait(T&& Task)
+	{
+		if constexpr (std::is_void_v<ResultType<T>>)
 		{
-			using InputFileStreamWrapper = BasicInputFileStreamWrapper<char8_t>;
-			using OutputFileStreamWrapper = BasicOutputFileStreamWrapper<char8_t>;
+			struct empty_type {};
+			auto coro = [&]() -> SyncWaitTask<empty_type>
+				{
+					co_await std::forward<T>(Task);
+					co_yield empty_type{};
+					assert(false);
+				};
+			coro().get();
 		}
-        #endif
-		namespace binary
+		else
 		{
-			using InputFileStreamWrapper = BasicInputFileStreamWrapper<std::byte>;
-			using OutputFileStreamWrapper = BasicOutputFileStreamWrapper<std::byte>;
+			auto coro = [&]() -> SyncWaitTask<ResultType<T>>
+				{
+					co_yield co_await std::forward<T>(Task);
+					assert(false);
+				};
+			return coro().get();
 		}
 	}
-}
-)";
 
-        // stringformers.hpp content  
-        std::string stringformers_content = R"(
-#pragma once
-#include <cctype>
-#include <string>
-#include <string_view>
-#include <ranges>
-#include <algorithm>
-#include <vector>
-#include <unordered_set>
-#include <unordered_map>
+	// Fixed-capacity Chase-Lev deque of coroutine handles. The owning worker pushes and pops at the bottom
+	// (LIFO, cache-warm); other workers steal from the top. push() fails when full so the caller can spill.
+	class WorkStealingDeque
+	{
+	public:
+		static constexpr inline int64_t capacity = 1024;
 
-/**********************************************************************************************
-*
-*                   			String Transformers
-*                   			-------------------
-*    			This header provides utility functions for string manipulation,
-*    			including case conversion and tokenization.
-*
-*                   			Developed by: Pooria Yousefi
-*				   				Date: 2025-06-26
-*				   				License: MIT
-*
-**********************************************************************************************/
+		WorkStealingDeque() :m_top{ 0 }, m_bottom{ 0 }, m_buffer{} {}
 
-namespace pooriayousefi::core
-{
-    template<class Enc, class EncTraits = std::char_traits<Enc>, class EncAlloc = std::allocator<Enc>>
-    constexpr decltype(auto) to_lowercase(const std::basic_string<Enc, EncTraits, EncAlloc>& word)
-    {
-        std::basic_string<Enc, EncTraits, EncAlloc> lowercased_word{};
-        lowercased_word.resize(std::ranges::size(word));
-        std::ranges::transform(std::ranges::cbegin(word), std::ranges::cend(word),
-            std::ranges::begin(lowercased_word), [](const auto& c) { return std::tolower(c); });
-        return lowercased_word;
-    }
-    template<class Enc, class EncTraits = std::char_traits<Enc>, class EncAlloc = std::allocator<Enc>>
-    constexpr decltype(auto) to_lowercase(std::basic_string_view<Enc, EncTraits> word_view)
-    {
-        std::basic_string<Enc, EncTraits, EncAlloc> lowercased_word{};
-        lowercased_word.resize(std::ranges::size(word_view));
-        std::ranges::transform(std::ranges::cbegin(word_view), std::ranges::cend(word_view),
-            std::ranges::begin(lowercased_word), [](const auto& c) { return std::tolower(c); });
-        return lowercased_word;
-    }
+		inline bool push(std::coroutine_handle<> h) noexcept
+		{
+			int64_t b = m_bottom.load(std::memory_order_relaxed);
+			int64_t t = m_top.load(std::memory_order_acquire);
+			if (b - t >= capacity)
+				return false;
+			m_buffer[b & (capacity - 1)].store(h.address(), std::memory_order_relaxed);
+			m_bottom.store(b + 1, std::memory_order_release);
+			return true;
+		}
 
-    template<class Enc, class EncTraits = std::char_traits<Enc>, class EncAlloc = std::allocator<Enc>>
-    constexpr decltype(auto) to_uppercase(const std::basic_string<Enc, EncTraits, EncAlloc>& word)
-    {
-        std::basic_string<Enc, EncTraits, EncAlloc> uppercased_word{};
-        uppercased_word.resize(std::ranges::size(word));
-        std::ranges::transform(std::ranges::cbegin(word), std::ranges::cend(word),
-            std::ranges::begin(uppercased_word), [](const auto& c) { return std::toupper(c); });
-        return uppercased_word;
-    }
-    template<class Enc, class EncTraits = std::char_traits<Enc>, class EncAlloc = std::allocator<Enc>>
-    constexpr decltype(auto) to_uppercase(std::basic_string_view<Enc, EncTraits> word_view)
-    {
-        std::basic_string<Enc, EncTraits, EncAlloc> uppercased_word{};
-        uppercased_word.resize(std::ranges::size(word_view));
-        std::ranges::transform(std::ranges::cbegin(word_view), std::ranges::cend(word_view),
-            std::ranges::begin(uppercased_word), [](const auto& c) { return std::toupper(c); });
-        return uppercased_word;
-    }
+		inline std::coroutine_handle<> pop() noexcept
+		{
+			int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t t = m_top.load(std::memory_order_relaxed);
+			void* address = nullptr;
+			if (t <= b)
+			{
+				address = m_buffer[b & (capacity - 1)].load(std::memory_order_relaxed);
+				if (t == b)
+				{
+					// Last element: race the thieves for it
+					if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						address = nullptr;
+					m_bottom.store(b + 1, std::memory_order_relaxed);
+				}
+			}
+			else
+			{
+				m_bottom.store(b + 1, std::memory_order_relaxed);
+			}
+			return std::coroutine_handle<>::from_address(address);
+		}
 
-    template<class T, class Traits = std::char_traits<T>>
-    constexpr void tokenize(
-        std::basic_string_view<T, Traits> src, 
-        std::basic_string_view<T, Traits> delim,
-        std::vector<std::basic_string_view<T, Traits>>& tokens
-    )
-    {
-        tokens.clear();
-        tokens.reserve(src.size());
+		inline std::coroutine_handle<> steal() noexcept
+		{
+			int64_t t = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t b = m_bottom.load(std::memory_order_acquire);
+			if (t >= b)
+				return {};
+			void* address = m_buffer[t & (capacity - 1)].load(std::memory_order_relaxed);
+			if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return {};
+			return std::coroutine_handle<>::from_address(address);
+		}
 
-        auto last_pos = src.find_first_not_of(delim, 0);
-        auto pos = src.find_first_of(delim, last_pos);
+	private:
+		alignas(64) std::atomic<int64_t> m_top;
+		alignas(64) std::atomic<int64_t> m_bottom;
+		alignas(64) std::array<std::atomic<void*>, capacity> m_buffer;
+	};
 
-        while (pos != std::basic_string_view<T, Traits>::npos || last_pos != std::basic_string_view<T, Traits>::npos)
-        {
-            tokens.emplace_back(src.substr(last_pos, pos - last_pos));
-            last_pos = src.find_first_not_of(delim, pos);
-            pos = src.find_first_of(delim, last_pos);
-        }
-    }
-    template<class T, class Traits = std::char_traits<T>>
-	constexpr void tokenize(
-        std::basic_string_view<T, Traits> src, 
-        std::basic_string_view<T, Traits> delim,
-        std::unordered_set<std::basic_string_view<T, Traits>>& tokens
-    )
+	class ThreadPool
 	{
-        tokens.clear();
-        tokens.reserve(src.size());
+	public:
+		struct ScheduleAwaitable
+		{
+			ThreadPool& pool;
+			constexpr bool await_ready() noexcept { return false; }
+			inline void await_suspend(std::coroutine_handle<> h) { pool.enqueue(h); }
+			constexpr void await_resume() noexcept {}
+		};
 
-        auto last_pos = src.find_first_not_of(delim, 0);
-        auto pos = src.find_first_of(delim, last_pos);
+		explicit ThreadPool(size_t number_of_threads = std::thread::hardware_concurrency())
+			:m_workers(number_of_threads == 0 ? 1 : number_of_threads), m_threads{}, m_injected{ nullptr },
+			m_epoch{ 0 }, m_sleepers{ 0 }, m_stopping{ false }
+		{
+			m_threads.reserve(m_workers.size());
+			for (size_t i = 0; i < m_workers.size(); ++i)
+				m_threads.emplace_back([this, i]() { run(i); });
+		}
 
-		while (pos != std::basic_string_view<T, Traits>::npos || last_pos != std::basic_string_view<T, Traits>::npos)
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// Queued work is drained before the workers exit
+		virtual ~ThreadPool()
 		{
-			tokens.emplace(src.substr(last_pos, pos - last_pos));
-			last_pos = src.find_first_not_of(delim, pos);
-			pos = src.find_first_of(delim, last_pos);
+			m_stopping.store(true, std::memory_order_seq_cst);
+			m_epoch.fetch_add(1, std::memory_order_seq_cst);
+			m_epoch.notify_all();
+			for (auto& thread : m_threads)
+				thread.join();
 		}
-	}
-	template<class T, class Traits = std::char_traits<T>>
-	auto tokenize(
-        std::basic_string_view<T, Traits> src, 
-        std::basic_string_view<T, Traits> delim,
-        std::unordered_map<std::basic_string_view<T, Traits>, size_t>& tokens
-    )
+
+		// co_await pool.schedule() suspends the caller and resumes it on a worker
+		inline ScheduleAwaitable schedule() noexcept { return ScheduleAwaitable{ *this }; }
+
+		// Workers push onto their own deque; other threads (or a full deque) go through the injection queue
+		inline void enqueue(std::coroutine_handle<> h)
+		{
+			if (tls_pool != this || !m_workers[tls_worker_index].deque.push(h))
+				inject(h);
+			wake_one();
+		}
+
+		inline size_t size() const noexcept { return m_workers.size(); }
+
+	private:
+		struct InjectedNode
+		{
+			std::coroutine_handle<> handle;
+			InjectedNode* next;
+		};
+
+		struct Worker
+		{
+			WorkStealingDeque deque;
+		};
+
+		static inline thread_local ThreadPool* tls_pool{ nullptr };
+		static inline thread_local size_t tls_worker_index{ 0 };
+
+		// Treiber stack: producers CAS onto the head, consumers take the whole list at once, so there is no ABA
+		inline void inject(std::coroutine_handle<> h)
+		{
+			auto* node = new InjectedNode{ h, m_injected.load(std::memory_order_relaxed) };
+			while (!m_injected.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+		}
+
+		// Run the oldest injected handle; move the rest onto our own deque where idle workers can steal them
+		inline std::coroutine_handle<> take_injected(size_t index)
+		{
+			InjectedNode* list = m_injected.exchange(nullptr, std::memory_order_acquire);
+			if (list == nullptr)
+				return {};
+			InjectedNode* fifo = nullptr;
+			while (list != nullptr)
+				fifo = std::exchange(list, std::exchange(list->next, fifo));
+			std::coroutine_handle<> first = fifo->handle;
+			delete std::exchange(fifo, fifo->next);
+			while (fifo != nullptr)
+			{
+				if (!m_workers[index].deque.push(fifo->handle))
+					inject(fifo->handle);
+				delete std::exchange(fifo, fifo->next);
+			}
+			return first;
+		}
+
+		inline std::coroutine_handle<> find_work(size_t index, uint64_t& seed)
+		{
+			if (auto h = m_workers[index].deque.pop())
+				return h;
+			if (auto h = take_injected(index))
+				return h;
+			seed ^= seed << 13;
+			seed ^= seed >> 7;
+			seed ^= seed << 17;
+			for (size_t i = 0, n = m_workers.size(), start = seed % n; i < n; ++i)
+			{
+				size_t victim = (start + i) % n;
+				if (victim == index)
+					continue;
+				if (auto h = m_workers[victim].deque.steal())
+					return h;
+			}
+			return {};
+		}
+
+		inline void wake_one()
+		{
+			m_epoch.fetch_add(1, std::memory_order_seq_cst);
+			if (m_sleepers.load(std::memory_order_seq_cst) > 0)
+				m_epoch.notify_one();
+		}
+
+		void run(size_t index)
+		{
+			tls_pool = this;
+			tls_worker_index = index;
+			uint64_t seed = 0x9E3779B97F4A7C15ull * (index + 1);
+			while (true)
+			{
+				// Read the epoch before looking for work: an enqueue racing with the search bumps it, so wait() cannot miss it
+				uint32_t epoch = m_epoch.load(std::memory_order_seq_cst);
+				if (auto h = find_work(index, seed))
+				{
+					trace::Zone zone{ "ThreadPool::resume" };
+					h.resume();
+					continue;
+				}
+				if (m_stopping.load(std::memory_order_seq_cst))
+					break;
+				m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+				m_epoch.wait(epoch, std::memory_order_seq_cst);
+				m_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+			}
+			tls_pool = nullptr;
+		}
+
+		std::vector<Worker> m_workers;
+		std::vector<std::thread> m_threads;
+		alignas(64) std::atomic<InjectedNode*> m_injected;
+		alignas(64) std::atomic<uint32_t> m_epoch;
+		std::atomic<uint32_t> m_sleepers;
+		std::atomic<bool> m_stopping;
+	};
+
+	template<class T> using WhenAllResultType = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+	namespace detail
 	{
-        tokens.clear();
-        tokens.reserve(src.size());
+		struct WhenAllLatch
+		{
+			std::atomic<size_t> count;
+			std::coroutine_handle<> continuation;
+			std::atomic<bool> failed{ false };
+			std::exception_ptr error{ nullptr };
+		};
 
-		auto last_pos = src.find_first_not_of(delim, 0);
-		auto pos = src.find_first_of(delim, last_pos);
+		// Runs one child task (on the pool if given) and counts the latch down when it finishes;
+		// the last child to finish resumes the awaiting coroutine
+		struct WhenAllTask
+		{
+			struct promise_type :CoroutineFrameAllocation
+			{
+				WhenAllLatch* latch{ nullptr };
+				inline WhenAllTask get_return_object() noexcept { return WhenAllTask{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+				constexpr decltype(auto) initial_suspend() noexcept { return std::suspend_always{}; }
+				struct awaitable
+				{
+					constexpr bool await_ready() noexcept { return false; }
+					inline std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept
+					{
+						auto* latch = h.promise().latch;
+						if (latch->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+							return latch->continuation;
+						return std::noop_coroutine();
+					}
+					constexpr void await_resume() noexcept {}
+				};
+				constexpr decltype(auto) final_suspend() noexcept { return awaitable{}; }
+				constexpr void return_void() noexcept {}
+				inline void unhandled_exception() noexcept { std::terminate(); }
+			};
+			std::coroutine_handle<promise_type> handle;
+			explicit WhenAllTask(std::coroutine_handle<promise_type> h) noexcept :handle{ h } {}
+			WhenAllTask(WhenAllTask&& t) noexcept :handle{ std::exchange(t.handle, nullptr) } {}
+			~WhenAllTask() { if (handle) handle.destroy(); }
+		};
 
-		while (pos != std::basic_string_view<T, Traits>::npos || last_pos != std::basic_string_view<T, Traits>::npos)
+		template<class T> WhenAllTask make_when_all_task(ThreadPool* pool, Task<T> task, std::optional<WhenAllResultType<T>>& result, WhenAllLatch& latch)
 		{
-			tokens[src.substr(last_pos, pos - last_pos)]++;
-			last_pos = src.find_first_not_of(delim, pos);
-			pos = src.find_first_of(delim, last_pos);
+			try
+			{
+				if (pool != nullptr)
+					co_await pool->schedule();
+				if constexpr (std::is_void_v<T>)
+				{
+					co_await std::move(task);
+					result.emplace();
+				}
+				else
+				{
+					result.emplace(co_await std::move(task));
+				}
+			}
+			catch (...)
+			{
+				if (!latch.failed.exchange(true, std::memory_order_acq_rel))
+					latch.error = std::current_exception();
+			}
+		}
+
+		// Starts every child, then suspends until the last one finishes (or not at all if they already did)
+		struct WhenAllAwaitable
+		{
+			std::vector<WhenAllTask>& tasks;
+			WhenAllLatch& latch;
+			constexpr bool await_ready() noexcept { return tasks.empty(); }
+			inline bool await_suspend(std::coroutine_handle<> c) noexcept
+			{
+				latch.continuation = c;
+				latch.count.store(tasks.size() + 1, std::memory_order_relaxed);
+				for (auto& task : tasks)
+				{
+					task.handle.promise().latch = std::addressof(latch);
+					trace::Zone zone{ "when_all::resume" };
+					task.handle.resume();
+				}
+				return latch.count.fetch_sub(1, std::memory_order_acq_rel) != 1;
+			}
+			inline void await_resume()
+			{
+				if (latch.error)
+					std::rethrow_exception(latch.error);
+			}
+		};
+
+		template<class... Ts> Task<std::tuple<WhenAllResultType<Ts>...>> when_all(ThreadPool* pool, Task<Ts>... tasks)
+		{
+			std::tuple<std::optional<WhenAllResultType<Ts>>...> results;
+			WhenAllLatch latch{};
+			std::vector<WhenAllTask> children;
+			children.reserve(sizeof...(Ts));
+			[&]<size_t... I>(std::index_sequence<I...>)
+			{
+				(children.push_back(make_when_all_task(pool, std::move(tasks), std::get<I>(results), latch)), ...);
+			}(std::index_sequence_for<Ts...>{});
+			co_await WhenAllAwaitable{ children, latch };
+			co_return std::apply([](auto&... result) { return std::tuple<WhenAllResultType<Ts>...>{ std::move(*result)... }; }, results);
+		}
+
+		template<class T> Task<std::vector<WhenAllResultType<T>>> when_all(ThreadPool* pool, std::vector<Task<T>> tasks)
+		{
+			std::vector<std::optional<WhenAllResultType<T>>> results(tasks.size());
+			WhenAllLatch latch{};
+			std::vector<WhenAllTask> children;
+			children.reserve(tasks.size());
+			for (size_t i = 0; i < tasks.size(); ++i)
+				children.push_back(make_when_all_task(pool, std::move(tasks[i]), results[i], latch));
+			co_await WhenAllAwaitable{ children, latch };
+			std::vector<WhenAllResultType<T>> values;
+			values.reserve(results.size());
+			for (auto& result : results)
+				values.push_back(std::move(*result));
+			co_return values;
 		}
 	}
-}
-)";
 
-        // utilities.hpp content (truncated for brevity - the full content is very long)
-        std::string utilities_content = R"(
-#pragma once
-#include <concepts>
-#include <type_traits>
-#include <thread>
-#include <ratio>
-#include <utility>
-#include <chrono>
-#include <functional>
-#include <cstdint>
-#include <numbers>
-#include <vector>
-#include <algorithm>
-#include <ranges>
-#include <iterator>
-#include <unordered_map>
-#include <string_view>
-#include <random>
-#include <variant>
-#include <iostream>
+	// Start every task on a pool worker and complete once all of them have; the first exception is rethrown.
+	// Task<void> results show up as std::monostate.
+	template<class... Ts> Task<std::tuple<WhenAllResultType<Ts>...>> when_all(ThreadPool& pool, Task<Ts>... tasks)
+	{
+		return detail::when_all(std::addressof(pool), std::move(tasks)...);
+	}
 
-/**********************************************************************************************
-*
-*                   			    Utilities Header
-*                   			-----------------------
-*    		This header provides general utility functions and classes.
-*    		It includes:
-*    		- A wait_for class template for sleeping for various time durations.
-*    		- A runtime function template for measuring the execution time of a callable.
-*    		- A convert namespace with functions for unit conversions and number base conversions.
-*    		- A countdown function template for displaying a countdown in seconds.
-*    		- An iterate function template for iterating over a range with a specified step size
-*    		- Specializations of standard functors for std::byte and std::reference_wrapper.
-*    		- A histogram function template for counting occurrences of elements in a range.
-*    		- A frequencies function template for counting word frequencies in a string view.
-*    		- A do_n_times_shuffle_and_sample function template for shuffling and sampling a range.
-*    		- A Result struct template for encapsulating expected values or exceptions.
-*
-*                   			Developed by: Pooria Yousefi
-*				   				Date: 2025-06-26
-*				   				License: MIT
-*
-**********************************************************************************************/
+	template<class T> Task<std::vector<WhenAllResultType<T>>> when_all(ThreadPool& pool, std::vector<Task<T>> tasks)
+	{
+		return detail::when_all(std::addressof(pool), std::move(tasks));
+	}
 
-namespace pooriayousefi::core
-{
-    template<typename T> concept Arithmetic = std::floating_point<T> || std::integral<T>;
+	// Same, but the tasks start inline on the awaiting thread (they can still co_await pool.schedule() themselves)
+	template<class... Ts> Task<std::tuple<WhenAllResultType<Ts>...>> when_all(Task<Ts>... tasks)
+	{
+		return detail::when_all(nullptr, std::move(tasks)...);
+	}
 
-    template<Arithmetic T> 
-    class wait_for
-    {
-    public:
-        wait_for() = delete;
-        wait_for(T value) :m_value{ value } {}
-        inline void nanoseconds() { std::this_thread::sleep_for(std::chrono::duration<double, std::ratio<1, 1'000'000'000>>(m_value)); }
-        inline void microseconds() { std::this_thread::sleep_for(std::chrono::duration<double, std::ratio<1, 1'000'000>>(m_value)); }
-        inline void milliseconds() { std::this_thread::sleep_for(std::chrono::duration<double, std::ratio<1, 1'000>>(m_value)); }
-        inline void seconds() { std::this_thread::sleep_for(std::chrono::duration<double, std::ratio<1>>(m_value)); }
-        inline void minutes() { std::this_thread::sleep_for(std::chrono::duration<double, std::ratio<60>>(m_value)); }
-        inline void hours() { std::this_thread::sleep_for(std::chrono::duration<double, std::ratio<3'600>>(m_value)); }
-        inline void days() { std::this_thread::sleep_for(std::chrono::duration<double, std::ratio<86'400>>(m_value)); }
-    private:
-        T m_value;
-    };
+	template<class T> Task<std::vector<WhenAllResultType<T>>> when_all(std::vector<Task<T>> tasks)
+	{
+		return detail::when_all(static_cast<ThreadPool*>(nullptr), std::move(tasks));
+	}
 
-    template<typename F, typename... Args> 
-    constexpr decltype(auto) runtime(F&& f, Args&&... args)
-    {
-        if constexpr (std::is_void_v<std::invoke_result_t<F, Args...>>)
-        {
-            auto ti{ std::chrono::high_resolution_clock::now() };
-            std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
-            auto tf{ std::chrono::high_resolution_clock::now() };
-            return std::chrono::duration<double>(tf - ti).count();
+	namespace detail
+	{
+		// Uninitialized storage for one element of a ring
+		template<class T>
+		struct RingSlot
+		{
+			alignas(T) std::byte storage[sizeof(T)];
+			inline T* get() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+		};
+
+		inline size_t ring_capacity(size_t capacity) noexcept { return std::bit_ceil(std::max<size_t>(capacity, 2)); }
+	}
+
+	// Bounded single-producer single-consumer ring buffer (capacity rounded up to a power of two). Head and tail sit
+	// on their own cache lines, and each side caches the other's index, so the shared lines move only when the ring
+	// looks full or empty.
+	template<class T>
+	class SpscRing
+	{
+	public:
+		explicit SpscRing(size_t capacity)
+			:m_slots{ std::make_unique<detail::RingSlot<T>[]>(detail::ring_capacity(capacity)) }, m_mask{ detail::ring_capacity(capacity) - 1 } {}
+
+		SpscRing(const SpscRing&) = delete;
+		SpscRing& operator=(const SpscRing&) = delete;
+
+		~SpscRing()
+		{
+			for (size_t i = m_head.load(std::memory_order_relaxed); i != m_tail.load(std::memory_order_relaxed); ++i)
+				std::destroy_at(m_slots[i & m_mask].get());
+		}
+
+		// Producer only; value is left untouched when the ring is full
+		template<class U>
+		inline bool try_push(U&& value)
+		{
+			size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail - m_cached_head > m_mask)
+			{
+				m_cached_head = m_head.load(std::memory_order_acquire);
+				if (tail - m_cached_head > m_mask)
+					return false;
+			}
+			std::construct_at(m_slots[tail & m_mask].get(), std::forward<U>(value));
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Consumer only
+		inline std::optional<T> try_pop()
+		{
+			size_t head = m_head.load(std::memory_order_relaxed);
+			if (head == m_cached_tail)
+			{
+				m_cached_tail = m_tail.load(std::memory_order_acquire);
+				if (head == m_cached_tail)
+					return std::nullopt;
+			}
+			T* slot = m_slots[head & m_mask].get();
+			std::optional<T> value{ std::move(*slot) };
+			std::destroy_at(slot);
+			m_head.store(head + 1, std::memory_order_release);
+			return value;
+		}
+
+		inline size_t capacity() const noexcept { return m_mask + 1; }
+
+	private:
+		std::unique_ptr<detail::RingSlot<T>[]> m_slots;
+		size_t m_mask;
+		alignas(64) std::atomic<size_t> m_head{ 0 };
+		size_t m_cached_tail{ 0 };
+		alignas(64) std::atomic<size_t> m_tail{ 0 };
+		size_t m_cached_head{ 0 };
+	};
+
+	// Bounded multi-producer multi-consumer ring buffer (Vyukov): every cell carries a sequence number telling
+	// producers and consumers whose turn it is, so each operation is one CAS on its padded index
+	template<class T>
+	class MpmcRing
+	{
+	public:
+		explicit MpmcRing(size_t capacity)
+			:m_cells{ std::make_unique<Cell[]>(detail::ring_capacity(capacity)) }, m_mask{ detail::ring_capacity(capacity) - 1 }
+		{
+			for (size_t i = 0; i <= m_mask; ++i)
+				m_cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		MpmcRing(const MpmcRing&) = delete;
+		MpmcRing& operator=(const MpmcRing&) = delete;
+
+		~MpmcRing()
+		{
+			while (try_pop()) {}
+		}
+
+		// value is left untouched when the ring is full
+		template<class U>
+		inline bool try_push(U&& value)
+		{
+			size_t position = m_enqueue.load(std::memory_order_relaxed);
+			while (true)
+			{
+				Cell& cell = m_cells[position & m_mask];
+				size_t sequence = cell.sequence.load(std::memory_order_acquire);
+				auto difference = static_cast<ptrdiff_t>(sequence - position);
+				if (difference == 0)
+				{
+					if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						std::construct_at(cell.slot.get(), std::forward<U>(value));
+						cell.sequence.store(position + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = m_enqueue.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		inline std::optional<T> try_pop()
+		{
+			size_t position = m_dequeue.load(std::memory_order_relaxed);
+			while (true)
+			{
+				Cell& cell = m_cells[position & m_mask];
+				size_t sequence = cell.sequence.load(std::memory_order_acquire);
+				auto difference = static_cast<ptrdiff_t>(sequence - (position + 1));
+				if (difference == 0)
+				{
+					if (m_dequeue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						T* slot = cell.slot.get();
+						std::optional<T> value{ std::move(*slot) };
+						std::destroy_at(slot);
+						cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+						return value;
+					}
+				}
+				else if (difference < 0)
+				{
+					return std::nullopt;
+				}
+				else
+				{
+					position = m_dequeue.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		inline size_t capacity() const noexcept { return m_mask + 1; }
+
+	private:
+		struct Cell
+		{
+			std::atomic<size_t> sequence;
+			detail::RingSlot<T> slot;
+		};
+
+		std::unique_ptr<Cell[]> m_cells;
+		size_t m_mask;
+		alignas(64) std::atomic<size_t> m_enqueue{ 0 };
+		alignas(64) std::atomic<size_t> m_dequeue{ 0 };
+	};
+
+	// Bounded channel over a lock-free ring. try_send / try_receive never wait; send / receive block the calling
+	// thread; co_await async_send(v) / async_receive() suspend the coroutine instead while the channel is full / empty.
+	// The fast paths touch only the ring. A waiting side is parked on a mutex-guarded list, and whoever frees a slot
+	// (or fills one) completes the oldest parked operation on its behalf and wakes it: with a pool, parked coroutines
+	// are resumed on its workers, otherwise inline on the waking thread. After close(), sends fail and receives drain
+	// what is left, then return std::nullopt.
+	template<class T, class Ring>
+	class Channel
+	{
+	public:
+		explicit Channel(size_t capacity, ThreadPool* pool = nullptr) :m_ring{ capacity }, m_pool{ pool } {}
+		Channel(size_t capacity, ThreadPool& pool) :Channel{ capacity, std::addressof(pool) } {}
+
+		Channel(const Channel&) = delete;
+		Channel& operator=(const Channel&) = delete;
+
+	private:
+		struct Waiter
+		{
+			std::coroutine_handle<> handle{};
+			std::binary_semaphore* blocked{ nullptr };
+			T* value{ nullptr };
+			std::optional<T>* received{ nullptr };
+			bool sent{ false };
+			Waiter* next{ nullptr };
+		};
+
+		struct WaitList
+		{
+			Waiter* head{ nullptr };
+			Waiter* tail{ nullptr };
+			inline void push(Waiter& w) noexcept { w.next = nullptr; (tail != nullptr ? tail->next : head) = std::addressof(w); tail = std::addressof(w); }
+			inline Waiter* pop() noexcept { Waiter* w = head; head = w->next; if (head == nullptr) tail = nullptr; return w; }
+		};
+
+	public:
+		struct SendAwaitable
+		{
+			Channel& channel;
+			T value;
+			Waiter waiter{};
+			inline bool await_ready()
+			{
+				waiter.sent = channel.try_send(std::move(value));
+				return waiter.sent || channel.closed();
+			}
+			inline bool await_suspend(std::coroutine_handle<> h)
+			{
+				waiter.handle = h;
+				waiter.value = std::addressof(value);
+				return channel.park_sender(waiter);
+			}
+			constexpr bool await_resume() const noexcept { return waiter.sent; }
+		};
+
+		struct ReceiveAwaitable
+		{
+			Channel& channel;
+			std::optional<T> result{};
+			Waiter waiter{};
+			inline bool await_ready()
+			{
+				result = channel.try_receive();
+				// A send may land between the failed pop and close(): pop once more before reporting the end
+				if (!result && channel.closed())
+					result = channel.try_receive();
+				return result.has_value() || channel.closed();
+			}
+			inline bool await_suspend(std::coroutine_handle<> h)
+			{
+				waiter.handle = h;
+				waiter.received = std::addressof(result);
+				return channel.park_receiver(waiter);
+			}
+			inline std::optional<T> await_resume() { return std::move(result); }
+		};
+
+		// False when the ring is full or the channel closed; value is moved from only on success
+		template<class U>
+		inline bool try_send(U&& value)
+		{
+			if (m_closed.load(std::memory_order_acquire) || !m_ring.try_push(std::forward<U>(value)))
+				return false;
+			wake_receivers();
+			return true;
+		}
+
+		inline std::optional<T> try_receive()
+		{
+			std::optional<T> value = m_ring.try_pop();
+			if (value)
+				wake_senders();
+			return value;
+		}
+
+		// Blocks while the channel is full; false if it is (or gets) closed
+		inline bool send(T value)
+		{
+			if (try_send(std::move(value)))
+				return true;
+			std::binary_semaphore blocked{ 0 };
+			Waiter waiter{};
+			waiter.blocked = std::addressof(blocked);
+			waiter.value = std::addressof(value);
+			if (park_sender(waiter))
+				blocked.acquire();
+			return waiter.sent;
+		}
+
+		// Blocks while the channel is empty; std::nullopt once it is closed and drained
+		inline std::optional<T> receive()
+		{
+			std::optional<T> result = try_receive();
+			if (result)
+				return result;
+			std::binary_semaphore blocked{ 0 };
+			Waiter waiter{};
+			waiter.blocked = std::addressof(blocked);
+			waiter.received = std::addressof(result);
+			if (park_receiver(waiter))
+				blocked.acquire();
+			return result;
+		}
+
+		// co_await channel.async_send(value) yields false if the channel is closed
+		inline SendAwaitable async_send(T value) { return SendAwaitable{ *this, std::move(value) }; }
+
+		// co_await channel.async_receive() yields std::nullopt once the channel is closed and drained
+		inline ReceiveAwaitable async_receive() { return ReceiveAwaitable{ *this }; }
+
+		// Fails every parked and later send; parked receivers get what is left in the ring, or std::nullopt
+		void close()
+		{
+			m_closed.store(true, std::memory_order_seq_cst);
+			WaitList senders{}, receivers{};
+			{
+				std::scoped_lock lock{ m_mutex };
+				std::swap(senders, m_senders);
+				std::swap(receivers, m_receivers);
+				m_waiting_senders.store(0, std::memory_order_relaxed);
+				m_waiting_receivers.store(0, std::memory_order_relaxed);
+				for (Waiter* w = receivers.head; w != nullptr; w = w->next)
+					*w->received = m_ring.try_pop();
+			}
+			wake(senders.head);
+			wake(receivers.head);
+		}
+
+		inline bool closed() const noexcept { return m_closed.load(std::memory_order_acquire); }
+		inline size_t capacity() const noexcept { return m_ring.capacity(); }
+
+	private:
+		// Announces the waiter, then retries under the lock: a slot freed after the announcement is seen either here
+		// or by the wake_senders of whoever freed it (both sides order their accesses with seq_cst fences).
+		// Returns whether the waiter was parked and must wait.
+		inline bool park_sender(Waiter& w)
+		{
+			bool sent;
+			{
+				std::scoped_lock lock{ m_mutex };
+				m_waiting_senders.fetch_add(1, std::memory_order_seq_cst);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				sent = !m_closed.load(std::memory_order_relaxed) && m_ring.try_push(std::move(*w.value));
+				if (!sent && !m_closed.load(std::memory_order_relaxed))
+				{
+					m_senders.push(w);
+					return true;
+				}
+				m_waiting_senders.fetch_sub(1, std::memory_order_relaxed);
+			}
+			w.sent = sent;
+			if (sent)
+				wake_receivers();
+			return false;
+		}
+
+		inline bool park_receiver(Waiter& w)
+		{
+			bool received;
+			{
+				std::scoped_lock lock{ m_mutex };
+				m_waiting_receivers.fetch_add(1, std::memory_order_seq_cst);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				*w.received = m_ring.try_pop();
+				received = w.received->has_value();
+				if (!received && !m_closed.load(std::memory_order_relaxed))
+				{
+					m_receivers.push(w);
+					return true;
+				}
+				m_waiting_receivers.fetch_sub(1, std::memory_order_relaxed);
+			}
+			if (received)
+				wake_senders();
+			return false;
+		}
+
+		// After a pop: push the values of parked senders into the freed slots and wake them
+		void wake_senders()
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (m_waiting_senders.load(std::memory_order_seq_cst) == 0)
+				return;
+			WaitList woken{};
+			{
+				std::scoped_lock lock{ m_mutex };
+				while (m_senders.head != nullptr && m_ring.try_push(std::move(*m_senders.head->value)))
+				{
+					Waiter* w = m_senders.pop();
+					w->sent = true;
+					m_waiting_senders.fetch_sub(1, std::memory_order_relaxed);
+					woken.push(*w);
+				}
+			}
+			if (woken.head != nullptr)
+			{
+				wake(woken.head);
+				wake_receivers();
+			}
+		}
+
+		// After a push: pop values for parked receivers and wake them
+		void wake_receivers()
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (m_waiting_receivers.load(std::memory_order_seq_cst) == 0)
+				return;
+			WaitList woken{};
+			{
+				std::scoped_lock lock{ m_mutex };
+				while (m_receivers.head != nullptr)
+				{
+					std::optional<T> value = m_ring.try_pop();
+					if (!value)
+						break;
+					Waiter* w = m_receivers.pop();
+					*w->received = std::move(value);
+					m_waiting_receivers.fetch_sub(1, std::memory_order_relaxed);
+					woken.push(*w);
+				}
+			}
+			if (woken.head != nullptr)
+			{
+				wake(woken.head);
+				wake_senders();
+			}
+		}
+
+		// The next link is read before waking: a woken waiter's storage may be gone as soon as it runs
+		inline void wake(Waiter* w)
+		{
+			while (w != nullptr)
+			{
+				Waiter* next = w->next;
+				if (w->blocked != nullptr)
+					w->blocked->release();
+				else if (m_pool != nullptr)
+					m_pool->enqueue(w->handle);
+				else
+					w->handle.resume();
+				w = next;
+			}
+		}
+
+		Ring m_ring;
+		ThreadPool* m_pool;
+		std::atomic<bool> m_closed{ false };
+		alignas(64) std::atomic<size_t> m_waiting_senders{ 0 };
+		std::atomic<size_t> m_waiting_receivers{ 0 };
+		std::mutex m_mutex{};
+		WaitList m_senders{};
+		WaitList m_receivers{};
+	};
+
+	// One producer and one consumer at a time (one thread or one coroutine chain each)
+	template<class T> using SpscChannel = Channel<T, SpscRing<T>>;
+
+	template<class T> using MpmcChannel = Channel<T, MpmcRing<T>>;
+}
+)";
+
+        // raiiiofsw.hpp content
+        constexpr std::string_view raiiiofsw_content = R"(
+#pragma once
+#include <type_traits>
+#include <filesystem>
+#include <stdexcept>
+#include <typeinfo>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <locale>
+#include <system_error>
+#include <span>
+#include <utility>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <coroutine>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+/**********************************************************************************************
+*
+*                   			RAII Input/Output File Stream Wrapper
+*                   			-----------------------
+*    			This header provides a RAII wrapper for basic input/output
+*    			file streams. It includes:
+*    			- A BasicInputFileStreamWrapper class template for managing file streams.
+*    			- A BasicOutputFileStreamWrapper class template for managing file streams
+*    			  (numbers are written with std::to_chars while the stream formats plainly).
+*    			- Specialization for std::byte for binary file streams.
+*    			- A MappedFile class for zero-copy, memory-mapped file access.
+*    			- BinaryFileReader/BinaryFileWriter for buffered bulk (optionally O_DIRECT) I/O.
+*    			- An IoUring/AsyncFile pair for awaitable io_uring reads and writes.
+*
+*                   			Developed by: Pooria Yousefi
+*				   				Date: 2025-06-26
+*				   				License: MIT
+*
+**********************************************************************************************/
+
+namespace pooriayousefi::core
+{
+	namespace raii
+	{
+		template<typename Elem, typename Traits = std::char_traits<Elem>, typename Alloc = std::allocator<Elem>>
+		struct BasicInputFileStreamWrapper
+		{
+			using file_stream_type = std::basic_ifstream<Elem, Traits>;
+			using type = BasicInputFileStreamWrapper<Elem, Traits, Alloc>;
+			using string_type = std::basic_string<Elem, Traits, Alloc>;
+			using stream_buffer_iterator = std::istreambuf_iterator<Elem, Traits>;
+
+			file_stream_type file_stream;
+
+			BasicInputFileStreamWrapper() :file_stream{} {}
+			virtual ~BasicInputFileStreamWrapper() { if (is_open()) close(); }
+
+			template<typename T> constexpr type& operator>>(T& value) { file_stream >> value; return *this; }
+
+			// Bulk read: fills as much of the destination as the file holds and returns the element count
+			size_t read_into(std::span<Elem> destination)
+			{
+				file_stream.read(destination.data(), static_cast<std::streamsize>(destination.size()));
+				return static_cast<size_t>(file_stream.gcount());
+			}
+
+			bool is_open() { return file_stream.is_open(); }
+			void close() { file_stream.close(); }
+			void open(std::filesystem::path file_path, std::ios_base::openmode open_mode = std::ios_base::in)
+			{
+				file_stream.open(file_path, std::ios_base::in | open_mode);
+				if (!is_open())
+					throw std::runtime_error(
+						std::string{
+							std::string{ "ERROR! Cannot open "} +
+							file_path.string() +
+							std::string{ " file in raii::BasicInputFileStreamWrapper<" } +
+							std::string{ typeid(Elem).name() } +
+							std::string{ ", " } +
+							std::string{ typeid(Traits).name() } +
+							std::string{ ", " } +
+							std::string{ typeid(Alloc).name() } +
+							std::string{ ">::open() method." }
+						}.c_str()
+					);
+			}
+		};
+
+		// libstdc++ has no codecvt facet for std::byte, so this stream moves no data; use BinaryFileReader for binary input
+		template<typename Traits, typename Alloc>
+		struct BasicInputFileStreamWrapper<std::byte, Traits, Alloc>
+		{
+			using file_stream_type = std::basic_ifstream<std::byte, Traits>;
+			using type = BasicInputFileStreamWrapper<std::byte, Traits, Alloc>;
+			using string_type = std::basic_string<std::byte, Traits, Alloc>;
+			using stream_buffer_iterator = std::istreambuf_iterator<std::byte, Traits>;
+
+			file_stream_type file_stream;
+
+			BasicInputFileStreamWrapper() :file_stream{} {}
+			virtual ~BasicInputFileStreamWrapper() { if (is_open()) close(); }
+
+			template<typename T> constexpr type& operator>>(T& value) { file_stream >> value; return *this; }
+
+			bool is_open() { return file_stream.is_open(); }
+			void close() { file_stream.close(); }
+			void open(std::filesystem::path file_path, std::ios_base::openmode open_mode = std::ios_base::in | std::ios_base::binary)
+			{
+				file_stream.open(file_path, std::ios_base::in | std::ios_base::binary | open_mode);
+				if (!is_open())
+					throw std::runtime_error(
+						std::string{
+							std::string{"ERROR! Cannot open "} +
+							file_path.string() +
+							std::string{" file in raii::BasicInputFileStreamWrapper<std::byte>::open() method." }
+						}.c_str()
+					);
+			}
+		};
+
+		template<typename Elem, typename Traits = std::char_traits<Elem>, typename Alloc = std::allocator<Elem>>
+		struct BasicOutputFileStreamWrapper
+		{
+			using file_stream_type = std::basic_ofstream<Elem, Traits>;
+			using type = BasicOutputFileStreamWrapper<Elem, Traits, Alloc>;
+			using string_type = std::basic_string<Elem, Traits, Alloc>;
+			using stream_buffer_iterator = std::ostreambuf_iterator<Elem, Traits>;
+
+			file_stream_type file_stream;
+
+			BasicOutputFileStreamWrapper() :file_stream{} {}
+			virtual ~BasicOutputFileStreamWrapper() { if (is_open()) close(); }
+
+			template<typename T> constexpr type& operator<<(const T& value) { put(value); return *this; }
+			template<typename T> constexpr type& operator<<(T&& value) noexcept { put(value); return *this; }
+
+			// Bulk write of a whole span in one stream operation
+			type& write(std::span<const Elem> source)
+			{
+				file_stream.write(source.data(), static_cast<std::streamsize>(source.size()));
+				return *this;
+			}
+
+			bool is_open() { return file_stream.is_open(); }
+			void close() { file_stream.flush(); file_stream.close(); }
+			void open(std::filesystem::path file_path, std::ios_base::openmode open_mode = std::ios_base::out)
+			{
+				file_stream.open(file_path, std::ios::out | open_mode);
+				if (!is_open())
+					throw std::runtime_error(
+						std::string{
+							std::string{"ERROR! Cannot open "} +
+							file_path.string() +
+							std::string{" file in raii::BasicOutputFileStreamWrapper<"} +
+							std::string{typeid(Elem).name()} +
+							std::string{", "} +
+							std::string{typeid(Traits).name()} +
+							std::string{", "} +
+							std::string{ typeid(Alloc).name() } +
+							std::string{ "::open() method." }
+						}.c_str()
+					);
+			}
+
+		private:
+			// Numbers bypass the stream's num_put while it formats them plainly (default flags, no width, classic locale):
+			// std::to_chars writes the same characters, for floating point at the stream's precision as %g does
+			template<typename T> void put(const T& value)
+			{
+				using U = std::remove_cvref_t<T>;
+				if constexpr (std::is_same_v<Elem, char> && std::is_arithmetic_v<U> && !std::is_same_v<U, bool>
+					&& !std::is_same_v<U, char> && !std::is_same_v<U, signed char> && !std::is_same_v<U, unsigned char>
+					&& !std::is_same_v<U, wchar_t> && !std::is_same_v<U, char8_t> && !std::is_same_v<U, char16_t> && !std::is_same_v<U, char32_t>)
+				{
+					if (file_stream.flags() == (std::ios_base::skipws | std::ios_base::dec) && file_stream.width() == 0
+						&& file_stream.getloc() == std::locale::classic())
+					{
+						char buffer[64];
+						std::to_chars_result result{};
+						if constexpr (std::is_floating_point_v<U>)
+							result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, static_cast<int>(file_stream.precision()));
+						else
+							result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+						if (result.ec == std::errc{})
+						{
+							file_stream.write(buffer, result.ptr - buffer);
+							return;
+						}
+					}
+				}
+				file_stream << value;
+			}
+		};
+
+		// As above: use BinaryFileWriter for binary output
+		template<typename Traits, typename Alloc>
+		struct BasicOutputFileStreamWrapper<std::byte, Traits, Alloc>
+		{
+			using file_stream_type = std::basic_ofstream<std::byte, Traits>;
+			using type = BasicOutputFileStreamWrapper<std::byte, Traits, Alloc>;
+			using string_type = std::basic_string<std::byte, Traits, Alloc>;
+			using stream_buffer_iterator = std::ostreambuf_iterator<std::byte, Traits>;
+
+			file_stream_type file_stream;
+
+			BasicOutputFileStreamWrapper() :file_stream{} {}
+			virtual ~BasicOutputFileStreamWrapper() { if (is_open()) close(); }
+
+			template<typename T> constexpr type& operator<<(const T& value) { file_stream << value; return *this; }
+			template<typename T> constexpr type& operator<<(T&& value) noexcept { file_stream << value; return *this; }
+
+			bool is_open() { return file_stream.is_open(); }
+			void close() { file_stream.flush(); file_stream.close(); }
+			void open(std::filesystem::path file_path, std::ios_base::openmode open_mode = std::ios_base::out | std::ios_base::binary)
+			{
+				file_stream.open(file_path, std::ios::out | std::ios_base::binary | open_mode);
+				if (!is_open())
+					throw std::runtime_error(
+						std::string{
+							std::string{"ERROR! Cannot open "} +
+							file_path.string() +
+							std::string{" file in raii::BasicOutputFileStreamWrapper<std::byte>::open() method." }
+						}.c_str()
+					);
+			}
+		};
+
+		// Memory-mapped file: the contents are read (and, in read-write mode, written) in place through
+		// the page cache, without copying into a stream buffer. Unmapped on destruction.
+		class MappedFile
+		{
+		public:
+			enum class Mode { read_only, read_write };
+
+			// madvise() hints; combine with |
+			enum class Advice : unsigned
+			{
+				normal = 0,
+				sequential = 1 << 0,
+				random = 1 << 1,
+				willneed = 1 << 2,
+				dontneed = 1 << 3,
+				hugepages = 1 << 4
+			};
+			friend constexpr Advice operator|(Advice lhs, Advice rhs) noexcept { return static_cast<Advice>(static_cast<unsigned>(lhs) | static_cast<unsigned>(rhs)); }
+			friend constexpr bool operator&(Advice lhs, Advice rhs) noexcept { return (static_cast<unsigned>(lhs) & static_cast<unsigned>(rhs)) != 0; }
+
+			MappedFile() :m_data{ nullptr }, m_size{ 0 }, m_fd{ -1 }, m_mode{ Mode::read_only }, m_path{} {}
+			explicit MappedFile(std::filesystem::path file_path, Mode mode = Mode::read_only, Advice advice = Advice::normal) :MappedFile{}
+			{
+				open(std::move(file_path), mode);
+				if (advice != Advice::normal)
+					advise(advice);
+			}
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+			MappedFile(MappedFile&& other) noexcept
+				:m_data{ std::exchange(other.m_data, nullptr) }, m_size{ std::exchange(other.m_size, 0) },
+				m_fd{ std::exchange(other.m_fd, -1) }, m_mode{ other.m_mode }, m_path{ std::move(other.m_path) } {}
+			MappedFile& operator=(MappedFile&& other) noexcept
+			{
+				if (this != &other)
+				{
+					if (is_open()) close();
+					m_data = std::exchange(other.m_data, nullptr);
+					m_size = std::exchange(other.m_size, 0);
+					m_fd = std::exchange(other.m_fd, -1);
+					m_mode = other.m_mode;
+					m_path = std::move(other.m_path);
+				}
+				return *this;
+			}
+			virtual ~MappedFile() { if (is_open()) close(); }
+
+			bool is_open() const noexcept { return !m_path.empty(); }
+
+			// read_write creates the file if needed; a non-zero size grows (or shrinks) it to that many bytes first
+			void open(std::filesystem::path file_path, Mode mode = Mode::read_only, size_t size = 0)
+			{
+				if (is_open()) close();
+				int fd = ::open(file_path.c_str(), (mode == Mode::read_only ? O_RDONLY : O_RDWR | O_CREAT) | O_CLOEXEC, 0644);
+				struct stat status{};
+				if (fd < 0 || ::fstat(fd, &status) != 0)
+				{
+					if (fd >= 0) ::close(fd);
+					throw_error("Cannot open ", file_path, "open");
+				}
+				size_t file_size = static_cast<size_t>(status.st_size);
+				if (mode == Mode::read_write && size != 0 && size != file_size)
+				{
+					if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+					{
+						::close(fd);
+						throw_error("Cannot resize ", file_path, "open");
+					}
+					file_size = size;
+				}
+				void* data = nullptr;
+				if (file_size != 0)
+				{
+					data = ::mmap(nullptr, file_size, mode == Mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+					if (data == MAP_FAILED)
+					{
+						::close(fd);
+						throw_error("Cannot map ", file_path, "open");
+					}
+				}
+				// A read-only mapping stays valid without the descriptor; read-write keeps it for resize()
+				if (mode == Mode::read_only)
+				{
+					::close(fd);
+					fd = -1;
+				}
+				m_data = static_cast<std::byte*>(data);
+				m_size = file_size;
+				m_fd = fd;
+				m_mode = mode;
+				m_path = std::move(file_path);
+			}
+
+			void close() noexcept
+			{
+				if (m_data != nullptr)
+					::munmap(m_data, m_size);
+				if (m_fd >= 0)
+					::close(m_fd);
+				m_data = nullptr;
+				m_size = 0;
+				m_fd = -1;
+				m_path.clear();
+			}
+
+			// Best effort: returns false if the kernel rejected any of the hints
+			bool advise(Advice advice, size_t offset = 0, size_t length = std::string_view::npos) noexcept
+			{
+				if (m_data == nullptr || offset >= m_size)
+					return true;
+				// madvise() wants a page-aligned start
+				size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+				size_t begin = offset / page_size * page_size;
+				size_t end = length >= m_size - offset ? m_size : offset + length;
+				auto apply = [&](int hint) { return ::madvise(m_data + begin, end - begin, hint) == 0; };
+				bool ok = true;
+				if (advice & Advice::sequential) ok &= apply(MADV_SEQUENTIAL);
+				if (advice & Advice::random) ok &= apply(MADV_RANDOM);
+				if (advice & Advice::willneed) ok &= apply(MADV_WILLNEED);
+				if (advice & Advice::dontneed) ok &= apply(MADV_DONTNEED);
+#if defined(MADV_HUGEPAGE)
+				if (advice & Advice::hugepages) ok &= apply(MADV_HUGEPAGE);
+#else
+				if (advice & Advice::hugepages) ok = false;
+#endif
+				return ok;
+			}
+
+			// read_write only: change the file size and remap it (data() may move)
+			void resize(size_t size)
+			{
+				require_writable("resize");
+				if (m_data != nullptr)
+					::munmap(m_data, m_size);
+				m_data = nullptr;
+				m_size = 0;
+				if (::ftruncate(m_fd, static_cast<off_t>(size)) != 0)
+					throw_error("Cannot resize ", m_path, "resize");
+				if (size != 0)
+				{
+					void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+					if (data == MAP_FAILED)
+						throw_error("Cannot map ", m_path, "resize");
+					m_data = static_cast<std::byte*>(data);
+				}
+				m_size = size;
+			}
+
+			// read_write only: flush dirty pages to the file (asynchronously if requested)
+			void sync(bool asynchronous = false)
+			{
+				require_writable("sync");
+				if (m_data != nullptr && ::msync(m_data, m_size, asynchronous ? MS_ASYNC : MS_SYNC) != 0)
+					throw_error("Cannot sync ", m_path, "sync");
+			}
+
+			Mode mode() const noexcept { return m_mode; }
+			size_t size() const noexcept { return m_size; }
+			bool empty() const noexcept { return m_size == 0; }
+			const std::byte* data() const noexcept { return m_data; }
+			std::span<const std::byte> bytes() const noexcept { return { m_data, m_size }; }
+			std::string_view view() const noexcept { return { reinterpret_cast<const char*>(m_data), m_size }; }
+			std::span<std::byte> writable_bytes()
+			{
+				require_writable("writable_bytes");
+				return { m_data, m_size };
+			}
+
+		private:
+			[[noreturn]] static void throw_error(const char* what, const std::filesystem::path& file_path, const char* method)
+			{
+				throw std::runtime_error(
+					std::string{
+						std::string{ "ERROR! " } +
+						std::string{ what } +
+						file_path.string() +
+						std::string{ " file in raii::MappedFile::" } +
+						std::string{ method } +
+						std::string{ "() method (" } +
+						std::string{ std::strerror(errno) } +
+						std::string{ ")." }
+					}.c_str()
+				);
+			}
+
+			void require_writable(const char* method) const
+			{
+				if (m_mode != Mode::read_write || !is_open())
+					throw std::logic_error(
+						std::string{
+							std::string{ "ERROR! raii::MappedFile::" } +
+							std::string{ method } +
+							std::string{ "() method requires a file opened in read_write mode." }
+						}.c_str()
+					);
+			}
+
+			std::byte* m_data;
+			size_t m_size;
+			int m_fd;
+			Mode m_mode;
+			std::filesystem::path m_path;
+		};
+
+		// Heap buffer with a chosen alignment (4 KiB by default, as O_DIRECT requires)
+		class AlignedBuffer
+		{
+		public:
+			static constexpr inline size_t default_alignment = 4096;
+
+			AlignedBuffer() noexcept :m_data{ nullptr }, m_size{ 0 }, m_alignment{ default_alignment } {}
+			explicit AlignedBuffer(size_t size, size_t alignment = default_alignment)
+				:m_data{ size == 0 ? nullptr : static_cast<std::byte*>(::operator new(size, std::align_val_t{ alignment })) },
+				m_size{ size }, m_alignment{ alignment } {}
+			AlignedBuffer(const AlignedBuffer&) = delete;
+			AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+			AlignedBuffer(AlignedBuffer&& other) noexcept
+				:m_data{ std::exchange(other.m_data, nullptr) }, m_size{ std::exchange(other.m_size, 0) }, m_alignment{ other.m_alignment } {}
+			AlignedBuffer& operator=(AlignedBuffer&& other) noexcept
+			{
+				if (this != &other)
+				{
+					release();
+					m_data = std::exchange(other.m_data, nullptr);
+					m_size = std::exchange(other.m_size, 0);
+					m_alignment = other.m_alignment;
+				}
+				return *this;
+			}
+			virtual ~AlignedBuffer() { release(); }
+
+			std::byte* data() const noexcept { return m_data; }
+			size_t size() const noexcept { return m_size; }
+			size_t alignment() const noexcept { return m_alignment; }
+			std::span<std::byte> span() const noexcept { return { m_data, m_size }; }
+
+		private:
+			void release() noexcept
+			{
+				if (m_data != nullptr)
+					::operator delete(m_data, std::align_val_t{ m_alignment });
+				m_data = nullptr;
+				m_size = 0;
+			}
+
+			std::byte* m_data;
+			size_t m_size;
+			size_t m_alignment;
+		};
+
+		// Bulk binary reader over a file descriptor with a user-sized aligned buffer. Requests at least
+		// one buffer long bypass the buffer and read straight into the destination. With direct = true
+		// the file is opened with O_DIRECT (the page cache is skipped); the buffer size is rounded up to
+		// whole 4 KiB blocks and only aligned destinations are read into directly.
+		class BinaryFileReader
+		{
+		public:
+			static constexpr inline size_t default_buffer_size = 1 << 20;
+
+			BinaryFileReader() :m_fd{ -1 }, m_buffer{}, m_begin{ 0 }, m_end{ 0 }, m_eof{ false }, m_direct{ false }, m_path{} {}
+			explicit BinaryFileReader(std::filesystem::path file_path, size_t buffer_size = default_buffer_size, bool direct = false) :BinaryFileReader{}
+			{
+				open(std::move(file_path), buffer_size, direct);
+			}
+			BinaryFileReader(const BinaryFileReader&) = delete;
+			BinaryFileReader& operator=(const BinaryFileReader&) = delete;
+			virtual ~BinaryFileReader() { if (is_open()) close(); }
+
+			bool is_open() const noexcept { return m_fd >= 0; }
+
+			void open(std::filesystem::path file_path, size_t buffer_size = default_buffer_size, bool direct = false)
+			{
+				if (is_open()) close();
+				int fd = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC | (direct ? O_DIRECT : 0));
+				if (fd < 0)
+					throw std::runtime_error(
+						std::string{
+							std::string{ "ERROR! Cannot open " } +
+							file_path.string() +
+							std::string{ " file in raii::BinaryFileReader::open() method (" } +
+							std::string{ std::strerror(errno) } +
+							std::string{ ")." }
+						}.c_str()
+					);
+				size_t block = AlignedBuffer::default_alignment;
+				m_buffer = AlignedBuffer{ (std::max<size_t>(buffer_size, 1) + block - 1) / block * block };
+				m_fd = fd;
+				m_begin = m_end = 0;
+				m_eof = false;
+				m_direct = direct;
+				m_path = std::move(file_path);
+			}
+
+			void close() noexcept
+			{
+				if (m_fd >= 0)
+					::close(m_fd);
+				m_fd = -1;
+				m_begin = m_end = 0;
+			}
+
+			// Fills the destination; returns fewer bytes only at end of file
+			size_t read_into(std::span<std::byte> destination)
+			{
+				size_t total = 0;
+				while (total < destination.size())
+				{
+					if (m_begin < m_end)
+					{
+						size_t n = std::min(m_end - m_begin, destination.size() - total);
+						std::memcpy(destination.data() + total, m_buffer.data() + m_begin, n);
+						m_begin += n;
+						total += n;
+						continue;
+					}
+					if (m_eof)
+						break;
+					std::byte* target = destination.data() + total;
+					size_t remaining = destination.size() - total;
+					bool aligned = reinterpret_cast<uintptr_t>(target) % m_buffer.alignment() == 0;
+					if (remaining >= m_buffer.size() && (!m_direct || aligned))
+					{
+						size_t chunk = m_direct ? remaining / m_buffer.alignment() * m_buffer.alignment() : remaining;
+						total += read_some(target, chunk);
+						continue;
+					}
+					m_begin = 0;
+					m_end = read_some(m_buffer.data(), m_buffer.size());
+				}
+				return total;
+			}
+
+			bool eof() const noexcept { return m_eof && m_begin == m_end; }
+			int native_handle() const noexcept { return m_fd; }
+
+		private:
+			size_t read_some(std::byte* target, size_t size)
+			{
+				ssize_t n;
+				do
+				{
+					n = ::read(m_fd, target, size);
+				} while (n < 0 && errno == EINTR);
+				if (n < 0)
+					throw std::runtime_error(
+						std::string{
+							std::string{ "ERROR! Cannot read " } +
+							m_path.string() +
+							std::string{ " file in raii::BinaryFileReader::read_into() method (" } +
+							std::string{ std::strerror(errno) } +
+							std::string{ ")." }
+						}.c_str()
+					);
+				if (n == 0)
+					m_eof = true;
+				return static_cast<size_t>(n);
+			}
+
+			int m_fd;
+			AlignedBuffer m_buffer;
+			size_t m_begin;
+			size_t m_end;
+			bool m_eof;
+			bool m_direct;
+			std::filesystem::path m_path;
+		};
+
+		// Bulk binary writer counterpart. Writes at least one buffer long go straight to the file when
+		// the buffer is empty. In O_DIRECT mode only whole blocks are written until close(), which drops
+		// O_DIRECT to write the unaligned tail.
+		class BinaryFileWriter
+		{
+		public:
+			static constexpr inline size_t default_buffer_size = 1 << 20;
+
+			BinaryFileWriter() :m_fd{ -1 }, m_buffer{}, m_used{ 0 }, m_direct{ false }, m_path{} {}
+			explicit BinaryFileWriter(std::filesystem::path file_path, size_t buffer_size = default_buffer_size, bool direct = false, bool append = false) :BinaryFileWriter{}
+			{
+				open(std::move(file_path), buffer_size, direct, append);
+			}
+			BinaryFileWriter(const BinaryFileWriter&) = delete;
+			BinaryFileWriter& operator=(const BinaryFileWriter&) = delete;
+			virtual ~BinaryFileWriter()
+			{
+				if (is_open())
+				{
+					try { close(); } catch (...) {}
+				}
+			}
+
+			bool is_open() const noexcept { return m_fd >= 0; }
+
+			void open(std::filesystem::path file_path, size_t buffer_size = default_buffer_size, bool direct = false, bool append = false)
+			{
+				if (is_open()) close();
+				if (direct && append)
+					throw std::logic_error("ERROR! raii::BinaryFileWriter::open() method cannot combine O_DIRECT with append (unaligned file offset).");
+				int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC) | (direct ? O_DIRECT : 0);
+				int fd = ::open(file_path.c_str(), flags, 0644);
+				if (fd < 0)
+					throw std::runtime_error(
+						std::string{
+							std::string{ "ERROR! Cannot open " } +
+							file_path.string() +
+							std::string{ " file in raii::BinaryFileWriter::open() method (" } +
+							std::string{ std::strerror(errno) } +
+							std::string{ ")." }
+						}.c_str()
+					);
+				size_t block = AlignedBuffer::default_alignment;
+				m_buffer = AlignedBuffer{ (std::max<size_t>(buffer_size, 1) + block - 1) / block * block };
+				m_fd = fd;
+				m_used = 0;
+				m_direct = direct;
+				m_path = std::move(file_path);
+			}
+
+			void write(std::span<const std::byte> source)
+			{
+				while (!source.empty())
+				{
+					bool aligned = reinterpret_cast<uintptr_t>(source.data()) % m_buffer.alignment() == 0;
+					if (m_used == 0 && source.size() >= m_buffer.size() && (!m_direct || aligned))
+					{
+						size_t chunk = m_direct ? source.size() / m_buffer.alignment() * m_buffer.alignment() : source.size();
+						write_all(source.data(), chunk);
+						source = source.subspan(chunk);
+						continue;
+					}
+					size_t n = std::min(m_buffer.size() - m_used, source.size());
+					std::memcpy(m_buffer.data() + m_used, source.data(), n);
+					m_used += n;
+					source = source.subspan(n);
+					if (m_used == m_buffer.size())
+					{
+						write_all(m_buffer.data(), m_used);
+						m_used = 0;
+					}
+				}
+			}
+
+			// Hands buffered bytes to the kernel; in O_DIRECT mode a partial last block stays buffered
+			void flush()
+			{
+				size_t n = m_direct ? m_used / m_buffer.alignment() * m_buffer.alignment() : m_used;
+				if (n == 0)
+					return;
+				write_all(m_buffer.data(), n);
+				std::memmove(m_buffer.data(), m_buffer.data() + n, m_used - n);
+				m_used -= n;
+			}
+
+			void close()
+			{
+				flush();
+				if (m_used != 0)
+				{
+					::fcntl(m_fd, F_SETFL, ::fcntl(m_fd, F_GETFL) & ~O_DIRECT);
+					write_all(m_buffer.data(), m_used);
+					m_used = 0;
+				}
+				::close(m_fd);
+				m_fd = -1;
+			}
+
+			int native_handle() const noexcept { return m_fd; }
+
+		private:
+			void write_all(const std::byte* source, size_t size)
+			{
+				while (size != 0)
+				{
+					ssize_t n = ::write(m_fd, source, size);
+					if (n < 0 && errno == EINTR)
+						continue;
+					if (n < 0)
+						throw std::runtime_error(
+							std::string{
+								std::string{ "ERROR! Cannot write " } +
+								m_path.string() +
+								std::string{ " file in raii::BinaryFileWriter::write() method (" } +
+								std::string{ std::strerror(errno) } +
+								std::string{ ")." }
+							}.c_str()
+						);
+					source += n;
+					size -= static_cast<size_t>(n);
+				}
+			}
+
+			int m_fd;
+			AlignedBuffer m_buffer;
+			size_t m_used;
+			bool m_direct;
+			std::filesystem::path m_path;
+		};
+
+		// Minimal io_uring instance (raw syscalls, no liburing). read()/write() return awaitables, so a
+		// coroutine such as an asyncops Task can keep many operations in flight; a reaper thread resumes
+		// each awaiting coroutine when its completion arrives (co_await pool.schedule() to hop elsewhere).
+		// Where io_uring is unavailable (old kernel, seccomp) operations run synchronously with pread/pwrite.
+		class IoUring
+		{
+		public:
+			struct Operation
+			{
+				IoUring& ring;
+				uint8_t opcode;
+				int fd;
+				void* buffer;
+				unsigned length;
+				uint64_t offset;
+				int result{ 0 };
+				std::coroutine_handle<> handle{};
+
+				constexpr bool await_ready() noexcept { return false; }
+				inline bool await_suspend(std::coroutine_handle<> h)
+				{
+					handle = h;
+					return ring.submit(*this);
+				}
+				inline size_t await_resume()
+				{
+					if (result < 0)
+						throw std::runtime_error(
+							std::string{
+								std::string{ opcode == IORING_OP_READ ? "ERROR! Cannot read" : "ERROR! Cannot write" } +
+								std::string{ " in raii::IoUring operation (" } +
+								std::string{ std::strerror(-result) } +
+								std::string{ ")." }
+							}.c_str()
+						);
+					return static_cast<size_t>(result);
+				}
+			};
+
+			explicit IoUring(unsigned entries = 256)
+				:m_fd{ -1 }, m_params{}, m_sq_ring{ nullptr }, m_cq_ring{ nullptr }, m_sqes{ nullptr }, m_sq_ring_size{ 0 }, m_cq_ring_size{ 0 },
+				m_submit_mutex{}, m_in_flight{ 0 }, m_capacity{ 0 }, m_reaper{}
+			{
+				m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &m_params));
+				if (m_fd < 0)
+					return;
+				m_sq_ring_size = m_params.sq_off.array + m_params.sq_entries * sizeof(unsigned);
+				m_cq_ring_size = m_params.cq_off.cqes + m_params.cq_entries * sizeof(io_uring_cqe);
+				bool single_mmap = (m_params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+				if (single_mmap)
+					m_sq_ring_size = m_cq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+				m_sq_ring = map(m_sq_ring_size, IORING_OFF_SQ_RING);
+				m_cq_ring = single_mmap ? m_sq_ring : map(m_cq_ring_size, IORING_OFF_CQ_RING);
+				m_sqes = static_cast<io_uring_sqe*>(map(m_params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES));
+				if (m_sq_ring == nullptr || m_cq_ring == nullptr || m_sqes == nullptr)
+				{
+					unmap();
+					return;
+				}
+				m_capacity = m_params.cq_entries / 2;
+				m_reaper = std::thread{ [this]() { reap(); } };
+			}
+
+			IoUring(const IoUring&) = delete;
+			IoUring& operator=(const IoUring&) = delete;
+
+			// Every operation must have completed before the ring is destroyed
+			virtual ~IoUring()
+			{
+				if (m_reaper.joinable())
+				{
+					Operation stop{ *this, IORING_OP_NOP, -1, nullptr, 0, 0 };
+					push(stop, 0);
+					m_reaper.join();
+				}
+				unmap();
+			}
+
+			bool is_async() const noexcept { return m_reaper.joinable(); }
+
+			Operation read(int fd, std::span<std::byte> destination, uint64_t offset)
+			{
+				return Operation{ *this, IORING_OP_READ, fd, destination.data(), clamp(destination.size()), offset };
+			}
+
+			Operation write(int fd, std::span<const std::byte> source, uint64_t offset)
+			{
+				return Operation{ *this, IORING_OP_WRITE, fd, const_cast<std::byte*>(source.data()), clamp(source.size()), offset };
+			}
+
+		private:
+			static unsigned clamp(size_t size) noexcept { return static_cast<unsigned>(std::min<size_t>(size, 1u << 30)); }
+
+			void* map(size_t size, off_t offset) noexcept
+			{
+				void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, offset);
+				return p == MAP_FAILED ? nullptr : p;
+			}
+
+			void unmap() noexcept
+			{
+				if (m_sqes != nullptr)
+					::munmap(m_sqes, m_params.sq_entries * sizeof(io_uring_sqe));
+				if (m_cq_ring != nullptr && m_cq_ring != m_sq_ring)
+					::munmap(m_cq_ring, m_cq_ring_size);
+				if (m_sq_ring != nullptr)
+					::munmap(m_sq_ring, m_sq_ring_size);
+				if (m_fd >= 0)
+					::close(m_fd);
+				m_sqes = nullptr;
+				m_sq_ring = m_cq_ring = nullptr;
+				m_fd = -1;
+			}
+
+			std::atomic_ref<unsigned> sq_field(unsigned offset) noexcept { return std::atomic_ref<unsigned>{ *reinterpret_cast<unsigned*>(static_cast<std::byte*>(m_sq_ring) + offset) }; }
+			std::atomic_ref<unsigned> cq_field(unsigned offset) noexcept { return std::atomic_ref<unsigned>{ *reinterpret_cast<unsigned*>(static_cast<std::byte*>(m_cq_ring) + offset) }; }
+
+			// Returns false when the operation already completed (synchronous fallback), so the caller is not suspended
+			bool submit(Operation& op)
+			{
+				if (!is_async())
+				{
+					ssize_t n;
+					do
+					{
+						n = op.opcode == IORING_OP_READ ? ::pread(op.fd, op.buffer, op.length, static_cast<off_t>(op.offset))
+							: ::pwrite(op.fd, op.buffer, op.length, static_cast<off_t>(op.offset));
+					} while (n < 0 && errno == EINTR);
+					op.result = n < 0 ? -errno : static_cast<int>(n);
+					return false;
+				}
+				// Keep the operations in flight within half the completion queue so completions are never dropped.
+				// The reaper never waits (it resumes the coroutines that would free a slot); the other half of the
+				// queue absorbs its submissions and those racing past this check.
+				if (std::this_thread::get_id() != m_reaper.get_id())
+				{
+					for (unsigned in_flight = m_in_flight.load(std::memory_order_relaxed); in_flight >= m_capacity; in_flight = m_in_flight.load(std::memory_order_relaxed))
+						m_in_flight.wait(in_flight, std::memory_order_relaxed);
+				}
+				push(op, reinterpret_cast<uint64_t>(&op));
+				return true;
+			}
+
+			void push(Operation& op, uint64_t user_data)
+			{
+				std::scoped_lock lock{ m_submit_mutex };
+				unsigned mask = *reinterpret_cast<unsigned*>(static_cast<std::byte*>(m_sq_ring) + m_params.sq_off.ring_mask);
+				unsigned tail = sq_field(m_params.sq_off.tail).load(std::memory_order_relaxed);
+				unsigned index = tail & mask;
+				io_uring_sqe& sqe = m_sqes[index];
+				std::memset(&sqe, 0, sizeof(sqe));
+				sqe.opcode = op.opcode;
+				sqe.fd = op.fd;
+				sqe.addr = reinterpret_cast<uint64_t>(op.buffer);
+				sqe.len = op.length;
+				sqe.off = op.offset;
+				sqe.user_data = user_data;
+				// Release: the reaper acquires this counter before it touches the operation again
+				m_in_flight.fetch_add(1, std::memory_order_release);
+				reinterpret_cast<unsigned*>(static_cast<std::byte*>(m_sq_ring) + m_params.sq_off.array)[index] = index;
+				sq_field(m_params.sq_off.tail).store(tail + 1, std::memory_order_release);
+				while (::syscall(__NR_io_uring_enter, m_fd, 1, 0, 0, nullptr, 0) < 0)
+				{
+					if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+						throw std::runtime_error(
+							std::string{
+								std::string{ "ERROR! Cannot submit in raii::IoUring::submit() method (" } +
+								std::string{ std::strerror(errno) } +
+								std::string{ ")." }
+							}.c_str()
+						);
+				}
+			}
+
+			void reap()
+			{
+				unsigned mask = *reinterpret_cast<unsigned*>(static_cast<std::byte*>(m_cq_ring) + m_params.cq_off.ring_mask);
+				auto* cqes = reinterpret_cast<io_uring_cqe*>(static_cast<std::byte*>(m_cq_ring) + m_params.cq_off.cqes);
+				bool stopping = false;
+				while (!stopping)
+				{
+					::syscall(__NR_io_uring_enter, m_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+					unsigned head = cq_field(m_params.cq_off.head).load(std::memory_order_relaxed);
+					unsigned tail = cq_field(m_params.cq_off.tail).load(std::memory_order_acquire);
+					for (; head != tail; ++head)
+					{
+						io_uring_cqe cqe = cqes[head & mask];
+						// Hand the slot back before resuming: the resumed coroutine may run for a long time
+						cq_field(m_params.cq_off.head).store(head + 1, std::memory_order_release);
+						if (cqe.user_data == 0)
+						{
+							stopping = true;
+							continue;
+						}
+						m_in_flight.fetch_sub(1, std::memory_order_acquire);
+						m_in_flight.notify_one();
+						auto* op = reinterpret_cast<Operation*>(cqe.user_data);
+						op->result = cqe.res;
+						op->handle.resume();
+					}
+				}
+			}
+
+			int m_fd;
+			io_uring_params m_params;
+			void* m_sq_ring;
+			void* m_cq_ring;
+			io_uring_sqe* m_sqes;
+			size_t m_sq_ring_size;
+			size_t m_cq_ring_size;
+			std::mutex m_submit_mutex;
+			std::atomic<unsigned> m_in_flight;
+			unsigned m_capacity;
+			std::thread m_reaper;
+		};
+
+		// File opened for asynchronous positional I/O through an IoUring
+		class AsyncFile
+		{
+		public:
+			AsyncFile(IoUring& ring, std::filesystem::path file_path, bool writable = false)
+				:m_ring{ ring }, m_fd{ ::open(file_path.c_str(), (writable ? O_RDWR | O_CREAT : O_RDONLY) | O_CLOEXEC, 0644) }
+			{
+				if (m_fd < 0)
+					throw std::runtime_error(
+						std::string{
+							std::string{ "ERROR! Cannot open " } +
+							file_path.string() +
+							std::string{ " file in raii::AsyncFile::AsyncFile() constructor (" } +
+							std::string{ std::strerror(errno) } +
+							std::string{ ")." }
+						}.c_str()
+					);
+			}
+			AsyncFile(const AsyncFile&) = delete;
+			AsyncFile& operator=(const AsyncFile&) = delete;
+			virtual ~AsyncFile() { ::close(m_fd); }
+
+			// co_await file.read(buffer, offset) -> bytes read
+			IoUring::Operation read(std::span<std::byte> destination, uint64_t offset) { return m_ring.read(m_fd, destination, offset); }
+			// co_await file.write(bytes, offset) -> bytes written
+			IoUring::Operation write(std::span<const std::byte> source, uint64_t offset) { return m_ring.write(m_fd, source, offset); }
+
+			int native_handle() const noexcept { return m_fd; }
+
+		private:
+			IoUring& m_ring;
+			int m_fd;
+		};
+
+		namespace native
+		{
+			namespace narrow_encoded 
+			{
+				using InputFileStreamWrapper = BasicInputFileStreamWrapper<char>;
+				using OutputFileStreamWrapper = BasicOutputFileStreamWrapper<char>;
+			}
+			namespace wide_encoded
+			{
+				using InputFileStreamWrapper = BasicInputFileStreamWrapper<wchar_t>;
+				using OutputFileStreamWrapper = BasicOutputFileStreamWrapper<wchar_t>;
+			}
+		}
+        #if __cplusplus >= 202002L
+		namespace utf8
+		{
+			using InputFileStreamWrapper = BasicInputFileStreamWrapper<char8_t>;
+			using OutputFileStreamWrapper = BasicOutputFileStreamWrapper<char8_t>;
+		}
+        #endif
+		namespace binary
+		{
+			using InputFileStreamWrapper = BasicInputFileStreamWrapper<std::byte>;
+			using OutputFileStreamWrapper = BasicOutputFileStreamWrapper<std::byte>;
+		}
+	}
+}
+)";
+
+        // containers.hpp content
+        constexpr std::string_view containers_content = R"(#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define POORIAYOUSEFI_CORE_FLAT_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define POORIAYOUSEFI_CORE_FLAT_NEON 1
+#endif
+
+/**********************************************************************************************
+*
+*                   			    Flat Containers
+*                   			-----------------------
+*    		This header provides cache-friendly hash containers and hashing.
+*    		It includes:
+*    		- hash_bytes, a fast (wyhash-style) hash of a byte range.
+*    		- fast_hash, a hasher for strings, string views, integers, std::byte and
+*    		  enums, falling back to a mixed std::hash for other keys.
+*    		- flat_set and flat_map, open-addressing hash containers with one control
+*    		  byte per slot probed a group at a time (SSE2 / NEON / portable).
+*
+*                   			Developed by: Pooria Yousefi
+*				   				Date: 2025-06-26
+*				   				License: MIT
+*
+**********************************************************************************************/
+
+namespace pooriayousefi::core
+{
+    namespace detail
+    {
+        // 64 x 64 -> 128-bit product: lo receives the low half, hi the high half
+        constexpr void multiply_wide(uint64_t& lo, uint64_t& hi) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            __extension__ using uint128 = unsigned __int128;
+            uint128 product = static_cast<uint128>(lo) * hi;
+            lo = static_cast<uint64_t>(product);
+            hi = static_cast<uint64_t>(product >> 64);
+#else
+            uint64_t a_hi = lo >> 32, a_lo = lo & 0xffffffffull, b_hi = hi >> 32, b_lo = hi & 0xffffffffull;
+            uint64_t cross_1 = a_hi * b_lo, cross_2 = a_lo * b_hi, low = a_lo * b_lo;
+            uint64_t middle = (low >> 32) + (cross_1 & 0xffffffffull) + (cross_2 & 0xffffffffull);
+            hi = a_hi * b_hi + (cross_1 >> 32) + (cross_2 >> 32) + (middle >> 32);
+            lo = (middle << 32) | (low & 0xffffffffull);
+#endif
+        }
+
+        // Folded 128-bit product: one multiply that spreads every input bit over the whole result
+        constexpr uint64_t fold_multiply(uint64_t a, uint64_t b) noexcept
+        {
+            multiply_wide(a, b);
+            return a ^ b;
+        }
+
+        inline uint64_t read_8(const unsigned char* p) noexcept
+        {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        inline uint64_t read_4(const unsigned char* p) noexcept
+        {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline constexpr uint64_t hash_secret[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+    }
+
+    // wyhash-style hash of a byte range: short inputs take one or two multiplies, long ones run
+    // three independent 16-byte lanes. Not cryptographic, and not stable across platforms or versions.
+    inline uint64_t hash_bytes(const void* data, size_t size, uint64_t seed = 0) noexcept
+    {
+        using detail::hash_secret;
+        auto p = static_cast<const unsigned char*>(data);
+        seed ^= detail::fold_multiply(seed ^ hash_secret[0], hash_secret[1]);
+        uint64_t a, b;
+        if (size <= 16)
+        {
+            if (size >= 4)
+            {
+                size_t middle = (size >> 3) << 2;
+                a = (detail::read_4(p) << 32) | detail::read_4(p + middle);
+                b = (detail::read_4(p + size - 4) << 32) | detail::read_4(p + size - 4 - middle);
+            }
+            else if (size > 0)
+            {
+                a = (uint64_t{ p[0] } << 16) | (uint64_t{ p[size >> 1] } << 8) | p[size - 1];
+                b = 0;
+            }
+            else
+            {
+                a = b = 0;
+            }
+        }
+        else
+        {
+            size_t i = size;
+            if (i > 48)
+            {
+                uint64_t seed_1 = seed, seed_2 = seed;
+                do
+                {
+                    seed = detail::fold_multiply(detail::read_8(p) ^ hash_secret[1], detail::read_8(p + 8) ^ seed);
+                    seed_1 = detail::fold_multiply(detail::read_8(p + 16) ^ hash_secret[2], detail::read_8(p + 24) ^ seed_1);
+                    seed_2 = detail::fold_multiply(detail::read_8(p + 32) ^ hash_secret[3], detail::read_8(p + 40) ^ seed_2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= seed_1 ^ seed_2;
+            }
+            while (i > 16)
+            {
+                seed = detail::fold_multiply(detail::read_8(p) ^ hash_secret[1], detail::read_8(p + 8) ^ seed);
+                p += 16;
+                i -= 16;
+            }
+            // The last 16 bytes, overlapping what was already hashed
+            a = detail::read_8(p + i - 16);
+            b = detail::read_8(p + i - 8);
+        }
+        a ^= hash_secret[1];
+        b ^= seed;
+        detail::multiply_wide(a, b);
+        return detail::fold_multiply(a ^ hash_secret[0] ^ size, b ^ hash_secret[1]);
+    }
+
+    // Hasher whose results are well mixed in every bit (flat containers use them as they are). Strings
+    // and string views hash their characters with hash_bytes and are interchangeable (transparent); integers,
+    // enums, std::byte and pointers take one folded multiply; other keys mix the result of std::hash.
+    template<class Key>
+    struct fast_hash
+    {
+        using is_avalanching = void;
+
+        inline size_t operator()(const Key& key) const noexcept(noexcept(std::hash<Key>{}(key)))
+        {
+            if constexpr (std::is_integral_v<Key> || std::is_enum_v<Key> || std::is_pointer_v<Key>)
+            {
+                uint64_t bits;
+                if constexpr (std::is_pointer_v<Key>)
+                    bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key));
+                else
+                    bits = static_cast<uint64_t>(key);
+                return static_cast<size_t>(detail::fold_multiply(bits ^ detail::hash_secret[0], detail::hash_secret[1]));
+            }
+            else
+            {
+                return static_cast<size_t>(detail::fold_multiply(static_cast<uint64_t>(std::hash<Key>{}(key)) ^ detail::hash_secret[0], detail::hash_secret[1]));
+            }
+        }
+    };
+
+    template<class CharT, class Traits>
+    struct fast_hash<std::basic_string_view<CharT, Traits>>
+    {
+        using is_avalanching = void;
+        using is_transparent = void;
+
+        inline size_t operator()(std::basic_string_view<CharT, Traits> key) const noexcept
+        {
+            return static_cast<size_t>(hash_bytes(key.data(), key.size() * sizeof(CharT)));
+        }
+    };
+
+    template<class CharT, class Traits, class Allocator>
+    struct fast_hash<std::basic_string<CharT, Traits, Allocator>> :fast_hash<std::basic_string_view<CharT, Traits>> {};
+
+    template<>
+    struct fast_hash<std::byte> :fast_hash<unsigned char>
+    {
+        inline size_t operator()(std::byte key) const noexcept { return fast_hash<unsigned char>::operator()(std::to_integer<unsigned char>(key)); }
+    };
+
+    namespace detail
+    {
+        // Control bytes, one per slot: a full slot holds 7 bits of its key's hash, the others have the top bit set
+        inline constexpr int8_t ctrl_empty = -128;
+        inline constexpr int8_t ctrl_deleted = -2;
+
+        // Slots of a group that match a query, one bit per slot (Shift = 0) or the top bit of one byte per slot (Shift = 3)
+        template<size_t Width, int Shift>
+        struct GroupMask
+        {
+            uint64_t bits;
+
+            inline explicit operator bool() const noexcept { return bits != 0; }
+            inline size_t lowest() const noexcept { return static_cast<size_t>(std::countr_zero(bits)) >> Shift; }
+            inline void clear_lowest() noexcept { bits &= bits - 1; }
+            // Unmatched slots before the first and after the last match
+            inline size_t trailing() const noexcept { return lowest(); }
+            inline size_t leading() const noexcept { return static_cast<size_t>(std::countl_zero(bits) - (64 - static_cast<int>(Width << Shift))) >> Shift; }
+        };
+
+#if POORIAYOUSEFI_CORE_FLAT_SSE2
+        // 16 control bytes compared at once
+        struct Group
+        {
+            static constexpr size_t width = 16;
+            using Mask = GroupMask<width, 0>;
+
+            __m128i ctrl;
+
+            explicit Group(const int8_t* p) noexcept :ctrl{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)) } {}
+
+            inline Mask match(int8_t h2) const noexcept { return bits(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)); }
+            inline Mask match_empty() const noexcept { return match(ctrl_empty); }
+            inline Mask match_free() const noexcept { return bits(ctrl); }
+            inline Mask match_full() const noexcept { return Mask{ bits(ctrl).bits ^ 0xffffu }; }
+
+        private:
+            static inline Mask bits(__m128i v) noexcept { return Mask{ static_cast<uint32_t>(_mm_movemask_epi8(v)) }; }
+        };
+#elif POORIAYOUSEFI_CORE_FLAT_NEON
+        // 8 control bytes compared at once
+        struct Group
+        {
+            static constexpr size_t width = 8;
+            using Mask = GroupMask<width, 3>;
+            static constexpr uint64_t msbs = 0x8080808080808080ull;
+
+            int8x8_t ctrl;
+
+            explicit Group(const int8_t* p) noexcept :ctrl{ vld1_s8(p) } {}
+
+            inline Mask match(int8_t h2) const noexcept { return Mask{ vget_lane_u64(vreinterpret_u64_u8(vceq_s8(vdup_n_s8(h2), ctrl)), 0) & msbs }; }
+            inline Mask match_empty() const noexcept { return match(ctrl_empty); }
+            inline Mask match_free() const noexcept { return Mask{ vget_lane_u64(vreinterpret_u64_s8(ctrl), 0) & msbs }; }
+            inline Mask match_full() const noexcept { return Mask{ ~vget_lane_u64(vreinterpret_u64_s8(ctrl), 0) & msbs }; }
+        };
+#else
+        // 8 control bytes compared at once in a 64-bit word (SWAR)
+        struct Group
+        {
+            static constexpr size_t width = 8;
+            using Mask = GroupMask<width, 3>;
+            static constexpr uint64_t lsbs = 0x0101010101010101ull;
+            static constexpr uint64_t msbs = 0x8080808080808080ull;
+
+            uint64_t ctrl;
+
+            explicit Group(const int8_t* p) noexcept :ctrl{ 0 }
+            {
+                std::memcpy(&ctrl, p, sizeof(ctrl));
+                if constexpr (std::endian::native == std::endian::big)
+                    ctrl = std::byteswap(ctrl);
+            }
+
+            // May also report a byte just above a true match; callers compare keys anyway
+            inline Mask match(int8_t h2) const noexcept
+            {
+                uint64_t x = ctrl ^ (lsbs * static_cast<uint8_t>(h2));
+                return Mask{ (x - lsbs) & ~x & msbs };
+            }
+            // Empty is 0b10000000 and deleted 0b11111110: empty is the only one with bit 1 clear
+            inline Mask match_empty() const noexcept { return Mask{ ctrl & ~(ctrl << 6) & msbs }; }
+            inline Mask match_free() const noexcept { return Mask{ ctrl & msbs }; }
+            inline Mask match_full() const noexcept { return Mask{ ~ctrl & msbs }; }
+        };
+#endif
+
+        // Open-addressing table behind flat_set (Mapped = void) and flat_map. Keys, mapped values and control
+        // bytes live in three separate arrays, so a probe reads a group of control bytes and then only the
+        // keys whose 7 hash bits match. Capacity is a power of two (at least one group) filled to at most 7/8;
+        // the first group of control bytes is repeated after the last so that any slot starts a whole group.
+        template<class Key, class Mapped, class Hash, class KeyEqual>
+        class FlatTable
+        {
+        protected:
+            static constexpr bool is_map = !std::is_void_v<Mapped>;
+            // Sets have no mapped values; this only keeps the declarations below uniform
+            using Value = std::conditional_t<is_map, Mapped, char>;
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            static constexpr bool is_transparent = requires { typename Hash::is_transparent; typename KeyEqual::is_transparent; };
+
+        public:
+            using key_type = Key;
+            using size_type = size_t;
+            using difference_type = ptrdiff_t;
+            using hasher = Hash;
+            using key_equal = KeyEqual;
+
+            template<bool Const>
+            class Iterator
+            {
+                using Table = std::conditional_t<Const, const FlatTable, FlatTable>;
+                friend class FlatTable;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = std::conditional_t<is_map, std::pair<Key, Value>, Key>;
+                using difference_type = ptrdiff_t;
+                // Maps hand out a pair of references into the key and value arrays, like std::flat_map
+                using reference = std::conditional_t<is_map, std::pair<const Key&, std::conditional_t<Const, const Value&, Value&>>, const Key&>;
+                struct ArrowProxy
+                {
+                    reference ref;
+                    inline reference* operator->() noexcept { return std::addressof(ref); }
+                };
+                using pointer = std::conditional_t<is_map, ArrowProxy, const Key*>;
+
+                Iterator() noexcept :m_table{ nullptr }, m_index{ 0 } {}
+                template<bool C = Const> requires C
+                Iterator(const Iterator<false>& other) noexcept :m_table{ other.m_table }, m_index{ other.m_index } {}
+
+                inline reference operator*() const noexcept
+                {
+                    if constexpr (is_map)
+                        return reference{ m_table->m_keys[m_index], m_table->m_values[m_index] };
+                    else
+                        return m_table->m_keys[m_index];
+                }
+                inline pointer operator->() const noexcept
+                {
+                    if constexpr (is_map)
+                        return ArrowProxy{ **this };
+                    else
+                        return std::addressof(m_table->m_keys[m_index]);
+                }
+                inline Iterator& operator++() noexcept
+                {
+                    m_index = m_table->next_full(m_index + 1);
+                    return *this;
+                }
+                inline Iterator operator++(int) noexcept { auto previous = *this; ++*this; return previous; }
+                inline bool operator==(const Iterator& other) const noexcept { return m_index == other.m_index; }
+
+            private:
+                template<bool> friend class Iterator;
+                Iterator(Table* table, size_t index) noexcept :m_table{ table }, m_index{ index } {}
+
+                Table* m_table;
+                size_t m_index;
+            };
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+            FlatTable() = default;
+            explicit FlatTable(size_t capacity, const Hash& hash = Hash{}, const KeyEqual& equal = KeyEqual{}) :m_hash{ hash }, m_equal{ equal }
+            {
+                reserve(capacity);
+            }
+            FlatTable(const FlatTable& other) :m_hash{ other.m_hash }, m_equal{ other.m_equal }
+            {
+                if (other.m_size == 0)
+                    return;
+                allocate(other.m_capacity);
+                std::memcpy(m_ctrl, other.m_ctrl, m_capacity + Group::width);
+                size_t i = other.next_full(0);
+                try
+                {
+                    for (; i < m_capacity; i = other.next_full(i + 1))
+                    {
+                        std::construct_at(m_keys + i, other.m_keys[i]);
+                        if constexpr (is_map)
+                        {
+                            try
+                            {
+                                std::construct_at(m_values + i, other.m_values[i]);
+                            }
+                            catch (...)
+                            {
+                                std::destroy_at(m_keys + i);
+                                throw;
+                            }
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    // Only the slots below i were constructed
+                    for (size_t j = next_full(0); j < i; j = next_full(j + 1))
+                        destroy(j);
+                    deallocate();
+                    throw;
+                }
+                m_size = other.m_size;
+                m_growth_left = other.m_growth_left;
+            }
+            FlatTable(FlatTable&& other) noexcept
+                :m_ctrl{ std::exchange(other.m_ctrl, nullptr) }, m_keys{ std::exchange(other.m_keys, nullptr) },
+                m_values{ std::exchange(other.m_values, nullptr) }, m_capacity{ std::exchange(other.m_capacity, 0) },
+                m_size{ std::exchange(other.m_size, 0) }, m_growth_left{ std::exchange(other.m_growth_left, 0) },
+                m_hash{ other.m_hash }, m_equal{ other.m_equal } {}
+            FlatTable& operator=(const FlatTable& other)
+            {
+                if (this != &other)
+                {
+                    FlatTable copy{ other };
+                    swap(copy);
+                }
+                return *this;
+            }
+            FlatTable& operator=(FlatTable&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    FlatTable moved{ std::move(other) };
+                    swap(moved);
+                }
+                return *this;
+            }
+            ~FlatTable()
+            {
+                destroy_all();
+                deallocate();
+            }
+
+            inline void swap(FlatTable& other) noexcept
+            {
+                std::swap(m_ctrl, other.m_ctrl);
+                std::swap(m_keys, other.m_keys);
+                std::swap(m_values, other.m_values);
+                std::swap(m_capacity, other.m_capacity);
+                std::swap(m_size, other.m_size);
+                std::swap(m_growth_left, other.m_growth_left);
+                std::swap(m_hash, other.m_hash);
+                std::swap(m_equal, other.m_equal);
+            }
+            friend inline void swap(FlatTable& lhs, FlatTable& rhs) noexcept { lhs.swap(rhs); }
+
+            inline iterator begin() noexcept { return iterator{ this, next_full(0) }; }
+            inline iterator end() noexcept { return iterator{ this, m_capacity }; }
+            inline const_iterator begin() const noexcept { return const_iterator{ this, next_full(0) }; }
+            inline const_iterator end() const noexcept { return const_iterator{ this, m_capacity }; }
+            inline const_iterator cbegin() const noexcept { return begin(); }
+            inline const_iterator cend() const noexcept { return end(); }
+
+            inline size_t size() const noexcept { return m_size; }
+            inline bool empty() const noexcept { return m_size == 0; }
+            inline size_t capacity() const noexcept { return m_capacity; }
+            inline float load_factor() const noexcept { return m_capacity == 0 ? 0.0f : static_cast<float>(m_size) / static_cast<float>(m_capacity); }
+            static constexpr float max_load_factor() noexcept { return 0.875f; }
+            inline hasher hash_function() const { return m_hash; }
+            inline key_equal key_eq() const { return m_equal; }
+
+            // Room for n elements without rehashing
+            void reserve(size_t n)
+            {
+                size_t capacity = 16;
+                while (max_load(capacity) < n)
+                    capacity *= 2;
+                if (capacity > m_capacity)
+                    resize(capacity);
+            }
+
+            // Keeps the capacity
+            void clear() noexcept
+            {
+                destroy_all();
+                if (m_capacity != 0)
+                    std::memset(m_ctrl, static_cast<unsigned char>(ctrl_empty), m_capacity + Group::width);
+                m_size = 0;
+                m_growth_left = max_load(m_capacity);
+            }
+
+            inline iterator find(const Key& key) { return iterator{ this, found_or_end(key) }; }
+            inline const_iterator find(const Key& key) const { return const_iterator{ this, found_or_end(key) }; }
+            inline bool contains(const Key& key) const { return find_index(key, hash_of(key)) != npos; }
+            inline size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+            // Heterogeneous lookup (e.g. std::string keys by std::string_view) when Hash and KeyEqual are transparent
+            template<class K> requires is_transparent
+            inline iterator find(const K& key) { return iterator{ this, found_or_end(key) }; }
+            template<class K> requires is_transparent
+            inline const_iterator find(const K& key) const { return const_iterator{ this, found_or_end(key) }; }
+            template<class K> requires is_transparent
+            inline bool contains(const K& key) const { return find_index(key, hash_of(key)) != npos; }
+            template<class K> requires is_transparent
+            inline size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+
+            inline size_t erase(const Key& key)
+            {
+                size_t i = find_index(key, hash_of(key));
+                if (i == npos)
+                    return 0;
+                erase_at(i);
+                return 1;
+            }
+            template<class K> requires is_transparent
+            inline size_t erase(const K& key)
+            {
+                size_t i = find_index(key, hash_of(key));
+                if (i == npos)
+                    return 0;
+                erase_at(i);
+                return 1;
+            }
+            // Returns the iterator following the erased element
+            inline iterator erase(const_iterator position)
+            {
+                erase_at(position.m_index);
+                return iterator{ this, next_full(position.m_index + 1) };
+            }
+            inline iterator erase(iterator position) { return erase(const_iterator{ position }); }
+
+        protected:
+            inline iterator iterator_at(size_t i) noexcept { return iterator{ this, i }; }
+
+            template<class K>
+            inline uint64_t hash_of(const K& key) const
+            {
+                auto hash = static_cast<uint64_t>(m_hash(key));
+                // Hashers such as std::hash<int> (the identity) have neither high nor low bits to spare
+                if constexpr (requires { typename Hash::is_avalanching; })
+                    return hash;
+                else
+                    return fold_multiply(hash, 0x9e3779b97f4a7c15ull);
+            }
+
+            static constexpr size_t max_load(size_t capacity) noexcept { return capacity - capacity / 8; }
+            static constexpr int8_t h2(uint64_t hash) noexcept { return static_cast<int8_t>(hash & 0x7f); }
+
+            template<class K>
+            size_t find_index(const K& key, uint64_t hash) const
+            {
+                if (m_capacity == 0)
+                    return npos;
+                size_t mask = m_capacity - 1;
+                size_t offset = (hash >> 7) & mask;
+                // Triangular steps of whole groups visit every group of a power-of-two table
+                for (size_t step = Group::width;; step += Group::width)
+                {
+                    Group group{ m_ctrl + offset };
+                    for (auto match = group.match(h2(hash)); match; match.clear_lowest())
+                    {
+                        size_t i = (offset + match.lowest()) & mask;
+                        if (m_equal(m_keys[i], key)) [[likely]]
+                            return i;
+                    }
+                    if (group.match_empty()) [[likely]]
+                        return npos;
+                    offset = (offset + step) & mask;
+                }
+            }
+
+            template<class K>
+            inline size_t found_or_end(const K& key) const
+            {
+                size_t i = find_index(key, hash_of(key));
+                return i == npos ? m_capacity : i;
+            }
+
+            // First empty or deleted slot of hash's probe sequence
+            size_t find_free(uint64_t hash) const noexcept
+            {
+                size_t mask = m_capacity - 1;
+                size_t offset = (hash >> 7) & mask;
+                for (size_t step = Group::width;; step += Group::width)
+                {
+                    if (auto free = Group{ m_ctrl + offset }.match_free())
+                        return (offset + free.lowest()) & mask;
+                    offset = (offset + step) & mask;
+                }
+            }
+
+            // Claims a slot for a new element of the given hash; the caller constructs it (or calls abandon)
+            size_t prepare_insert(uint64_t hash)
+            {
+                size_t i = m_capacity != 0 ? find_free(hash) : 0;
+                // Reusing a deleted slot does not take from the growth budget
+                if (m_capacity == 0 || (m_growth_left == 0 && m_ctrl[i] == ctrl_empty))
+                {
+                    // Mostly tombstones: rehash in place; otherwise double
+                    resize(m_capacity == 0 ? 16 : (m_size + 1 > max_load(m_capacity) / 2 ? 2 * m_capacity : m_capacity));
+                    i = find_free(hash);
+                }
+                m_growth_left -= m_ctrl[i] == ctrl_empty;
+                set_ctrl(i, h2(hash));
+                ++m_size;
+                return i;
+            }
+
+            // Undoes prepare_insert when constructing the element threw
+            inline void abandon(size_t i) noexcept
+            {
+                --m_size;
+                set_ctrl(i, ctrl_deleted);
+            }
+
+            // Returns the slot holding a key equal to key and whether it had to be inserted
+            template<class K, class... Args>
+            std::pair<size_t, bool> find_or_construct(K&& key, Args&&... args)
+            {
+                uint64_t hash = hash_of(key);
+                size_t i = find_index(key, hash);
+                if (i != npos)
+                    return { i, false };
+                i = prepare_insert(hash);
+                try
+                {
+                    std::construct_at(m_keys + i, std::forward<K>(key));
+                }
+                catch (...)
+                {
+                    abandon(i);
+                    throw;
+                }
+                if constexpr (is_map)
+                {
+                    try
+                    {
+                        std::construct_at(m_values + i, std::forward<Args>(args)...);
+                    }
+                    catch (...)
+                    {
+                        std::destroy_at(m_keys + i);
+                        abandon(i);
+                        throw;
+                    }
+                }
+                return { i, true };
+            }
+
+            void erase_at(size_t i) noexcept
+            {
+                destroy(i);
+                --m_size;
+                // A slot with no full run of a whole group around it never stopped a probe, so it can become
+                // empty again; otherwise a probe may have passed it and it must stay a tombstone
+                size_t mask = m_capacity - 1;
+                auto empty_before = Group{ m_ctrl + ((i - Group::width) & mask) }.match_empty();
+                auto empty_after = Group{ m_ctrl + i }.match_empty();
+                bool reusable = empty_before && empty_after && empty_before.leading() + empty_after.trailing() < Group::width;
+                set_ctrl(i, reusable ? ctrl_empty : ctrl_deleted);
+                m_growth_left += reusable;
+            }
+
+            inline void set_ctrl(size_t i, int8_t ctrl) noexcept
+            {
+                m_ctrl[i] = ctrl;
+                if (i < Group::width)
+                    m_ctrl[m_capacity + i] = ctrl;
+            }
+
+            // First full slot at or after i, or the capacity
+            size_t next_full(size_t i) const noexcept
+            {
+                for (; i < m_capacity; i += Group::width)
+                    if (auto full = Group{ m_ctrl + i }.match_full())
+                    {
+                        // Matches past the capacity are the copies of the first group
+                        size_t j = i + full.lowest();
+                        return j < m_capacity ? j : m_capacity;
+                    }
+                return m_capacity;
+            }
+
+            inline void destroy(size_t i) noexcept
+            {
+                std::destroy_at(m_keys + i);
+                if constexpr (is_map)
+                    std::destroy_at(m_values + i);
+            }
+
+            void destroy_all() noexcept
+            {
+                if constexpr (!std::is_trivially_destructible_v<Key> || !std::is_trivially_destructible_v<Value>)
+                    for (size_t i = next_full(0); i < m_capacity; i = next_full(i + 1))
+                        destroy(i);
+            }
+
+            void allocate(size_t capacity)
+            {
+                m_ctrl = new int8_t[capacity + Group::width];
+                try
+                {
+                    m_keys = std::allocator<Key>{}.allocate(capacity);
+                    if constexpr (is_map)
+                        m_values = std::allocator<Value>{}.allocate(capacity);
+                }
+                catch (...)
+                {
+                    if (m_keys != nullptr)
+                        std::allocator<Key>{}.deallocate(m_keys, capacity);
+                    delete[] m_ctrl;
+                    m_ctrl = nullptr;
+                    m_keys = nullptr;
+                    throw;
+                }
+                std::memset(m_ctrl, static_cast<unsigned char>(ctrl_empty), capacity + Group::width);
+                m_capacity = capacity;
+                m_growth_left = max_load(capacity);
+            }
+
+            void deallocate() noexcept
+            {
+                if (m_capacity == 0)
+                    return;
+                delete[] m_ctrl;
+                std::allocator<Key>{}.deallocate(m_keys, m_capacity);
+                if constexpr (is_map)
+                    std::allocator<Value>{}.deallocate(m_values, m_capacity);
+                m_ctrl = nullptr;
+                m_keys = nullptr;
+                m_values = nullptr;
+                m_capacity = 0;
+            }
+
+            // Moves every element into a table of the given capacity (elements are assumed not to throw on move)
+            void resize(size_t capacity)
+            {
+                FlatTable fresh{};
+                fresh.m_hash = m_hash;
+                fresh.m_equal = m_equal;
+                fresh.allocate(capacity);
+                for (size_t i = next_full(0); i < m_capacity; i = next_full(i + 1))
+                {
+                    uint64_t hash = hash_of(m_keys[i]);
+                    size_t j = fresh.find_free(hash);
+                    fresh.set_ctrl(j, h2(hash));
+                    std::construct_at(fresh.m_keys + j, std::move(m_keys[i]));
+                    if constexpr (is_map)
+                        std::construct_at(fresh.m_values + j, std::move(m_values[i]));
+                    destroy(i);
+                }
+                fresh.m_size = m_size;
+                fresh.m_growth_left -= m_size;
+                m_size = 0;
+                deallocate();
+                swap(fresh);
+            }
+
+            int8_t* m_ctrl{ nullptr };
+            Key* m_keys{ nullptr };
+            Value* m_values{ nullptr };
+            size_t m_capacity{ 0 };
+            size_t m_size{ 0 };
+            size_t m_growth_left{ 0 };
+            [[no_unique_address]] Hash m_hash{};
+            [[no_unique_address]] KeyEqual m_equal{};
+        };
+    }
+
+    // Flat open-addressing hash set (Swiss-table style). Insertion may rehash, which invalidates iterators
+    // and references; erasure invalidates only the erased element.
+    template<class Key, class Hash = fast_hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class flat_set :public detail::FlatTable<Key, void, Hash, KeyEqual>
+    {
+        using Base = detail::FlatTable<Key, void, Hash, KeyEqual>;
+
+    public:
+        using value_type = Key;
+        using reference = const Key&;
+        using const_reference = const Key&;
+        using typename Base::iterator;
+        using typename Base::const_iterator;
+
+        using Base::Base;
+        flat_set(std::initializer_list<Key> keys) :Base{ keys.size() } { insert(keys.begin(), keys.end()); }
+
+        inline std::pair<iterator, bool> insert(const Key& key)
+        {
+            auto [i, inserted] = this->find_or_construct(key);
+            return { this->iterator_at(i), inserted };
+        }
+        inline std::pair<iterator, bool> insert(Key&& key)
+        {
+            auto [i, inserted] = this->find_or_construct(std::move(key));
+            return { this->iterator_at(i), inserted };
+        }
+        template<std::input_iterator It>
+        void insert(It first, It last)
+        {
+            for (; first != last; ++first)
+                insert(*first);
+        }
+        template<class... Args>
+        inline std::pair<iterator, bool> emplace(Args&&... args) { return insert(Key(std::forward<Args>(args)...)); }
+    };
+
+    // Flat open-addressing hash map (Swiss-table style) with keys and mapped values in separate arrays.
+    // Iterators yield std::pair<const Key&, T&> rather than a reference to a stored pair (as std::flat_map
+    // does), so bind elements with 'auto' or 'const auto&', e.g. for (auto [key, value] : map).
+    // Insertion may rehash, which invalidates iterators and references.
+    template<class Key, class T, class Hash = fast_hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class flat_map :public detail::FlatTable<Key, T, Hash, KeyEqual>
+    {
+        using Base = detail::FlatTable<Key, T, Hash, KeyEqual>;
+
+    public:
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using reference = std::pair<const Key&, T&>;
+        using const_reference = std::pair<const Key&, const T&>;
+        using typename Base::iterator;
+        using typename Base::const_iterator;
+
+        using Base::Base;
+        flat_map(std::initializer_list<value_type> values) :Base{ values.size() } { insert(values.begin(), values.end()); }
+
+        template<class... Args>
+        inline std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+        {
+            auto [i, inserted] = this->find_or_construct(key, std::forward<Args>(args)...);
+            return { this->iterator_at(i), inserted };
+        }
+        template<class... Args>
+        inline std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+        {
+            auto [i, inserted] = this->find_or_construct(std::move(key), std::forward<Args>(args)...);
+            return { this->iterator_at(i), inserted };
+        }
+
+        inline std::pair<iterator, bool> insert(const value_type& value) { return try_emplace(value.first, value.second); }
+        inline std::pair<iterator, bool> insert(value_type&& value) { return try_emplace(std::move(value.first), std::move(value.second)); }
+        template<std::input_iterator It>
+        void insert(It first, It last)
+        {
+            for (; first != last; ++first)
+            {
+                const auto& [key, value] = *first;
+                try_emplace(key, value);
+            }
+        }
+        template<class K, class V>
+        inline std::pair<iterator, bool> emplace(K&& key, V&& value) { return try_emplace(Key(std::forward<K>(key)), std::forward<V>(value)); }
+
+        template<class M>
+        std::pair<iterator, bool> insert_or_assign(const Key& key, M&& value)
+        {
+            auto result = try_emplace(key, std::forward<M>(value));
+            if (!result.second)
+                result.first->second = std::forward<M>(value);
+            return result;
+        }
+        template<class M>
+        std::pair<iterator, bool> insert_or_assign(Key&& key, M&& value)
+        {
+            auto result = try_emplace(std::move(key), std::forward<M>(value));
+            if (!result.second)
+                result.first->second = std::forward<M>(value);
+            return result;
+        }
+
+        // The slot is found (and the table possibly grown) before m_values is read
+        inline T& operator[](const Key& key)
+        {
+            size_t i = this->find_or_construct(key).first;
+            return this->m_values[i];
+        }
+        inline T& operator[](Key&& key)
+        {
+            size_t i = this->find_or_construct(std::move(key)).first;
+            return this->m_values[i];
+        }
+
+        T& at(const Key& key)
+        {
+            auto it = this->find(key);
+            if (it == this->end())
+                throw std::out_of_range{ "ERROR! Key not found in core::flat_map::at() method." };
+            return it->second;
+        }
+        const T& at(const Key& key) const
+        {
+            auto it = this->find(key);
+            if (it == this->end())
+                throw std::out_of_range{ "ERROR! Key not found in core::flat_map::at() method." };
+            return it->second;
+        }
+    };
+}
+)";
+
+        // memory.hpp content (bump arenas and size-class pools as std::pmr::memory_resource)
+        constexpr std::string_view memory_content = R"(
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <array>
+#include <bit>
+#include <limits>
+
+/**********************************************************************************************
+*
+*                   			    Memory Header
+*                   			-----------------------
+*    		This header provides allocation control through std::pmr.
+*    		It includes:
+*    		- A monotonic bump Arena whose whole contents are freed by one reset(),
+*    		  with ArenaScope to rewind it at the end of a request.
+*    		- A SizeClassPool recycling power-of-two blocks through intrusive free lists.
+*    		- Per-thread instances of both (memory::thread_arena(), memory::thread_pool_resource()).
+*    		All of them are std::pmr::memory_resource, so std::pmr containers, the pmr overloads
+*    		of stringformers.hpp and the pools of asyncops.hpp allocate from them.
+*
+*                   			Developed by: Pooria Yousefi
+*				   				Date: 2025-06-26
+*				   				License: MIT
+*
+**********************************************************************************************/
+
+namespace pooriayousefi::core
+{
+    namespace memory
+    {
+        // Monotonic arena: allocation bumps a pointer through chunks taken from the upstream resource, each
+        // chunk twice the size of the previous one; deallocate does nothing. reset() frees everything at once
+        // and keeps the largest chunk for reuse, so a steady workload stops touching upstream after warm-up;
+        // rewind() to a mark (ArenaScope) keeps the largest chunk it drops as a spare for the same reason.
+        // Not thread-safe; use one arena per thread (thread_arena()).
+        class Arena :public std::pmr::memory_resource
+        {
+        private:
+            struct Chunk
+            {
+                Chunk* previous;
+                size_t size;
+            };
+
+        public:
+            static constexpr inline size_t default_initial_size = 4096;
+            static constexpr inline size_t max_chunk_size = size_t{ 64 } << 20;
+            static constexpr inline size_t chunk_header_size = (sizeof(Chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+            // Rewind point of the arena, taken by mark() and restored by rewind()
+            struct Marker
+            {
+                Chunk* chunk;
+                std::byte* cursor;
+            };
+
+            explicit Arena(size_t initial_size = default_initial_size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+                :m_upstream{ upstream }, m_buffer{ nullptr }, m_buffer_size{ 0 }, m_chunks{ nullptr }, m_spare{ nullptr },
+                m_cursor{ nullptr }, m_end{ nullptr }, m_initial_size{ initial_size == 0 ? 1 : initial_size }, m_next_size{ m_initial_size } {}
+
+            // Allocates from buffer first (e.g. a stack array); the buffer is never returned to upstream
+            Arena(void* buffer, size_t size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+                :m_upstream{ upstream }, m_buffer{ static_cast<std::byte*>(buffer) }, m_buffer_size{ size }, m_chunks{ nullptr }, m_spare{ nullptr },
+                m_cursor{ m_buffer }, m_end{ m_buffer + size }, m_initial_size{ size == 0 ? default_initial_size : 2 * size }, m_next_size{ m_initial_size } {}
+
+            Arena(const Arena&) = delete;
+            Arena& operator=(const Arena&) = delete;
+            ~Arena() override { release(); }
+
+            // Frees everything allocated so far; the largest chunk is kept and allocation restarts at its beginning
+            inline void reset() noexcept
+            {
+                if (m_spare != nullptr)
+                {
+                    m_spare->previous = m_chunks;
+                    m_chunks = std::exchange(m_spare, nullptr);
+                }
+                if (m_chunks == nullptr)
+                {
+                    m_cursor = m_buffer;
+                    m_end = m_buffer + m_buffer_size;
+                    return;
+                }
+                // Chunks only grow, so the newest is the largest (a chunk sized for one big request may be larger still)
+                Chunk* largest = m_chunks;
+                for (Chunk* chunk = m_chunks->previous; chunk != nullptr; chunk = chunk->previous)
+                    if (chunk->size > largest->size)
+                        largest = chunk;
+                for (Chunk* chunk = m_chunks; chunk != nullptr;)
+                {
+                    Chunk* previous = chunk->previous;
+                    if (chunk != largest)
+                        m_upstream->deallocate(chunk, chunk->size, alignof(std::max_align_t));
+                    chunk = previous;
+                }
+                largest->previous = nullptr;
+                m_chunks = largest;
+                m_cursor = data_of(largest);
+                m_end = reinterpret_cast<std::byte*>(largest) + largest->size;
+            }
+
+            // Frees everything and returns every chunk to upstream
+            inline void release() noexcept
+            {
+                while (m_chunks != nullptr)
+                {
+                    Chunk* chunk = std::exchange(m_chunks, m_chunks->previous);
+                    m_upstream->deallocate(chunk, chunk->size, alignof(std::max_align_t));
+                }
+                if (m_spare != nullptr)
+                {
+                    m_upstream->deallocate(m_spare, m_spare->size, alignof(std::max_align_t));
+                    m_spare = nullptr;
+                }
+                m_cursor = m_buffer;
+                m_end = m_buffer + m_buffer_size;
+                m_next_size = m_initial_size;
+            }
+
+            constexpr Marker mark() const noexcept { return Marker{ m_chunks, m_cursor }; }
+
+            // Frees everything allocated since marker was taken; chunks added since then go back to upstream
+            inline void rewind(Marker marker) noexcept
+            {
+                while (m_chunks != marker.chunk)
+                {
+                    Chunk* chunk = std::exchange(m_chunks, m_chunks->previous);
+                    if (m_spare != nullptr && m_spare->size >= chunk->size)
+                        m_upstream->deallocate(chunk, chunk->size, alignof(std::max_align_t));
+                    else if (Chunk* smaller = std::exchange(m_spare, chunk); smaller != nullptr)
+                        m_upstream->deallocate(smaller, smaller->size, alignof(std::max_align_t));
+                }
+                m_cursor = marker.cursor;
+                m_end = m_chunks == nullptr ? m_buffer + m_buffer_size : reinterpret_cast<std::byte*>(m_chunks) + m_chunks->size;
+            }
+
+            // Bytes held from upstream (the initial buffer not included)
+            inline size_t capacity() const noexcept
+            {
+                size_t bytes = m_spare == nullptr ? 0 : m_spare->size;
+                for (Chunk* chunk = m_chunks; chunk != nullptr; chunk = chunk->previous)
+                    bytes += chunk->size;
+                return bytes;
+            }
+
+            inline std::pmr::memory_resource* upstream() const noexcept { return m_upstream; }
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                auto address = (reinterpret_cast<uintptr_t>(m_cursor) + alignment - 1) & ~(uintptr_t{ alignment } - 1);
+                // Written so that a zero-byte request on an empty arena still gets a chunk rather than a null pointer;
+                // a request so large that address + bytes wraps goes to allocate_from_new_chunk, which rejects it
+                if (address + bytes >= address && address + bytes - 1 < reinterpret_cast<uintptr_t>(m_end)) [[likely]]
+                {
+                    m_cursor = reinterpret_cast<std::byte*>(address + bytes);
+                    return reinterpret_cast<void*>(address);
+                }
+                return allocate_from_new_chunk(bytes, alignment);
+            }
+
+            void do_deallocate(void*, size_t, size_t) noexcept override {}
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        private:
+            static inline std::byte* data_of(Chunk* chunk) noexcept { return reinterpret_cast<std::byte*>(chunk) + chunk_header_size; }
+
+            void* allocate_from_new_chunk(size_t bytes, size_t alignment)
+            {
+                // Chunk sizes are powers of two, so no chunk can hold more than half the address space
+                if (bytes > (std::numeric_limits<size_t>::max() >> 1) - chunk_header_size - alignment)
+                    throw std::bad_alloc();
+                size_t needed = chunk_header_size + bytes + (alignment > alignof(std::max_align_t) ? alignment : 0);
+                Chunk* chunk = nullptr;
+                if (m_spare != nullptr && m_spare->size >= needed)
+                {
+                    chunk = std::exchange(m_spare, nullptr);
+                    chunk->previous = m_chunks;
+                }
+                else
+                {
+                    size_t size = m_next_size < needed ? std::bit_ceil(needed) : m_next_size;
+                    chunk = ::new (m_upstream->allocate(size, alignof(std::max_align_t))) Chunk{ m_chunks, size };
+                    m_next_size = size < max_chunk_size / 2 ? 2 * size : max_chunk_size;
+                }
+                m_chunks = chunk;
+                m_cursor = data_of(chunk);
+                m_end = reinterpret_cast<std::byte*>(chunk) + chunk->size;
+                return do_allocate(bytes, alignment);
+            }
+
+            std::pmr::memory_resource* m_upstream;
+            std::byte* m_buffer;
+            size_t m_buffer_size;
+            Chunk* m_chunks;
+            Chunk* m_spare;
+            std::byte* m_cursor;
+            std::byte* m_end;
+            size_t m_initial_size;
+            size_t m_next_size;
+        };
+
+        // Rewinds an arena to where it was when the scope was entered: per-request work is freed in one step
+        class ArenaScope
+        {
+        public:
+            explicit ArenaScope(Arena& arena) noexcept :m_arena{ &arena }, m_marker{ arena.mark() } {}
+            ArenaScope(const ArenaScope&) = delete;
+            ArenaScope& operator=(const ArenaScope&) = delete;
+            ~ArenaScope() { m_arena->rewind(m_marker); }
+
+            inline Arena& arena() const noexcept { return *m_arena; }
+
+        private:
+            Arena* m_arena;
+            Arena::Marker m_marker;
+        };
+
+        // Pool of power-of-two size classes from 8 to 4096 bytes: a freed block goes onto its class's intrusive
+        // free list and is handed out again by the next allocation of that class, so allocate/deallocate pairs
+        // are a few instructions. Blocks are carved from chunks of the upstream resource (which may be an Arena);
+        // larger or over-aligned requests go to upstream directly. Unlike std::pmr::unsynchronized_pool_resource
+        // the classes are fixed and lookup is a bit scan. Not thread-safe; use thread_pool_resource() per thread.
+        class SizeClassPool :public std::pmr::memory_resource
+        {
+        private:
+            struct FreeBlock
+            {
+                FreeBlock* next;
+            };
+
+            struct Chunk
+            {
+                Chunk* previous;
+                size_t size;
+            };
+
+        public:
+            static constexpr inline size_t min_block_size = 8;
+            static constexpr inline size_t max_block_size = 4096;
+            static constexpr inline size_t number_of_size_classes = 10;
+            static constexpr inline size_t chunk_size = 64 * 1024;
+
+            explicit SizeClassPool(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+                :m_upstream{ upstream }, m_free{}, m_chunks{ nullptr } {}
+            SizeClassPool(const SizeClassPool&) = delete;
+            SizeClassPool& operator=(const SizeClassPool&) = delete;
+            ~SizeClassPool() override { release(); }
+
+            // Returns every chunk to upstream; blocks still handed out become invalid
+            inline void release() noexcept
+            {
+                while (m_chunks != nullptr)
+                {
+                    Chunk* chunk = std::exchange(m_chunks, m_chunks->previous);
+                    m_upstream->deallocate(chunk, chunk->size, alignof(std::max_align_t));
+                }
+                m_free.fill(nullptr);
+            }
+
+            inline std::pmr::memory_resource* upstream() const noexcept { return m_upstream; }
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                if (bytes > max_block_size || alignment > alignof(std::max_align_t)) [[unlikely]]
+                    return m_upstream->allocate(bytes, alignment);
+                size_t size_class = size_class_of(bytes < alignment ? alignment : bytes);
+                if (m_free[size_class] == nullptr) [[unlikely]]
+                    refill(size_class);
+                FreeBlock* block = m_free[size_class];
+                m_free[size_class] = block->next;
+                return block;
+            }
+
+            void do_deallocate(void* ptr, size_t bytes, size_t alignment) noexcept override
+            {
+                if (bytes > max_block_size || alignment > alignof(std::max_align_t)) [[unlikely]]
+                    return m_upstream->deallocate(ptr, bytes, alignment);
+                size_t size_class = size_class_of(bytes < alignment ? alignment : bytes);
+                m_free[size_class] = ::new (ptr) FreeBlock{ m_free[size_class] };
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        private:
+            static constexpr size_t size_class_of(size_t bytes) noexcept
+            {
+                return bytes <= min_block_size ? 0 : static_cast<size_t>(std::bit_width(bytes - 1)) - 3;
+            }
+
+            // Carves a new chunk into blocks of size_class, threaded into its free list
+            void refill(size_t size_class)
+            {
+                constexpr size_t header = (sizeof(Chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+                size_t block_size = min_block_size << size_class;
+                auto* chunk = ::new (m_upstream->allocate(chunk_size, alignof(std::max_align_t))) Chunk{ m_chunks, chunk_size };
+                m_chunks = chunk;
+                std::byte* first = reinterpret_cast<std::byte*>(chunk) + header;
+                size_t count = (chunk_size - header) / block_size;
+                FreeBlock* head = m_free[size_class];
+                for (size_t i = count; i-- > 0;)
+                    head = ::new (first + i * block_size) FreeBlock{ head };
+                m_free[size_class] = head;
+            }
+
+            std::pmr::memory_resource* m_upstream;
+            std::array<FreeBlock*, number_of_size_classes> m_free;
+            Chunk* m_chunks;
+        };
+
+// GCC 12 importers of a module reference its thread_local variables as ordinary globals (the link fails),
+// so a module interface defines the per-thread accessors out of line and importers only call them
+#if defined(POORIAYOUSEFI_CORE_MODULE_INTERFACE)
+#define POORIAYOUSEFI_CORE_MEMORY_OUT_OF_LINE
+#else
+#define POORIAYOUSEFI_CORE_MEMORY_OUT_OF_LINE inline
+#endif
+
+        // This thread's arena, on the heap; everything it allocated is freed when the thread exits
+        POORIAYOUSEFI_CORE_MEMORY_OUT_OF_LINE Arena& thread_arena() noexcept
+        {
+            static thread_local Arena arena{ Arena::default_initial_size, std::pmr::new_delete_resource() };
+            return arena;
+        }
+
+        // This thread's size-class pool, on the heap; its blocks are freed when the thread exits
+        POORIAYOUSEFI_CORE_MEMORY_OUT_OF_LINE SizeClassPool& thread_pool_resource() noexcept
+        {
+            static thread_local SizeClassPool pool{ std::pmr::new_delete_resource() };
+            return pool;
+        }
+    }
+}
+)";
+
+        // stringformers.hpp content  
+        constexpr std::string_view stringformers_content = R"(
+#pragma once
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <ranges>
+#include <algorithm>
+#include <vector>
+#include <span>
+#include <iterator>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <unordered_set>
+#include <unordered_map>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <exception>
+#include <functional>
+#include <charconv>
+#include <limits>
+#include <system_error>
+#if !defined(POORIAYOUSEFI_CORE_MODULE_INTERFACE)
+#include "containers.hpp"
+#endif
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define POORIAYOUSEFI_CORE_SIMD_X86 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define POORIAYOUSEFI_CORE_SIMD_NEON 1
+#endif
+
+/**********************************************************************************************
+*
+*                   			String Transformers
+*                   			-------------------
+*    			This header provides utility functions for string manipulation,
+*    			including case conversion (ASCII SIMD fast path, in-place and
+*    			into caller buffers) and tokenization, plus lazy tokenizers
+*    			over in-memory views and over chunked (streamed) input, and a
+*    			SIMD DelimiterSet (AVX2/SSSE3/NEON, chosen at run time), parallel
+*    			word counting (count_words) and approximate top-k (heavy_hitters).
+*    			The tokenize overloads also fill core::flat_set / core::flat_map.
+*    			Numbers: parse<T> (SWAR/SSE2 8- and 16-digit integer kernels,
+*    			std::from_chars otherwise), format_to on std::to_chars into
+*    			reusable buffers, and parse_column for whole token columns.
+*
+*                   			Developed by: Pooria Yousefi
+*				   				Date: 2025-06-26
+*				   				License: MIT
+*
+**********************************************************************************************/
+
+// Run-time ISA dispatch needs target attributes and __builtin_cpu_supports, which GCC 12 cannot put in a
+// module interface; there the kernels are limited to the ISA the unit is compiled for (e.g. -mavx2)
+#if POORIAYOUSEFI_CORE_SIMD_X86
+#if defined(POORIAYOUSEFI_CORE_MODULE_INTERFACE) && defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 13
+#define POORIAYOUSEFI_CORE_SIMD_TARGET(isa)
+#if defined(__SSSE3__)
+#define POORIAYOUSEFI_CORE_SIMD_SSSE3 1
+#endif
+#if defined(__AVX2__)
+#define POORIAYOUSEFI_CORE_SIMD_AVX2 1
+#endif
+#define POORIAYOUSEFI_CORE_SIMD_CPU_SUPPORTS(isa) true
+#else
+#define POORIAYOUSEFI_CORE_SIMD_TARGET(isa) __attribute__((target(isa)))
+#define POORIAYOUSEFI_CORE_SIMD_SSSE3 1
+#define POORIAYOUSEFI_CORE_SIMD_AVX2 1
+#define POORIAYOUSEFI_CORE_SIMD_CPU_SUPPORTS(isa) __builtin_cpu_supports(isa)
+#endif
+#endif
+
+namespace pooriayousefi::core
+{
+    namespace detail
+    {
+        // ASCII case kernels over the 26 letters starting at 'first': scan_case reports which kinds of bytes
+        // occur, flip_case toggles bit 5 of every letter (dst may equal src)
+        enum : unsigned { case_has_letters = 1, case_has_non_ascii = 2 };
+
+        inline unsigned scan_case_scalar(const char* src, size_t size, char first) noexcept
+        {
+            unsigned flags = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                auto c = static_cast<unsigned char>(src[i]);
+                flags |= static_cast<unsigned char>(c - first) < 26 ? case_has_letters : 0u;
+                flags |= c >> 7 << 1;
+            }
+            return flags;
+        }
+
+        inline void flip_case_scalar(char* dst, const char* src, size_t size, char first) noexcept
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                auto c = static_cast<unsigned char>(src[i]);
+                dst[i] = static_cast<char>(c ^ ((static_cast<unsigned char>(c - first) < 26) << 5));
+            }
+        }
+
+#if POORIAYOUSEFI_CORE_SIMD_X86 && defined(__SSE2__)
+        // SSE2 has no unsigned byte compare: shift the letter range to [-128, -102) and compare signed
+        inline unsigned scan_case_sse2(const char* src, size_t size, char first) noexcept
+        {
+            const __m128i shift = _mm_set1_epi8(static_cast<char>(128 - first));
+            const __m128i limit = _mm_set1_epi8(-128 + 26);
+            __m128i letters = _mm_setzero_si128();
+            __m128i bytes = _mm_setzero_si128();
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                letters = _mm_or_si128(letters, _mm_cmpgt_epi8(limit, _mm_add_epi8(v, shift)));
+                bytes = _mm_or_si128(bytes, v);
+            }
+            unsigned flags = (_mm_movemask_epi8(letters) != 0 ? case_has_letters : 0u) | (_mm_movemask_epi8(bytes) != 0 ? case_has_non_ascii : 0u);
+            return flags | scan_case_scalar(src + i, size - i, first);
+        }
+
+        inline void flip_case_sse2(char* dst, const char* src, size_t size, char first) noexcept
+        {
+            const __m128i shift = _mm_set1_epi8(static_cast<char>(128 - first));
+            const __m128i limit = _mm_set1_epi8(-128 + 26);
+            const __m128i bit = _mm_set1_epi8(0x20);
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i letters = _mm_cmpgt_epi8(limit, _mm_add_epi8(v, shift));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(v, _mm_and_si128(letters, bit)));
+            }
+            flip_case_scalar(dst + i, src + i, size - i, first);
+        }
+#endif
+
+#if POORIAYOUSEFI_CORE_SIMD_X86 && POORIAYOUSEFI_CORE_SIMD_AVX2
+        POORIAYOUSEFI_CORE_SIMD_TARGET("avx2") inline unsigned scan_case_avx2(const char* src, size_t size, char first) noexcept
+        {
+            const __m256i shift = _mm256_set1_epi8(static_cast<char>(128 - first));
+            const __m256i limit = _mm256_set1_epi8(-128 + 26);
+            __m256i letters = _mm256_setzero_si256();
+            __m256i bytes = _mm256_setzero_si256();
+            size_t i = 0;
+            for (; i + 32 <= size; i += 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                letters = _mm256_or_si256(letters, _mm256_cmpgt_epi8(limit, _mm256_add_epi8(v, shift)));
+                bytes = _mm256_or_si256(bytes, v);
+            }
+            unsigned flags = (_mm256_movemask_epi8(letters) != 0 ? case_has_letters : 0u) | (_mm256_movemask_epi8(bytes) != 0 ? case_has_non_ascii : 0u);
+            return flags | scan_case_scalar(src + i, size - i, first);
+        }
+
+        POORIAYOUSEFI_CORE_SIMD_TARGET("avx2") inline void flip_case_avx2(char* dst, const char* src, size_t size, char first) noexcept
+        {
+            const __m256i shift = _mm256_set1_epi8(static_cast<char>(128 - first));
+            const __m256i limit = _mm256_set1_epi8(-128 + 26);
+            const __m256i bit = _mm256_set1_epi8(0x20);
+            size_t i = 0;
+            for (; i + 32 <= size; i += 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                __m256i letters = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(v, shift));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(v, _mm256_and_si256(letters, bit)));
+            }
+            flip_case_scalar(dst + i, src + i, size - i, first);
+        }
+#endif
+
+#if POORIAYOUSEFI_CORE_SIMD_NEON
+        inline unsigned scan_case_neon(const char* src, size_t size, char first) noexcept
+        {
+            const uint8x16_t base = vdupq_n_u8(static_cast<uint8_t>(first));
+            const uint8x16_t count = vdupq_n_u8(26);
+            uint8x16_t letters = vdupq_n_u8(0);
+            uint8x16_t bytes = vdupq_n_u8(0);
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+                letters = vorrq_u8(letters, vcltq_u8(vsubq_u8(v, base), count));
+                bytes = vorrq_u8(bytes, v);
+            }
+            unsigned flags = (vmaxvq_u8(letters) != 0 ? case_has_letters : 0u) | (vmaxvq_u8(bytes) >= 0x80 ? case_has_non_ascii : 0u);
+            return flags | scan_case_scalar(src + i, size - i, first);
+        }
+
+        inline void flip_case_neon(char* dst, const char* src, size_t size, char first) noexcept
+        {
+            const uint8x16_t base = vdupq_n_u8(static_cast<uint8_t>(first));
+            const uint8x16_t count = vdupq_n_u8(26);
+            const uint8x16_t bit = vdupq_n_u8(0x20);
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+                uint8x16_t letters = vcltq_u8(vsubq_u8(v, base), count);
+                vst1q_u8(reinterpret_cast<uint8_t*>(dst + i), veorq_u8(v, vandq_u8(letters, bit)));
+            }
+            flip_case_scalar(dst + i, src + i, size - i, first);
+        }
+#endif
+
+        inline unsigned scan_case(const char* src, size_t size, char first) noexcept
+        {
+#if POORIAYOUSEFI_CORE_SIMD_X86 && POORIAYOUSEFI_CORE_SIMD_AVX2
+            if (size >= 32 && POORIAYOUSEFI_CORE_SIMD_CPU_SUPPORTS("avx2"))
+                return scan_case_avx2(src, size, first);
+#endif
+#if POORIAYOUSEFI_CORE_SIMD_X86 && defined(__SSE2__)
+            return size >= 16 ? scan_case_sse2(src, size, first) : scan_case_scalar(src, size, first);
+#elif POORIAYOUSEFI_CORE_SIMD_NEON
+            return size >= 16 ? scan_case_neon(src, size, first) : scan_case_scalar(src, size, first);
+#else
+            return scan_case_scalar(src, size, first);
+#endif
+        }
+
+        inline void flip_case(char* dst, const char* src, size_t size, char first) noexcept
+        {
+#if POORIAYOUSEFI_CORE_SIMD_X86 && POORIAYOUSEFI_CORE_SIMD_AVX2
+            if (size >= 32 && POORIAYOUSEFI_CORE_SIMD_CPU_SUPPORTS("avx2"))
+                return flip_case_avx2(dst, src, size, first);
+#endif
+#if POORIAYOUSEFI_CORE_SIMD_X86 && defined(__SSE2__)
+            size >= 16 ? flip_case_sse2(dst, src, size, first) : flip_case_scalar(dst, src, size, first);
+#elif POORIAYOUSEFI_CORE_SIMD_NEON
+            size >= 16 ? flip_case_neon(dst, src, size, first) : flip_case_scalar(dst, src, size, first);
+#else
+            flip_case_scalar(dst, src, size, first);
+#endif
+        }
+
+        // Single-byte text that is pure ASCII takes the kernels (and is only copied if nothing needs to
+        // change); anything else goes through std::tolower / std::toupper, i.e. the current C locale
+        template<class Enc> void convert_case(Enc* dst, const Enc* src, size_t size, bool upper)
+        {
+            if constexpr (sizeof(Enc) == 1)
+            {
+                const char first = upper ? 'a' : 'A';
+                auto* d = reinterpret_cast<char*>(dst);
+                auto* s = reinterpret_cast<const char*>(src);
+#if POORIAYOUSEFI_CORE_SIMD_X86 && defined(__SSE2__)
+                // Short words (most tokens): one padded block, scanned and flipped in a single pass
+                if (size < 16)
+                {
+                    alignas(16) char block[16]{};
+                    std::memcpy(block, s, size);
+                    __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+                    if (_mm_movemask_epi8(v) == 0)
+                    {
+                        __m128i letters = _mm_cmpgt_epi8(_mm_set1_epi8(-128 + 26), _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(128 - first))));
+                        if (_mm_movemask_epi8(letters) == 0 && d == s)
+                            return;
+                        _mm_store_si128(reinterpret_cast<__m128i*>(block), _mm_xor_si128(v, _mm_and_si128(letters, _mm_set1_epi8(0x20))));
+                        std::memcpy(d, block, size);
+                        return;
+                    }
+                }
+#endif
+                unsigned flags = scan_case(s, size, first);
+                if ((flags & case_has_non_ascii) == 0)
+                {
+                    if (flags & case_has_letters)
+                        flip_case(d, s, size, first);
+                    else if (d != s)
+                        std::memcpy(d, s, size);
+                    return;
+                }
+                for (size_t i = 0; i < size; ++i)
+                {
+                    auto c = static_cast<unsigned char>(src[i]);
+                    dst[i] = static_cast<Enc>(upper ? std::toupper(c) : std::tolower(c));
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < size; ++i)
+                    dst[i] = static_cast<Enc>(upper ? std::toupper(src[i]) : std::tolower(src[i]));
+            }
+        }
+    }
+
+    template<class Enc, class EncTraits = std::char_traits<Enc>, class EncAlloc = std::allocator<Enc>>
+    constexpr decltype(auto) to_lowercase(const std::basic_string<Enc, EncTraits, EncAlloc>& word)
+    {
+        std::basic_string<Enc, EncTraits, EncAlloc> lowercased_word{};
+        lowercased_word.resize(std::ranges::size(word));
+        detail::convert_case(lowercased_word.data(), word.data(), word.size(), false);
+        return lowercased_word;
+    }
+    template<class Enc, class EncTraits = std::char_traits<Enc>, class EncAlloc = std::allocator<Enc>>
+    constexpr decltype(auto) to_lowercase(std::basic_string_view<Enc, EncTraits> word_view)
+    {
+        std::basic_string<Enc, EncTraits, EncAlloc> lowercased_word{};
+        lowercased_word.resize(std::ranges::size(word_view));
+        detail::convert_case(lowercased_word.data(), word_view.data(), word_view.size(), false);
+        return lowercased_word;
+    }
+    // Into a caller-owned string, reusing its capacity
+    template<class Enc, class EncTraits, class EncAlloc>
+    void to_lowercase(std::basic_string_view<Enc, EncTraits> word_view, std::basic_string<Enc, EncTraits, EncAlloc>& lowercased_word)
+    {
+        lowercased_word.resize(word_view.size());
+        detail::convert_case(lowercased_word.data(), word_view.data(), word_view.size(), false);
+    }
+    // Into a caller-provided buffer of at least word_view.size() elements; returns the converted view
+    template<class Enc, class EncTraits>
+    std::basic_string_view<Enc, EncTraits> to_lowercase(std::basic_string_view<Enc, EncTraits> word_view, std::type_identity_t<std::span<Enc>> buffer)
+    {
+        if (buffer.size() < word_view.size())
+            throw std::length_error("ERROR! Buffer too small in to_lowercase() function.");
+        detail::convert_case(buffer.data(), word_view.data(), word_view.size(), false);
+        return { buffer.data(), word_view.size() };
+    }
+    // Allocated with alloc, e.g. std::pmr::polymorphic_allocator<Enc>{ &arena } over a memory::Arena,
+    // so per-request results are freed by one reset
+    template<class Enc, class EncTraits, class EncAlloc>
+        requires requires(EncAlloc& a) { { a.allocate(size_t{ 1 }) } -> std::same_as<Enc*>; }
+    std::basic_string<Enc, EncTraits, EncAlloc> to_lowercase(std::basic_string_view<Enc, EncTraits> word_view, const EncAlloc& alloc)
+    {
+        std::basic_string<Enc, EncTraits, EncAlloc> lowercased_word{ alloc };
+        lowercased_word.resize(word_view.size());
+        detail::convert_case(lowercased_word.data(), word_view.data(), word_view.size(), false);
+        return lowercased_word;
+    }
+    template<class Enc, class EncTraits, class EncAlloc>
+    void to_lowercase_in_place(std::basic_string<Enc, EncTraits, EncAlloc>& word)
+    {
+        detail::convert_case(word.data(), word.data(), word.size(), false);
+    }
+    template<class Enc>
+    void to_lowercase_in_place(std::span<Enc> word)
+    {
+        detail::convert_case(word.data(), word.data(), word.size(), false);
+    }
+
+    template<class Enc, class EncTraits = std::char_traits<Enc>, class EncAlloc = std::allocator<Enc>>
+    constexpr decltype(auto) to_uppercase(const std::basic_string<Enc, EncTraits, EncAlloc>& word)
+    {
+        std::basic_string<Enc, EncTraits, EncAlloc> uppercased_word{};
+        uppercased_word.resize(std::ranges::size(word));
+        detail::convert_case(uppercased_word.data(), word.data(), word.size(), true);
+        return uppercased_word;
+    }
+    template<class Enc, class EncTraits = std::char_traits<Enc>, class EncAlloc = std::allocator<Enc>>
+    constexpr decltype(auto) to_uppercase(std::basic_string_view<Enc, EncTraits> word_view)
+    {
+        std::basic_string<Enc, EncTraits, EncAlloc> uppercased_word{};
+        uppercased_word.resize(std::ranges::size(word_view));
+        detail::convert_case(uppercased_word.data(), word_view.data(), word_view.size(), true);
+        return uppercased_word;
+    }
+    // Into a caller-owned string, reusing its capacity
+    template<class Enc, class EncTraits, class EncAlloc>
+    void to_uppercase(std::basic_string_view<Enc, EncTraits> word_view, std::basic_string<Enc, EncTraits, EncAlloc>& uppercased_word)
+    {
+        uppercased_word.resize(word_view.size());
+        detail::convert_case(uppercased_word.data(), word_view.data(), word_view.size(), true);
+    }
+    // Into a caller-provided buffer of at least word_view.size() elements; returns the converted view
+    template<class Enc, class EncTraits>
+    std::basic_string_view<Enc, EncTraits> to_uppercase(std::basic_string_view<Enc, EncTraits> word_view, std::type_identity_t<std::span<Enc>> buffer)
+    {
+        if (buffer.size() < word_view.size())
+            throw std::length_error("ERROR! Buffer too small in to_uppercase() function.");
+        detail::convert_case(buffer.data(), word_view.data(), word_view.size(), true);
+        return { buffer.data(), word_view.size() };
+    }
+    // Allocated with alloc, e.g. std::pmr::polymorphic_allocator<Enc>{ &arena } over a memory::Arena,
+    // so per-request results are freed by one reset
+    template<class Enc, class EncTraits, class EncAlloc>
+        requires requires(EncAlloc& a) { { a.allocate(size_t{ 1 }) } -> std::same_as<Enc*>; }
+    std::basic_string<Enc, EncTraits, EncAlloc> to_uppercase(std::basic_string_view<Enc, EncTraits> word_view, const EncAlloc& alloc)
+    {
+        std::basic_string<Enc, EncTraits, EncAlloc> uppercased_word{ alloc };
+        uppercased_word.resize(word_view.size());
+        detail::convert_case(uppercased_word.data(), word_view.data(), word_view.size(), true);
+        return uppercased_word;
+    }
+    template<class Enc, class EncTraits, class EncAlloc>
+    void to_uppercase_in_place(std::basic_string<Enc, EncTraits, EncAlloc>& word)
+    {
+        detail::convert_case(word.data(), word.data(), word.size(), true);
+    }
+    template<class Enc>
+    void to_uppercase_in_place(std::span<Enc> word)
+    {
+        detail::convert_case(word.data(), word.data(), word.size(), true);
+    }
+
+    // Byte delimiter set with vectorized scanning. The set is kept as a 256-bit table and as "shufti"
+    // nibble tables (a byte matches iff lo[b & 15] & hi[b >> 4] != 0), so every 64 input bytes become a
+    // 64-bit delimiter mask with a handful of shuffles. The ISA (AVX2, SSSE3, NEON or scalar) is picked
+    // at run time unless one is requested explicitly (e.g. to compare them in a benchmark).
+    class DelimiterSet
+    {
+    public:
+        enum class Isa { best, scalar, ssse3, avx2, neon };
+
+        explicit DelimiterSet(std::string_view delim, Isa isa = Isa::best) :m_table{}, m_lo{}, m_hi{}, m_two_passes{ false }, m_isa{ Isa::scalar }, m_mask{ &mask_scalar }
+        {
+            // One shufti bucket per distinct high nibble: up to 8 fit one table pair, up to 16 need both
+            std::array<int, 16> bucket{};
+            bucket.fill(-1);
+            int buckets = 0;
+            for (unsigned char c : delim)
+            {
+                m_table[c >> 6] |= uint64_t{ 1 } << (c & 63);
+                if (bucket[c >> 4] < 0)
+                    bucket[c >> 4] = buckets++;
+                int b = bucket[c >> 4];
+                m_lo[b / 8][c & 15] |= static_cast<uint8_t>(1u << (b % 8));
+                m_hi[b / 8][c >> 4] |= static_cast<uint8_t>(1u << (b % 8));
+            }
+            m_two_passes = buckets > 8;
+            select(isa == Isa::best ? best_isa() : isa);
+        }
+
+        inline bool contains(unsigned char c) const noexcept { return (m_table[c >> 6] >> (c & 63)) & 1; }
+        inline Isa isa() const noexcept { return m_isa; }
+
+        // Bit i set iff p[i] is a delimiter; bits at and beyond size (which may be < 64) are set as well
+        inline uint64_t mask(const char* p, size_t size) const noexcept
+        {
+            if (size >= 64)
+                return m_mask(*this, p);
+            alignas(64) char block[64]{};
+            std::memcpy(block, p, size);
+            return m_mask(*this, block) | (~uint64_t{ 0 } << size);
+        }
+
+        size_t find_first_of(std::string_view src, size_t pos = 0) const noexcept
+        {
+            for (; pos < src.size(); pos += 64)
+            {
+                uint64_t m = mask(src.data() + pos, src.size() - pos);
+                if (m != 0)
+                {
+                    size_t i = pos + static_cast<size_t>(std::countr_zero(m));
+                    return i < src.size() ? i : std::string_view::npos;
+                }
+            }
+            return std::string_view::npos;
+        }
+
+        size_t find_first_not_of(std::string_view src, size_t pos = 0) const noexcept
+        {
+            for (; pos < src.size(); pos += 64)
+            {
+                uint64_t m = ~mask(src.data() + pos, src.size() - pos);
+                if (m != 0)
+                    return pos + static_cast<size_t>(std::countr_zero(m));
+            }
+            return std::string_view::npos;
+        }
+
+        // Calls f(token) for every maximal run of non-delimiters, found from mask transitions 64 bytes at a time
+        template<class F> void for_each_token(std::string_view src, F&& f) const
+        {
+            size_t start = 0;
+            uint64_t in_token = 0;
+            for (size_t base = 0; base < src.size(); base += 64)
+            {
+                uint64_t delimiters = mask(src.data() + base, src.size() - base);
+                uint64_t previous = (~delimiters << 1) | in_token;
+                uint64_t starts = ~delimiters & ~previous;
+                uint64_t ends = delimiters & previous;
+                // Starts and ends alternate: an open token takes the first end, then each start takes the next one
+                if (in_token && ends != 0)
+                {
+                    f(src.substr(start, base + static_cast<size_t>(std::countr_zero(ends)) - start));
+                    ends &= ends - 1;
+                }
+                for (; starts != 0; starts &= starts - 1)
+                {
+                    start = base + static_cast<size_t>(std::countr_zero(starts));
+                    if (ends == 0)
+                        break;
+                    f(src.substr(start, base + static_cast<size_t>(std::countr_zero(ends)) - start));
+                    ends &= ends - 1;
+                }
+                in_token = ~delimiters >> 63;
+            }
+            if (in_token)
+                f(src.substr(start));
+        }
+
+    private:
+        using MaskFunction = uint64_t(*)(const DelimiterSet&, const char*) noexcept;
+
+        static uint64_t mask_scalar(const DelimiterSet& set, const char* p) noexcept
+        {
+            uint64_t m = 0;
+            for (size_t i = 0; i < 64; ++i)
+                m |= uint64_t{ set.contains(static_cast<unsigned char>(p[i])) } << i;
+            return m;
+        }
+
+#if POORIAYOUSEFI_CORE_SIMD_X86 && POORIAYOUSEFI_CORE_SIMD_SSSE3
+        POORIAYOUSEFI_CORE_SIMD_TARGET("ssse3") static uint64_t mask_ssse3(const DelimiterSet& set, const char* p) noexcept
+        {
+            const __m128i nibble = _mm_set1_epi8(0x0f);
+            uint64_t m = 0;
+            for (int k = 0; k < 4; ++k)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+                __m128i lo = _mm_and_si128(v, nibble);
+                __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+                __m128i hits = _mm_and_si128(_mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(set.m_lo[0].data())), lo),
+                    _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(set.m_hi[0].data())), hi));
+                if (set.m_two_passes)
+                    hits = _mm_or_si128(hits, _mm_and_si128(_mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(set.m_lo[1].data())), lo),
+                        _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(set.m_hi[1].data())), hi)));
+                uint64_t misses = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(hits, _mm_setzero_si128())));
+                m |= (~misses & 0xffff) << (16 * k);
+            }
+            return m;
+        }
+#endif
+
+#if POORIAYOUSEFI_CORE_SIMD_X86 && POORIAYOUSEFI_CORE_SIMD_AVX2
+        POORIAYOUSEFI_CORE_SIMD_TARGET("avx2") static uint64_t mask_avx2(const DelimiterSet& set, const char* p) noexcept
+        {
+            const __m256i nibble = _mm256_set1_epi8(0x0f);
+            const __m256i lo_table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.m_lo[0].data())));
+            const __m256i hi_table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.m_hi[0].data())));
+            uint64_t m = 0;
+            for (int k = 0; k < 2; ++k)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * k));
+                __m256i lo = _mm256_and_si256(v, nibble);
+                __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+                __m256i hits = _mm256_and_si256(_mm256_shuffle_epi8(lo_table, lo), _mm256_shuffle_epi8(hi_table, hi));
+                if (set.m_two_passes)
+                {
+                    const __m256i lo_table2 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.m_lo[1].data())));
+                    const __m256i hi_table2 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.m_hi[1].data())));
+                    hits = _mm256_or_si256(hits, _mm256_and_si256(_mm256_shuffle_epi8(lo_table2, lo), _mm256_shuffle_epi8(hi_table2, hi)));
+                }
+                uint64_t misses = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hits, _mm256_setzero_si256())));
+                m |= (~misses & 0xffffffff) << (32 * k);
+            }
+            return m;
+        }
+#endif
+
+#if POORIAYOUSEFI_CORE_SIMD_NEON
+        static uint64_t mask_neon(const DelimiterSet& set, const char* p) noexcept
+        {
+            const uint8x16_t nibble = vdupq_n_u8(0x0f);
+            const uint8x16_t weights = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+            uint64_t m = 0;
+            for (int k = 0; k < 4; ++k)
+            {
+                uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p + 16 * k));
+                uint8x16_t lo = vandq_u8(v, nibble);
+                uint8x16_t hi = vshrq_n_u8(v, 4);
+                uint8x16_t hits = vandq_u8(vqtbl1q_u8(vld1q_u8(set.m_lo[0].data()), lo), vqtbl1q_u8(vld1q_u8(set.m_hi[0].data()), hi));
+                if (set.m_two_passes)
+                    hits = vorrq_u8(hits, vandq_u8(vqtbl1q_u8(vld1q_u8(set.m_lo[1].data()), lo), vqtbl1q_u8(vld1q_u8(set.m_hi[1].data()), hi)));
+                uint8x16_t bits = vandq_u8(vtstq_u8(hits, hits), weights);
+                uint64_t half = uint64_t{ vaddv_u8(vget_low_u8(bits)) } | (uint64_t{ vaddv_u8(vget_high_u8(bits)) } << 8);
+                m |= half << (16 * k);
+            }
+            return m;
+        }
+#endif
+
+        static Isa best_isa() noexcept
+        {
+#if POORIAYOUSEFI_CORE_SIMD_X86 && POORIAYOUSEFI_CORE_SIMD_AVX2
+            if (POORIAYOUSEFI_CORE_SIMD_CPU_SUPPORTS("avx2"))
+                return Isa::avx2;
+#endif
+#if POORIAYOUSEFI_CORE_SIMD_X86 && POORIAYOUSEFI_CORE_SIMD_SSSE3
+            if (POORIAYOUSEFI_CORE_SIMD_CPU_SUPPORTS("ssse3"))
+                return Isa::ssse3;
+#endif
+#if POORIAYOUSEFI_CORE_SIMD_NEON
+            return Isa::neon;
+#endif
+            return Isa::scalar;
+        }
+
+        // An ISA this build or CPU cannot run falls back to scalar
+        void select([[maybe_unused]] Isa isa) noexcept
+        {
+            m_isa = Isa::scalar;
+            m_mask = &mask_scalar;
+#if POORIAYOUSEFI_CORE_SIMD_X86 && POORIAYOUSEFI_CORE_SIMD_AVX2
+            if (isa == Isa::avx2 && POORIAYOUSEFI_CORE_SIMD_CPU_SUPPORTS("avx2"))
+            {
+                m_isa = isa;
+                m_mask = &mask_avx2;
+            }
+#endif
+#if POORIAYOUSEFI_CORE_SIMD_X86 && POORIAYOUSEFI_CORE_SIMD_SSSE3
+            if (isa == Isa::ssse3 && POORIAYOUSEFI_CORE_SIMD_CPU_SUPPORTS("ssse3"))
+            {
+                m_isa = isa;
+                m_mask = &mask_ssse3;
+            }
+#endif
+#if POORIAYOUSEFI_CORE_SIMD_NEON
+            if (isa == Isa::neon)
+            {
+                m_isa = isa;
+                m_mask = &mask_neon;
+            }
+#endif
+        }
+
+        std::array<uint64_t, 4> m_table;
+        alignas(16) std::array<std::array<uint8_t, 16>, 2> m_lo;
+        alignas(16) std::array<std::array<uint8_t, 16>, 2> m_hi;
+        bool m_two_passes;
+        Isa m_isa;
+        MaskFunction m_mask;
+    };
+
+    namespace detail
+    {
+        // splitmix64 finalizer: spreads weak hashes (std::hash of integers is the identity) over all 64 bits
+        constexpr uint64_t mix_hash(uint64_t h) noexcept
+        {
+            h ^= h >> 30;
+            h *= 0xbf58476d1ce4e5b9ull;
+            h ^= h >> 27;
+            h *= 0x94d049bb133111ebull;
+            return h ^ (h >> 31);
+        }
+
+        // Shard of a mixed hash among n shards; uses the high bits, the tables index with the low ones
+        constexpr size_t shard_of(uint64_t mixed_hash, size_t n) noexcept
+        {
+            return static_cast<size_t>(((mixed_hash >> 32) * n) >> 32);
+        }
+
+        // Open-addressing (linear probing, load <= 1/2) key -> count table with cached mixed hashes
+        template<class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+        class CountTable
+        {
+        public:
+            struct Slot
+            {
+                uint64_t hash;
+                size_t count;
+                Key key;
+            };
+
+            static inline uint64_t hash_of(const Key& key)
+            {
+                if constexpr (requires { typename Hash::is_avalanching; })
+                    return static_cast<uint64_t>(Hash{}(key));
+                else
+                    return mix_hash(static_cast<uint64_t>(Hash{}(key)));
+            }
+
+            inline void add(uint64_t hash, const Key& key, size_t n = 1)
+            {
+                if (2 * (m_size + 1) > m_slots.size())
+                    grow();
+                for (size_t i = hash & m_mask;; i = (i + 1) & m_mask)
+                {
+                    Slot& slot = m_slots[i];
+                    if (slot.count == 0)
+                    {
+                        slot = Slot{ hash, n, key };
+                        ++m_size;
+                        return;
+                    }
+                    if (slot.hash == hash && KeyEqual{}(slot.key, key))
+                    {
+                        slot.count += n;
+                        return;
+                    }
+                }
+            }
+
+            inline size_t count(uint64_t hash, const Key& key) const
+            {
+                if (m_size == 0)
+                    return 0;
+                for (size_t i = hash & m_mask;; i = (i + 1) & m_mask)
+                {
+                    const Slot& slot = m_slots[i];
+                    if (slot.count == 0)
+                        return 0;
+                    if (slot.hash == hash && KeyEqual{}(slot.key, key))
+                        return slot.count;
+                }
+            }
+
+            // f(hash, key, count) for every entry
+            template<class F> void for_each(F&& f) const
+            {
+                for (const Slot& slot : m_slots)
+                    if (slot.count != 0)
+                        f(slot.hash, slot.key, slot.count);
+            }
+
+            // f(key, count) for every entry
+            template<class F> void for_each_count(F&& f) const
+            {
+                for (const Slot& slot : m_slots)
+                    if (slot.count != 0)
+                        f(slot.key, slot.count);
+            }
+
+            // Adds the counts of other (which must use the same hash)
+            void merge(const CountTable& other)
+            {
+                for (const Slot& slot : other.m_slots)
+                    if (slot.count != 0)
+                        add(slot.hash, slot.key, slot.count);
+            }
+
+            inline size_t size() const noexcept { return m_size; }
+
+        private:
+            void grow()
+            {
+                std::vector<Slot> old(std::max<size_t>(16, 2 * m_slots.size()), Slot{ 0, 0, Key{} });
+                old.swap(m_slots);
+                m_mask = m_slots.size() - 1;
+                m_size = 0;
+                for (const Slot& slot : old)
+                    if (slot.count != 0)
+                        add(slot.hash, slot.key, slot.count);
+            }
+
+            std::vector<Slot> m_slots{};
+            size_t m_size{ 0 };
+            size_t m_mask{ 0 };
+        };
+
+        // f of run_parallel, type-erased so that the threads are started by a non-template function
+        struct ParallelTask
+        {
+            void (*run)(void*, size_t);
+            void* f;
+        };
+
+        inline void run_parallel_tasks(size_t n, const ParallelTask& task)
+        {
+            std::vector<std::exception_ptr> errors(n);
+            auto guarded = [&](size_t i) { try { task.run(task.f, i); } catch (...) { errors[i] = std::current_exception(); } };
+            std::vector<std::thread> threads{};
+            threads.reserve(n - 1);
+            for (size_t i = 0; i + 1 < n; ++i)
+                threads.emplace_back(guarded, i);
+            guarded(n - 1);
+            for (auto& thread : threads)
+                thread.join();
+            for (auto& error : errors)
+                if (error)
+                    std::rethrow_exception(error);
+        }
+
+        // Runs f(0) ... f(n - 1) on n threads (the caller runs the last) and rethrows the first exception.
+        // GCC 12 cannot emit debug information (-g) in importers of a module whose templates instantiate
+        // std::thread with their own closure types, hence the indirection through run_parallel_tasks.
+        template<class F> void run_parallel(size_t n, F&& f)
+        {
+            using Function = std::remove_reference_t<F>;
+            run_parallel_tasks(n, ParallelTask{ [](void* p, size_t i) { (*static_cast<Function*>(p))(i); },
+                const_cast<void*>(static_cast<const void*>(std::addressof(f))) });
+        }
+
+        // Default parallelism: one worker per 'grain' units of input, at most one per hardware thread
+        inline size_t default_workers(size_t size, size_t grain) noexcept
+        {
+            size_t hardware = std::max<size_t>(1, std::thread::hardware_concurrency());
+            return std::clamp<size_t>(size / grain, 1, hardware);
+        }
+
+        // Counts keys into one worker's shard tables (see parallel_count)
+        template<class Key, class Hash, class KeyEqual>
+        struct ShardCounter
+        {
+            using Table = CountTable<Key, Hash, KeyEqual>;
+
+            std::vector<Table>& shards;
+
+            inline void operator()(const Key& key) const
+            {
+                uint64_t hash = Table::hash_of(key);
+                shards[shard_of(hash, shards.size())].add(hash, key);
+            }
+        };
+
+        // The two phases of parallel_count. They are classes rather than lambdas because GCC 12 cannot emit debug
+        // information (-g) in importers of a module that instantiates templates with the closure types of other
+        // templates (parallel_count is instantiated inside pooriayousefi.core.stringformers by count_words).
+        template<class Key, class Hash, class KeyEqual, class CountSlice>
+        struct CountPhase
+        {
+            std::vector<std::vector<CountTable<Key, Hash, KeyEqual>>>& local;
+            CountSlice& count_slice;
+
+            inline void operator()(size_t w) const
+            {
+                ShardCounter<Key, Hash, KeyEqual> add{ local[w] };
+                count_slice(w, add);
+            }
+        };
+
+        template<class Key, class Hash, class KeyEqual>
+        struct MergePhase
+        {
+            std::vector<std::vector<CountTable<Key, Hash, KeyEqual>>>& local;
+            std::vector<CountTable<Key, Hash, KeyEqual>>& merged;
+
+            inline void operator()(size_t s) const
+            {
+                for (auto& shards : local)
+                {
+                    merged[s].merge(shards[s]);
+                    shards[s] = CountTable<Key, Hash, KeyEqual>{};
+                }
+            }
+        };
+
+        // Counts keys over 'workers' slices in parallel. count_slice(w, add) calls add(key) for every key of
+        // slice w, add being a ShardCounter&; each worker counts into one table per shard, so merging shard s
+        // of every worker is independent of the other shards and runs in parallel too. Returns one table per shard.
+        template<class Key, class Hash, class KeyEqual, class CountSlice>
+        std::vector<CountTable<Key, Hash, KeyEqual>> parallel_count(size_t workers, CountSlice&& count_slice)
+        {
+            using Table = CountTable<Key, Hash, KeyEqual>;
+            std::vector<std::vector<Table>> local(workers, std::vector<Table>(workers));
+            run_parallel(workers, CountPhase<Key, Hash, KeyEqual, std::remove_reference_t<CountSlice>>{ local, count_slice });
+            if (workers == 1)
+                return std::move(local.front());
+            std::vector<Table> merged(workers);
+            run_parallel(workers, MergePhase<Key, Hash, KeyEqual>{ local, merged });
+            return merged;
+        }
+
+        // Cuts src into n slices that start and end on delimiters, so no token is split
+        inline std::vector<size_t> split_on_delimiters(std::string_view src, const DelimiterSet& delim, size_t n)
+        {
+            std::vector<size_t> bounds(n + 1, src.size());
+            bounds[0] = 0;
+            for (size_t i = 1; i < n; ++i)
+            {
+                size_t p = std::max(bounds[i - 1], i * (src.size() / n));
+                while (p < src.size() && !delim.contains(static_cast<unsigned char>(src[p])))
+                    ++p;
+                bounds[i] = p;
+            }
+            return bounds;
+        }
+
+        // Word tables hash with fast_hash (see containers.hpp), which needs no further mixing
+        using WordTable = CountTable<std::string_view, fast_hash<std::string_view>>;
+        using WordCounter = ShardCounter<std::string_view, fast_hash<std::string_view>, std::equal_to<std::string_view>>;
+
+        // Space-Saving summary with a fixed number of counters: a min-heap by count plus an open-addressing
+        // index (backward-shift deletion) from word to heap position. A new word evicts the minimum.
+        class SpaceSaving
+        {
+        public:
+            struct Counter
+            {
+                std::string_view word;
+                size_t count;
+                size_t error;
+                uint64_t hash;
+                size_t slot;
+            };
+
+            explicit SpaceSaving(size_t capacity)
+                :m_capacity{ std::max<size_t>(capacity, 1) }, m_heap{}, m_index(std::bit_ceil(2 * m_capacity), 0), m_mask{ m_index.size() - 1 }
+            {
+                m_heap.reserve(m_capacity);
+            }
+
+            void add(std::string_view word)
+            {
+                uint64_t hash = WordTable::hash_of(word);
+                size_t i = hash & m_mask;
+                for (; m_index[i] != 0; i = (i + 1) & m_mask)
+                {
+                    Counter& counter = m_heap[m_index[i] - 1];
+                    if (counter.hash == hash && counter.word == word)
+                    {
+                        ++counter.count;
+                        sift_down(m_index[i] - 1);
+                        return;
+                    }
+                }
+                if (m_heap.size() < m_capacity)
+                {
+                    m_heap.push_back(Counter{ word, 1, 0, hash, i });
+                    m_index[i] = m_heap.size();
+                    sift_up(m_heap.size() - 1);
+                    return;
+                }
+                erase_slot(m_heap.front().slot);
+                // The evictee's slot may have moved i; find the new word's slot again
+                for (i = hash & m_mask; m_index[i] != 0; i = (i + 1) & m_mask) {}
+                Counter& minimum = m_heap.front();
+                minimum = Counter{ word, minimum.count + 1, minimum.count, hash, i };
+                m_index[i] = 1;
+                sift_down(0);
+            }
+
+            inline const std::vector<Counter>& counters() const noexcept { return m_heap; }
+            inline bool full() const noexcept { return m_heap.size() == m_capacity; }
+            inline size_t minimum() const noexcept { return full() ? m_heap.front().count : 0; }
+
+        private:
+            void place(size_t position)
+            {
+                m_index[m_heap[position].slot] = position + 1;
+            }
+
+            void sift_up(size_t position)
+            {
+                while (position != 0)
+                {
+                    size_t parent = (position - 1) / 2;
+                    if (m_heap[parent].count <= m_heap[position].count)
+                        break;
+                    std::swap(m_heap[parent], m_heap[position]);
+                    place(parent);
+                    place(position);
+                    position = parent;
+                }
+            }
+
+            void sift_down(size_t position)
+            {
+                while (true)
+                {
+                    size_t smallest = position;
+                    for (size_t child = 2 * position + 1; child <= 2 * position + 2 && child < m_heap.size(); ++child)
+                        if (m_heap[child].count < m_heap[smallest].count)
+                            smallest = child;
+                    if (smallest == position)
+                        return;
+                    std::swap(m_heap[smallest], m_heap[position]);
+                    place(smallest);
+                    place(position);
+                    position = smallest;
+                }
+            }
+
+            // Linear-probing deletion without tombstones: shift later members of the cluster back
+            void erase_slot(size_t hole)
+            {
+                m_index[hole] = 0;
+                for (size_t i = (hole + 1) & m_mask; m_index[i] != 0; i = (i + 1) & m_mask)
+                {
+                    Counter& counter = m_heap[m_index[i] - 1];
+                    size_t home = counter.hash & m_mask;
+                    // Move it into the hole unless its home lies cyclically in (hole, i]
+                    if (((i - home) & m_mask) >= ((i - hole) & m_mask))
+                    {
+                        m_index[hole] = m_index[i];
+                        m_index[i] = 0;
+                        counter.slot = hole;
+                        hole = i;
+                    }
+                }
+            }
+
+            size_t m_capacity;
+            std::vector<Counter> m_heap;
+            std::vector<size_t> m_index;
+            size_t m_mask;
+        };
+    }
+
+    // Result of count_words: word counts held in hash shards (views point into the counted text)
+    class WordCounts
+    {
+    public:
+        using Table = detail::WordTable;
+
+        WordCounts() = default;
+        explicit WordCounts(std::vector<Table> shards) :m_shards{ std::move(shards) } {}
+
+        // Number of distinct words
+        inline size_t size() const noexcept
+        {
+            size_t n = 0;
+            for (const auto& shard : m_shards)
+                n += shard.size();
+            return n;
+        }
+
+        inline size_t operator[](std::string_view word) const
+        {
+            if (m_shards.empty())
+                return 0;
+            uint64_t hash = Table::hash_of(word);
+            return m_shards[detail::shard_of(hash, m_shards.size())].count(hash, word);
+        }
+
+        // f(word, count) for every distinct word, in no particular order
+        template<class F> void for_each(F&& f) const
+        {
+            for (const auto& shard : m_shards)
+                shard.for_each_count(f);
+        }
+
+        // The k most frequent words, most frequent first (ties in no particular order)
+        std::vector<std::pair<std::string_view, size_t>> most_common(size_t k) const
+        {
+            std::vector<std::pair<std::string_view, size_t>> words{};
+            words.reserve(size());
+            for_each([&](std::string_view word, size_t count) { words.emplace_back(word, count); });
+            auto by_count = [](const std::pair<std::string_view, size_t>& lhs, const std::pair<std::string_view, size_t>& rhs) { return lhs.second > rhs.second; };
+            k = std::min(k, words.size());
+            std::partial_sort(words.begin(), words.begin() + static_cast<ptrdiff_t>(k), words.end(), by_count);
+            words.resize(k);
+            return words;
+        }
+
+    private:
+        std::vector<Table> m_shards{};
+    };
+
+    // Word-frequency count of src in parallel: the text is cut into one slice per thread on delimiter
+    // boundaries, every thread counts its slice into per-shard flat tables, and shards are then merged
+    // in parallel. threads = 0 picks one thread per MiB, up to the hardware concurrency.
+    inline WordCounts count_words(std::string_view src, const DelimiterSet& delim, size_t threads = 0)
+    {
+        size_t workers = threads != 0 ? threads : detail::default_workers(src.size(), size_t{ 1 } << 20);
+        auto bounds = detail::split_on_delimiters(src, delim, workers);
+        return WordCounts{ detail::parallel_count<std::string_view, fast_hash<std::string_view>, std::equal_to<std::string_view>>(workers,
+            [&](size_t w, detail::WordCounter& add) { delim.for_each_token(src.substr(bounds[w], bounds[w + 1] - bounds[w]), add); }) };
+    }
+
+    // An approximate heavy hitter: the true count lies in [count - error, count]
+    struct HeavyHitter
+    {
+        std::string_view word;
+        size_t count;
+        size_t error;
+    };
+
+    // Approximate top-k words in memory bounded by 'capacity' counters per thread (default max(16k, 4096)), whatever
+    // the vocabulary size (Space-Saving; per-thread summaries are merged). Any word occurring more than
+    // total / capacity times in every slice is guaranteed to be found. Most frequent first.
+    inline std::vector<HeavyHitter> heavy_hitters(std::string_view src, const DelimiterSet& delim, size_t k, size_t capacity = 0, size_t threads = 0)
+    {
+        capacity = capacity != 0 ? std::max(capacity, k) : std::max<size_t>(16 * k, 4096);
+        size_t workers = threads != 0 ? threads : detail::default_workers(src.size(), size_t{ 1 } << 20);
+        auto bounds = detail::split_on_delimiters(src, delim, workers);
+        std::vector<detail::SpaceSaving> summaries(workers, detail::SpaceSaving{ capacity });
+        detail::run_parallel(workers, [&](size_t w)
+        {
+            delim.for_each_token(src.substr(bounds[w], bounds[w + 1] - bounds[w]), [&](std::string_view word) { summaries[w].add(word); });
+        });
+        // A word missing from a full summary may still have occurred up to that summary's minimum times there
+        struct Merged
+        {
+            size_t count;
+            size_t error;
+            size_t covered_minimum;
+        };
+        flat_map<std::string_view, Merged> merged{};
+        size_t total_minimum = 0;
+        for (const auto& summary : summaries)
+        {
+            total_minimum += summary.minimum();
+            for (const auto& counter : summary.counters())
+            {
+                auto& entry = merged[counter.word];
+                entry.count += counter.count;
+                entry.error += counter.error;
+                entry.covered_minimum += summary.minimum();
+            }
+        }
+        std::vector<HeavyHitter> hitters{};
+        hitters.reserve(merged.size());
+        for (const auto& [word, entry] : merged)
+        {
+            size_t missing = total_minimum - entry.covered_minimum;
+            hitters.push_back(HeavyHitter{ word, entry.count + missing, entry.error + missing });
+        }
+        k = std::min(k, hitters.size());
+        std::partial_sort(hitters.begin(), hitters.begin() + static_cast<ptrdiff_t>(k), hitters.end(),
+            [](const HeavyHitter& lhs, const HeavyHitter& rhs) { return lhs.count > rhs.count; });
+        hitters.resize(k);
+        return hitters;
+    }
+
+    // Vectorized counterparts of the tokenize overloads below (which remain the generic path). The containers
+    // may use any allocator: std::pmr ones over a memory::Arena give per-request tokenizing without heap traffic.
+    template<class Alloc>
+    void tokenize(std::string_view src, const DelimiterSet& delim, std::vector<std::string_view, Alloc>& tokens)
+    {
+        tokens.clear();
+        delim.for_each_token(src, [&](std::string_view token) { tokens.emplace_back(token); });
+    }
+    template<class Hash, class KeyEqual, class Alloc>
+    void tokenize(std::string_view src, const DelimiterSet& delim, std::unordered_set<std::string_view, Hash, KeyEqual, Alloc>& tokens)
+    {
+        tokens.clear();
+        delim.for_each_token(src, [&](std::string_view token) { tokens.emplace(token); });
+    }
+    // Counted in parallel with count_words; tokens only receives the distinct words
+    template<class Hash, class KeyEqual, class Alloc>
+    void tokenize(std::string_view src, const DelimiterSet& delim, std::unordered_map<std::string_view, size_t, Hash, KeyEqual, Alloc>& tokens, size_t threads = 0)
+    {
+        tokens.clear();
+        auto counts = count_words(src, delim, threads);
+        tokens.reserve(counts.size());
+        counts.for_each([&](std::string_view word, size_t count) { tokens.emplace(word, count); });
+    }
+    template<class Hash, class KeyEqual>
+    void tokenize(std::string_view src, const DelimiterSet& delim, flat_set<std::string_view, Hash, KeyEqual>& tokens)
+    {
+        tokens.clear();
+        delim.for_each_token(src, [&](std::string_view token) { tokens.insert(token); });
+    }
+    template<class Hash, class KeyEqual>
+    void tokenize(std::string_view src, const DelimiterSet& delim, flat_map<std::string_view, size_t, Hash, KeyEqual>& tokens, size_t threads = 0)
+    {
+        tokens.clear();
+        auto counts = count_words(src, delim, threads);
+        tokens.reserve(counts.size());
+        counts.for_each([&](std::string_view word, size_t count) { tokens.try_emplace(word, count); });
+    }
+
+    template<class T, class Traits = std::char_traits<T>, class Alloc = std::allocator<std::basic_string_view<T, Traits>>>
+    constexpr void tokenize(
+        std::basic_string_view<T, Traits> src, 
+        std::basic_string_view<T, Traits> delim,
+        std::vector<std::basic_string_view<T, Traits>, Alloc>& tokens
+    )
+    {
+        tokens.clear();
+
+        auto last_pos = src.find_first_not_of(delim, 0);
+        auto pos = src.find_first_of(delim, last_pos);
+
+        while (pos != std::basic_string_view<T, Traits>::npos || last_pos != std::basic_string_view<T, Traits>::npos)
+        {
+            tokens.emplace_back(src.substr(last_pos, pos - last_pos));
+            last_pos = src.find_first_not_of(delim, pos);
+            pos = src.find_first_of(delim, last_pos);
+        }
+    }
+    template<class T, class Traits, class Hash, class KeyEqual, class Alloc>
+	constexpr void tokenize(
+        std::basic_string_view<T, Traits> src, 
+        std::basic_string_view<T, Traits> delim,
+        std::unordered_set<std::basic_string_view<T, Traits>, Hash, KeyEqual, Alloc>& tokens
+    )
+	{
+        tokens.clear();
+
+        auto last_pos = src.find_first_not_of(delim, 0);
+        auto pos = src.find_first_of(delim, last_pos);
+
+		while (pos != std::basic_string_view<T, Traits>::npos || last_pos != std::basic_string_view<T, Traits>::npos)
+		{
+			tokens.emplace(src.substr(last_pos, pos - last_pos));
+			last_pos = src.find_first_not_of(delim, pos);
+			pos = src.find_first_of(delim, last_pos);
+		}
+	}
+	template<class T, class Traits, class Hash, class KeyEqual, class Alloc>
+	auto tokenize(
+        std::basic_string_view<T, Traits> src, 
+        std::basic_string_view<T, Traits> delim,
+        std::unordered_map<std::basic_string_view<T, Traits>, size_t, Hash, KeyEqual, Alloc>& tokens
+    )
+	{
+        // Narrow text takes the parallel, vectorized count
+        if constexpr (std::is_same_v<T, char> && std::is_same_v<Traits, std::char_traits<char>>)
+        {
+            tokenize(src, DelimiterSet{ delim }, tokens);
+            return;
+        }
+        tokens.clear();
+
+		auto last_pos = src.find_first_not_of(delim, 0);
+		auto pos = src.find_first_of(delim, last_pos);
+
+		while (pos != std::basic_string_view<T, Traits>::npos || last_pos != std::basic_string_view<T, Traits>::npos)
+		{
+			tokens[src.substr(last_pos, pos - last_pos)]++;
+			last_pos = src.find_first_not_of(delim, pos);
+			pos = src.find_first_of(delim, last_pos);
+		}
+	}
+
+    // Lazy tokenizer over an in-memory view (e.g. raii::MappedFile::view()): tokens are found on demand
+    // and returned as views into src, so nothing is allocated however large the input is
+    template<class T, class Traits = std::char_traits<T>>
+    class TokenView :public std::ranges::view_interface<TokenView<T, Traits>>
+    {
+    public:
+        using string_view_type = std::basic_string_view<T, Traits>;
+
+        class Iterator
+        {
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = string_view_type;
+            using difference_type = ptrdiff_t;
+            using reference = string_view_type;
+
+            Iterator() noexcept :m_src{}, m_delim{}, m_begin{ string_view_type::npos }, m_end{ string_view_type::npos } {}
+            Iterator(string_view_type src, string_view_type delim) noexcept
+                :m_src{ src }, m_delim{ delim }, m_begin{ src.find_first_not_of(delim) }, m_end{ src.find_first_of(delim, m_begin) } {}
+
+            inline string_view_type operator*() const noexcept { return m_src.substr(m_begin, m_end - m_begin); }
+            inline Iterator& operator++() noexcept
+            {
+                m_begin = m_src.find_first_not_of(m_delim, m_end);
+                m_end = m_src.find_first_of(m_delim, m_begin);
+                return *this;
+            }
+            inline Iterator operator++(int) noexcept { auto previous = *this; ++*this; return previous; }
+            inline bool operator==(const Iterator& other) const noexcept { return m_begin == other.m_begin; }
+            inline bool operator==(std::default_sentinel_t) const noexcept { return m_begin == string_view_type::npos; }
+
+        private:
+            string_view_type m_src;
+            string_view_type m_delim;
+            size_t m_begin;
+            size_t m_end;
+        };
+
+        TokenView() = default;
+        TokenView(string_view_type src, string_view_type delim) noexcept :m_src{ src }, m_delim{ delim } {}
+
+        inline Iterator begin() const noexcept { return Iterator{ m_src, m_delim }; }
+        inline std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    private:
+        string_view_type m_src{};
+        string_view_type m_delim{};
+    };
+
+    template<class T, class Traits = std::char_traits<T>>
+    constexpr TokenView<T, Traits> token_view(std::basic_string_view<T, Traits> src, std::basic_string_view<T, Traits> delim) noexcept
+    {
+        return TokenView<T, Traits>{ src, delim };
+    }
+
+    // tokenize into the flat containers of containers.hpp; narrow text takes the DelimiterSet overloads
+    template<class T, class Traits, class Hash, class KeyEqual>
+    void tokenize(
+        std::basic_string_view<T, Traits> src,
+        std::basic_string_view<T, Traits> delim,
+        flat_set<std::basic_string_view<T, Traits>, Hash, KeyEqual>& tokens
+    )
+    {
+        if constexpr (std::is_same_v<T, char> && std::is_same_v<Traits, std::char_traits<char>>)
+        {
+            tokenize(src, DelimiterSet{ delim }, tokens);
+        }
+        else
+        {
+            tokens.clear();
+            for (auto token : token_view(src, delim))
+                tokens.insert(token);
+        }
+    }
+    template<class T, class Traits, class Hash, class KeyEqual>
+    void tokenize(
+        std::basic_string_view<T, Traits> src,
+        std::basic_string_view<T, Traits> delim,
+        flat_map<std::basic_string_view<T, Traits>, size_t, Hash, KeyEqual>& tokens
+    )
+    {
+        if constexpr (std::is_same_v<T, char> && std::is_same_v<Traits, std::char_traits<char>>)
+        {
+            tokenize(src, DelimiterSet{ delim }, tokens);
+        }
+        else
+        {
+            tokens.clear();
+            for (auto token : token_view(src, delim))
+                tokens[token]++;
+        }
+    }
+
+    // Anything a StreamingTokenizer can pull chunks from: an object with read_into(std::span<T>)
+    // (e.g. raii::BasicInputFileStreamWrapper<char>) or a callable size_t(std::span<T>); 0 means end of input
+    template<class S, class T>
+    concept ChunkSource = requires(S& source, std::span<T> chunk) { { source.read_into(chunk) } -> std::convertible_to<size_t>; }
+        || std::is_invocable_r_v<size_t, S&, std::span<T>>;
+
+    // Tokenizer over input that arrives in chunks. Memory is bounded by the chunk size (or the longest
+    // token, if that is larger): a token cut by a chunk boundary is moved to the front of the buffer and
+    // completed by the next chunk. Single pass; each token view stays valid until the iterator advances.
+    // Source may be a reference type, in which case the source is borrowed rather than stored.
+    template<class Source, class T, class Traits = std::char_traits<T>>
+        requires ChunkSource<std::remove_reference_t<Source>, T>
+    class StreamingTokenizer
+    {
+    public:
+        using string_view_type = std::basic_string_view<T, Traits>;
+        static constexpr inline size_t default_chunk_size = 1 << 16;
+
+        class Iterator
+        {
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = string_view_type;
+            using difference_type = ptrdiff_t;
+            using reference = string_view_type;
+
+            Iterator() noexcept :m_parent{ nullptr }, m_token{} {}
+            explicit Iterator(StreamingTokenizer* parent) :m_parent{ parent }, m_token{} { ++*this; }
+
+            inline string_view_type operator*() const noexcept { return m_token; }
+            inline Iterator& operator++()
+            {
+                if (!m_parent->next(m_token))
+                    m_parent = nullptr;
+                return *this;
+            }
+            inline void operator++(int) { ++*this; }
+            inline bool operator==(std::default_sentinel_t) const noexcept { return m_parent == nullptr; }
+
+        private:
+            StreamingTokenizer* m_parent;
+            string_view_type m_token;
+        };
+
+        template<class S>
+        StreamingTokenizer(S&& source, string_view_type delim, size_t chunk_size = default_chunk_size)
+            :m_source{ std::forward<S>(source) }, m_delim{ delim }, m_buffer(std::max<size_t>(chunk_size, 1)), m_begin{ 0 }, m_size{ 0 }, m_eof{ false } {}
+        StreamingTokenizer(const StreamingTokenizer&) = delete;
+        StreamingTokenizer& operator=(const StreamingTokenizer&) = delete;
+
+        inline Iterator begin() { return Iterator{ this }; }
+        inline std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+        // Current buffer size: the chunk size unless a longer token forced it to grow
+        inline size_t buffer_size() const noexcept { return m_buffer.size(); }
+
+    private:
+        bool next(string_view_type& token)
+        {
+            while (true)
+            {
+                string_view_type data{ m_buffer.data() + m_begin, m_size - m_begin };
+                auto first = data.find_first_not_of(m_delim);
+                if (first == string_view_type::npos)
+                {
+                    m_begin = m_size;
+                    if (!refill())
+                        return false;
+                    continue;
+                }
+                auto last = data.find_first_of(m_delim, first);
+                if (last != string_view_type::npos)
+                {
+                    token = data.substr(first, last - first);
+                    m_begin += last;
+                    return true;
+                }
+                // The token runs to the end of the buffered data: finish it with the next chunk
+                if (m_eof)
+                {
+                    token = data.substr(first);
+                    m_begin = m_size;
+                    return true;
+                }
+                m_begin += first;
+                refill();
+            }
+        }
+
+        // Keeps the unconsumed tail, appends the next chunk; returns false once the source is exhausted
+        bool refill()
+        {
+            if (m_eof)
+                return false;
+            size_t kept = m_size - m_begin;
+            if (kept != 0 && m_begin != 0)
+                Traits::move(m_buffer.data(), m_buffer.data() + m_begin, kept);
+            m_begin = 0;
+            m_size = kept;
+            if (m_size == m_buffer.size())
+                m_buffer.resize(2 * m_buffer.size());
+            std::span<T> chunk{ m_buffer.data() + m_size, m_buffer.size() - m_size };
+            size_t n;
+            if constexpr (requires { m_source.read_into(chunk); })
+                n = static_cast<size_t>(m_source.read_into(chunk));
+            else
+                n = static_cast<size_t>(m_source(chunk));
+            m_size += n;
+            if (n == 0)
+                m_eof = true;
+            return n != 0;
+        }
+
+        Source m_source;
+        string_view_type m_delim;
+        std::vector<T> m_buffer;
+        size_t m_begin;
+        size_t m_size;
+        bool m_eof;
+    };
+
+    // for (auto token : tokenize_stream(reader, delim)) ...; an lvalue source is borrowed, an rvalue one is moved in
+    template<class Source, class T, class Traits = std::char_traits<T>>
+    StreamingTokenizer<Source, T, Traits> tokenize_stream(
+        Source&& source,
+        std::basic_string_view<T, Traits> delim,
+        size_t chunk_size = StreamingTokenizer<Source, T, Traits>::default_chunk_size
+    )
+    {
+        return StreamingTokenizer<Source, T, Traits>{ std::forward<Source>(source), delim, chunk_size };
+    }
+
+    namespace detail
+    {
+        // Eight ASCII digits from p as one little-endian word (first character in the low byte)
+        inline uint64_t load_eight_chars(const char* p) noexcept
+        {
+            uint64_t chars;
+            std::memcpy(&chars, p, sizeof(chars));
+            if constexpr (std::endian::native == std::endian::big)
+                chars = std::byteswap(chars);
+            return chars;
+        }
+
+        // Four to eight characters as one word from two overlapping four-byte loads, zero bytes after them
+        inline uint64_t load_short_chars(const char* p, size_t size) noexcept
+        {
+            uint32_t head, tail;
+            std::memcpy(&head, p, sizeof(head));
+            std::memcpy(&tail, p + size - 4, sizeof(tail));
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                head = std::byteswap(head);
+                tail = std::byteswap(tail);
+            }
+            return uint64_t{ head } | (uint64_t{ tail } << (8 * (size - 4)));
+        }
+
+        // SWAR: every byte is in '0'..'9' (adding 6 carries a byte past '9' into the high nibble)
+        constexpr bool is_eight_digits(uint64_t chars) noexcept
+        {
+            return ((chars & 0xF0F0F0F0F0F0F0F0) | (((chars + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+        }
+
+        // SWAR: eight digits to their value in three multiplications, pairs then quads then the whole word
+        constexpr uint32_t parse_eight_digits(uint64_t chars) noexcept
+        {
+            constexpr uint64_t mask = 0x000000FF000000FF;
+            constexpr uint64_t mul1 = 100 + (uint64_t{ 1000000 } << 32);
+            constexpr uint64_t mul2 = 1 + (uint64_t{ 10000 } << 32);
+            chars -= 0x3030303030303030;
+            chars = chars * 10 + (chars >> 8);
+            return static_cast<uint32_t>((((chars & mask) * mul1) + (((chars >> 16) & mask) * mul2)) >> 32);
+        }
+
+        // SWAR: how many leading bytes of chars are digits (8 if all are); a byte past the first non-digit may be
+        // misjudged by a carry, which does not matter here
+        constexpr unsigned digit_run_length(uint64_t chars) noexcept
+        {
+            uint64_t offsets = chars ^ 0x3030303030303030;
+            uint64_t non_digits = ((offsets + 0x7676767676767676) | offsets) & 0x8080808080808080;
+            return static_cast<unsigned>(std::countr_zero(non_digits)) / 8;
+        }
+
+        // Value of the first count (1 to 8) digits of chars: they are shifted to the end of the word behind '0's
+        constexpr uint32_t parse_leading_digits(uint64_t chars, unsigned count) noexcept
+        {
+            unsigned shift = 8 * (8 - count);
+            return parse_eight_digits(count == 8 ? chars : (chars << shift) | (0x3030303030303030 >> (64 - shift)));
+        }
+
+        inline constexpr uint64_t powers_of_ten[9] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+
+        // Sixteen digits at p into value; false, leaving value alone, if any of the sixteen is not a digit
+        inline bool parse_sixteen_digits(const char* p, uint64_t& value) noexcept
+        {
+#if POORIAYOUSEFI_CORE_SIMD_X86 && defined(__SSE2__)
+            // SSE2 only (x86-64 baseline): 16 digits -> 8 pairs -> 4 quads -> 2 eight-digit halves
+            __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+            __m128i nine = _mm_set1_epi8(9);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(digits, nine), nine)) != 0xFFFF)
+                return false;
+            __m128i tens = _mm_mullo_epi16(_mm_and_si128(digits, _mm_set1_epi16(0x00FF)), _mm_set1_epi16(10));
+            __m128i pairs = _mm_add_epi16(tens, _mm_srli_epi16(digits, 8));
+            __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(100 | (1 << 16)));
+            __m128i halves = _mm_madd_epi16(_mm_packs_epi32(quads, quads), _mm_set1_epi32(10000 | (1 << 16)));
+            auto high = static_cast<uint32_t>(_mm_cvtsi128_si32(halves));
+            auto low = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(halves, 4)));
+            value = uint64_t{ high } * 100000000 + low;
+            return true;
+#else
+            uint64_t high = load_eight_chars(p);
+            uint64_t low = load_eight_chars(p + 8);
+            if (!is_eight_digits(high) || !is_eight_digits(low))
+                return false;
+            value = uint64_t{ parse_eight_digits(high) } * 100000000 + parse_eight_digits(low);
+            return true;
+#endif
+        }
+
+        // signed char and unsigned char stay numbers (int8_t, uint8_t), as for std::from_chars
+        template<class T>
+        concept CharacterType = std::same_as<T, char> || std::same_as<T, wchar_t> || std::same_as<T, char8_t>
+            || std::same_as<T, char16_t> || std::same_as<T, char32_t>;
+
+        // Same grammar and results as std::from_chars (base 10, '-' only for signed types): up to 19 digits are
+        // accumulated 16 and 8 at a time, longer inputs (leading zeros, out-of-range values) go to std::from_chars
+        template<std::integral T>
+        std::from_chars_result parse_integer(const char* first, const char* last, T& value) noexcept
+        {
+            const char* p = first;
+            bool negative = false;
+            if constexpr (std::is_signed_v<T>)
+            {
+                if (p != last && *p == '-')
+                {
+                    negative = true;
+                    ++p;
+                }
+            }
+            const char* digits = p;
+            uint64_t magnitude = 0;
+            auto size = static_cast<size_t>(last - p);
+            if (size >= 16 && parse_sixteen_digits(p, magnitude))
+            {
+                p += 16;
+            }
+            else if (size >= 8)
+            {
+                // Digit runs are measured rather than walked, so the length of a number costs no mispredicted branches
+                // up to 16 digits; fewer than 16 characters are covered by a second load overlapping the first
+                uint64_t head = load_eight_chars(p);
+                unsigned run = digit_run_length(head);
+                if (run == 0)
+                    return { first, std::errc::invalid_argument };
+                magnitude = parse_leading_digits(head, run);
+                p += run;
+                if (run == 8 && size > 8)
+                {
+                    uint64_t tail = size >= 16 ? load_eight_chars(p) : load_eight_chars(last - 8) >> (8 * (16 - size));
+                    run = digit_run_length(tail);
+                    if (run != 0)
+                    {
+                        magnitude = magnitude * powers_of_ten[run] + parse_leading_digits(tail, run);
+                        p += run;
+                    }
+                }
+            }
+            else if (size >= 4)
+            {
+                unsigned run = digit_run_length(load_short_chars(p, size));
+                if (run == 0)
+                    return { first, std::errc::invalid_argument };
+                magnitude = parse_leading_digits(load_short_chars(p, size), run);
+                p += run;
+            }
+            while (p != last && static_cast<unsigned char>(*p - '0') < 10 && p - digits < 19)
+                magnitude = magnitude * 10 + static_cast<unsigned char>(*p++ - '0');
+            if (p == digits)
+                return { first, std::errc::invalid_argument };
+            if (p != last && static_cast<unsigned char>(*p - '0') < 10) [[unlikely]]
+                return std::from_chars(first, last, value);
+
+            using Unsigned = std::make_unsigned_t<T>;
+            constexpr auto max = uint64_t{ static_cast<Unsigned>(std::numeric_limits<T>::max()) };
+            if (magnitude > max + (negative ? 1 : 0))
+                return { p, std::errc::result_out_of_range };
+            value = negative ? static_cast<T>(Unsigned{} - static_cast<Unsigned>(magnitude)) : static_cast<T>(magnitude);
+            return { p, std::errc{} };
+        }
+
+        [[noreturn]] inline void throw_parse_error(std::errc error, const char* function, size_t index = static_cast<size_t>(-1))
+        {
+            // Built in a fixed buffer, without std::string, so that module importers can instantiate the callers
+            char message[128];
+            char* end = message;
+            auto append = [&](const char* text) { size_t n = std::strlen(text); std::memcpy(end, text, n); end += n; };
+            append("ERROR! ");
+            if (index != static_cast<size_t>(-1))
+            {
+                append("Token ");
+                end = std::to_chars(end, end + 20, index).ptr;
+                append(error == std::errc::result_out_of_range ? " is out of range" : " is not a number");
+            }
+            else
+            {
+                append(error == std::errc::result_out_of_range ? "Number out of range" : "Not a number");
+            }
+            append(" in ");
+            append(function);
+            append("() function.");
+            *end = '\0';
+            if (error == std::errc::result_out_of_range)
+                throw std::out_of_range(message);
+            throw std::invalid_argument(message);
+        }
+    }
+
+    template<class T>
+    concept Number = (std::integral<T> && !std::same_as<T, bool> && !detail::CharacterType<T>) || std::floating_point<T>;
+
+    // Non-throwing parse of the number at the start of text, with std::from_chars semantics: on success ec is
+    // std::errc{} and ptr points past the number; integers take the 16/8-digit SIMD kernels, floating-point
+    // values std::from_chars (shortest round trip, no locale)
+    template<Number T>
+    std::from_chars_result parse(std::string_view text, T& value) noexcept
+    {
+        if constexpr (std::integral<T>)
+            return detail::parse_integer(text.data(), text.data() + text.size(), value);
+        else
+            return std::from_chars(text.data(), text.data() + text.size(), value);
+    }
+
+    // The whole of text as a T; throws std::invalid_argument (not a number, trailing characters) or std::out_of_range
+    template<Number T>
+    T parse(std::string_view text)
+    {
+        T value{};
+        auto [ptr, error] = parse(text, value);
+        if (error == std::errc{} && ptr != text.data() + text.size())
+            error = std::errc::invalid_argument;
+        if (error != std::errc{})
+            detail::throw_parse_error(error, "parse");
+        return value;
+    }
+
+    namespace detail
+    {
+        template<class T>
+        constexpr size_t max_chars_of() noexcept
+        {
+            if constexpr (std::integral<T>)
+            {
+                return size_t{ std::numeric_limits<T>::digits10 + 1 + (std::is_signed_v<T> ? 1 : 0) };
+            }
+            else
+            {
+                size_t exponent_digits = 0;
+                for (auto e = std::numeric_limits<T>::max_exponent10; e != 0; e /= 10)
+                    ++exponent_digits;
+                // sign, digits, point, 'e', exponent sign, exponent
+                return size_t{ 4 } + std::numeric_limits<T>::max_digits10 + exponent_digits;
+            }
+        }
+    }
+
+    // Characters the shortest (round-trip) representation of any T can take, e.g. the size of a stack buffer for format_to
+    template<Number T>
+    inline constexpr size_t max_chars = detail::max_chars_of<T>();
+
+    // Shortest representation of value into buffer (std::to_chars, no locale); returns the written characters
+    template<Number T>
+    std::string_view format_to(std::span<char> buffer, T value)
+    {
+        auto [ptr, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        if (error != std::errc{})
+            throw std::length_error("ERROR! Buffer too small in format_to() function.");
+        return { buffer.data(), static_cast<size_t>(ptr - buffer.data()) };
+    }
+    // With a format and precision (as printf %e / %f / %g with that precision)
+    template<std::floating_point T>
+    std::string_view format_to(std::span<char> buffer, T value, std::chars_format format, int precision)
+    {
+        auto [ptr, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, format, precision);
+        if (error != std::errc{})
+            throw std::length_error("ERROR! Buffer too small in format_to() function.");
+        return { buffer.data(), static_cast<size_t>(ptr - buffer.data()) };
+    }
+    // Appended to a reusable string (clear() it between records to keep its capacity); returns the appended characters
+    template<Number T, class Traits, class Alloc>
+    std::string_view format_to(std::basic_string<char, Traits, Alloc>& buffer, T value)
+    {
+        size_t size = buffer.size();
+        buffer.resize(size + max_chars<T>);
+        auto ptr = std::to_chars(buffer.data() + size, buffer.data() + buffer.size(), value).ptr;
+        buffer.resize(static_cast<size_t>(ptr - buffer.data()));
+        return { buffer.data() + size, buffer.size() - size };
+    }
+    template<std::floating_point T, class Traits, class Alloc>
+    std::string_view format_to(std::basic_string<char, Traits, Alloc>& buffer, T value, std::chars_format format, int precision)
+    {
+        size_t size = buffer.size();
+        // Fixed notation of a large value may need more than this first guess
+        for (size_t room = max_chars<T> + static_cast<size_t>(precision < 0 ? 0 : precision);; room *= 2)
+        {
+            buffer.resize(size + room);
+            auto [ptr, error] = std::to_chars(buffer.data() + size, buffer.data() + buffer.size(), value, format, precision);
+            if (error == std::errc{})
+            {
+                buffer.resize(static_cast<size_t>(ptr - buffer.data()));
+                return { buffer.data() + size, buffer.size() - size };
+            }
+        }
+    }
+
+    namespace detail
+    {
+        // One worker's contiguous block of parse_column; throws at the block's first bad token, so the first
+        // exception rethrown by run_parallel is the one of the first bad token overall
+        template<class T>
+        struct ParseColumnBlock
+        {
+            const std::string_view* tokens;
+            T* column;
+            size_t size;
+            size_t workers;
+
+            void operator()(size_t worker) const
+            {
+                size_t begin = size * worker / workers;
+                size_t end = size * (worker + 1) / workers;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    auto [ptr, error] = parse(tokens[i], column[i]);
+                    if (error == std::errc{} && ptr != tokens[i].data() + tokens[i].size())
+                        error = std::errc::invalid_argument;
+                    if (error != std::errc{}) [[unlikely]]
+                        throw_parse_error(error, "parse_column", i);
+                }
+            }
+        };
+    }
+
+    // Parses every token (e.g. from tokenize) into a typed column resized to tokens.size(); long columns are split
+    // across threads (0: one per 64k tokens, at most one per hardware thread). Throws std::invalid_argument or
+    // std::out_of_range naming the first token that is not entirely a T.
+    template<Number T, class Alloc>
+    void parse_column(std::span<const std::string_view> tokens, std::vector<T, Alloc>& column, size_t threads = 0)
+    {
+        column.resize(tokens.size());
+        if (tokens.empty())
+            return;
+        size_t workers = threads != 0 ? threads : detail::default_workers(tokens.size(), size_t{ 1 } << 16);
+        workers = workers < tokens.size() ? workers : tokens.size();
+        detail::ParseColumnBlock<T> block{ tokens.data(), column.data(), tokens.size(), workers };
+        if (workers == 1)
+            block(0);
+        else
+            detail::run_parallel(workers, block);
+    }
+}
+)";
+
+        // utilities.hpp content (waits, timers, iteration, counting, sampling and Result)
+        constexpr std::string_view utilities_content = R"(
+#pragma once
+#include <concepts>
+#include <type_traits>
+#include <thread>
+#include <ratio>
+#include <utility>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+#include <algorithm>
+#include <ranges>
+#include <iterator>
+#include <unordered_map>
+#include <string_view>
+#include <random>
+#include <variant>
+#include <iostream>
+#include <string>
+#include <coroutine>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <latch>
+#include <numeric>
+#include <stdexcept>
+#include <exception>
+#if !defined(POORIAYOUSEFI_CORE_MODULE_INTERFACE)
+#include "stringformers.hpp"
+#endif
+
+/**********************************************************************************************
+*
+*                   			    Utilities Header
+*                   			-----------------------
+*    		This header provides general utility functions and classes.
+*    		It includes:
+*    		- A wait_for class template for sleeping for various time durations, optionally
+*    		  precise (sleep, then spin against a calibrated TSC deadline), and wait_until.
+*    		- A precise namespace with the hybrid sleep_until / sleep_for, its calibration
+*    		  and a drift-free Ticker for fixed-rate loops.
+*    		- A Timer whose sleep_for / sleep_until awaitables resume coroutines on a ThreadPool
+*    		  (or any executor with enqueue).
+*    		- A runtime function template for measuring the execution time of a callable.
+*    		- A convert namespace with functions for unit conversions and number base conversions.
+*    		- A countdown function template for displaying a countdown in seconds.
+*    		- An iterate function template for iterating over a range with a specified step size,
+*    		  serially, under an execution policy or on a ThreadPool, with optional prefetching.
+*    		- Specializations of standard functors for std::byte and std::reference_wrapper
+*    		  (see containers.hpp for flat_set / flat_map and fast_hash).
+*    		- A histogram function template for counting occurrences of elements in a range (in parallel).
+*    		- frequencies / top_frequencies functions for (parallel) word frequencies of a string view.
+*    		- A do_n_times_shuffle_and_sample function template for shuffling and sampling a range
+*    		  n times in parallel (reproducible CounterRng streams, Floyd sampling), sample_histogram
+*    		  and the reproducible shuffle, uniform_index and sample_indices it is built on.
+*    		- A Result struct template for encapsulating expected values or exceptions,
+*    		  and try_invoke, which captures what a callable returns or throws.
+*
+*                   			Developed by: Pooria Yousefi
+*				   				Date: 2025-06-26
+*				   				License: MIT
+*
+**********************************************************************************************/
+
+namespace pooriayousefi::core
+{
+    template<typename T> concept Arithmetic = std::floating_point<T> || std::integral<T>;
+
+    // Hybrid waiting: the kernel sleeps through the bulk of a wait and the last stretch spins against the TSC,
+    // so a wait ends within a fraction of a microsecond of its deadline instead of overshooting by 50-100 µs
+    namespace precise
+    {
+        // Time-stamp counter (cntvct on AArch64, steady_clock nanoseconds elsewhere)
+        inline uint64_t ticks() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+            uint64_t value;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+            return value;
+#else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        // Spin-loop hint (pause / yield) that lets a sibling hyper-thread run and saves power while spinning
+        inline void cpu_relax() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#else
+            std::this_thread::yield();
+#endif
+        }
+
+        struct Calibration
+        {
+            // TSC rate against steady_clock
+            double ticks_per_ns;
+            // How long before a deadline sleeping stops and spinning starts: the worst sleep overshoot observed
+            std::chrono::nanoseconds slack;
+        };
+
+        // Times short sleeps for about duration: their overshoot gives the slack, the elapsed ticks the TSC rate
+        inline Calibration calibrate(std::chrono::nanoseconds duration = std::chrono::milliseconds{ 10 })
+        {
+            using clock = std::chrono::steady_clock;
+            constexpr std::chrono::microseconds probe{ 50 };
+            auto start = clock::now();
+            uint64_t start_ticks = ticks();
+            clock::duration overshoot{ 0 };
+            for (auto now = start; now - start < duration; )
+            {
+                std::this_thread::sleep_for(probe);
+                auto woken = clock::now();
+                overshoot = std::max(overshoot, woken - now - std::chrono::duration_cast<clock::duration>(probe));
+                now = woken;
+            }
+            uint64_t elapsed_ticks = ticks() - start_ticks;
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+            // A quarter more than the worst case covers the odd late wake-up; spinning longer only costs CPU
+            auto slack = std::chrono::duration_cast<std::chrono::nanoseconds>(overshoot) * 5 / 4;
+            return Calibration{
+                static_cast<double>(elapsed_ticks) / static_cast<double>(elapsed.count()),
+                std::clamp(slack, std::chrono::nanoseconds{ std::chrono::microseconds{ 20 } }, std::chrono::nanoseconds{ std::chrono::milliseconds{ 2 } })
+            };
+        }
+
+        // Calibrated once per process, on first use
+        inline const Calibration& calibration()
+        {
+            static const Calibration c = calibrate();
+            return c;
+        }
+
+        // Absolute deadlines keep periodic loops from drifting: sleep until slack before, then spin on the TSC
+        template<class Clock, class Duration>
+        inline void sleep_until(const std::chrono::time_point<Clock, Duration>& deadline)
+        {
+            const Calibration& c = calibration();
+            auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - Clock::now());
+            if (remaining.count() <= 0)
+                return;
+            uint64_t deadline_ticks = ticks() + static_cast<uint64_t>(static_cast<double>(remaining.count()) * c.ticks_per_ns);
+            if (remaining > c.slack)
+                std::this_thread::sleep_for(remaining - c.slack);
+            while (static_cast<int64_t>(ticks() - deadline_ticks) < 0)
+                cpu_relax();
+        }
+
+        template<class Rep, class Period>
+        inline void sleep_for(const std::chrono::duration<Rep, Period>& duration)
+        {
+            sleep_until(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
+        }
+
+        // Fixed-rate loop pacing: each wait() ends one period after the previous deadline, not after the previous wake-up
+        class Ticker
+        {
+        public:
+            using clock = std::chrono::steady_clock;
+
+            explicit Ticker(clock::duration period) :m_period{ period }, m_next{ clock::now() + period } {}
+
+            // Waits for the next deadline and returns how many periods it covered (more than 1 after an overrun:
+            // missed ticks are skipped rather than run back to back)
+            inline uint64_t wait()
+            {
+                auto now = clock::now();
+                uint64_t periods = 1;
+                if (now >= m_next)
+                {
+                    uint64_t behind = static_cast<uint64_t>((now - m_next) / m_period);
+                    m_next += m_period * static_cast<clock::rep>(behind);
+                    periods += behind;
+                }
+                sleep_until(m_next);
+                m_next += m_period;
+                return periods;
+            }
+
+            inline clock::time_point next_deadline() const noexcept { return m_next; }
+            inline clock::duration period() const noexcept { return m_period; }
+
+        private:
+            clock::duration m_period;
+            clock::time_point m_next;
+        };
+    }
+
+    namespace detail
+    {
+        template<class Executor>
+        struct EnqueueOn
+        {
+            static void call(void* executor, std::coroutine_handle<> h) { static_cast<Executor*>(executor)->enqueue(h); }
+        };
+    }
+
+    // Coroutine timers: co_await timer.sleep_for(d) suspends without holding a thread and, at the deadline, the timer
+    // thread hands the coroutine to the executor's enqueue (e.g. a ThreadPool from asyncops.hpp) or, without one,
+    // resumes it itself; it wakes with precise::sleep_until. The executor is type-erased rather than included, because
+    // GCC 12 cannot compile a module importing both pooriayousefi.core.asyncops and pooriayousefi.core.stringformers.
+    class Timer
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        struct Awaitable
+        {
+            Timer& timer;
+            clock::time_point deadline;
+            inline bool await_ready() const noexcept { return deadline <= clock::now(); }
+            inline void await_suspend(std::coroutine_handle<> h) { timer.add(deadline, h); }
+            constexpr void await_resume() noexcept {}
+        };
+
+        Timer() :Timer{ nullptr, nullptr } {}
+
+        // The executor must outlive the timer
+        template<class Executor> requires requires(Executor& executor, std::coroutine_handle<> h) { executor.enqueue(h); }
+        explicit Timer(Executor& executor) :Timer{ std::addressof(executor), &detail::EnqueueOn<Executor>::call } {}
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        // Pending coroutines are resumed right away rather than left suspended forever
+        ~Timer()
+        {
+            {
+                std::scoped_lock lock{ m_mutex };
+                m_stopping = true;
+            }
+            m_wake.notify_one();
+            m_thread.join();
+        }
+
+        inline Awaitable sleep_until(clock::time_point deadline) noexcept { return Awaitable{ *this, deadline }; }
+
+        template<class Rep, class Period>
+        inline Awaitable sleep_for(const std::chrono::duration<Rep, Period>& duration) noexcept
+        {
+            return Awaitable{ *this, clock::now() + std::chrono::duration_cast<clock::duration>(duration) };
+        }
+
+    private:
+        Timer(void* executor, void (*enqueue)(void*, std::coroutine_handle<>))
+            :m_executor{ executor }, m_enqueue{ enqueue }, m_mutex{}, m_wake{}, m_pending{}, m_stopping{ false }, m_thread{ [this]() { run(); } } {}
+
+        struct Entry
+        {
+            clock::time_point deadline;
+            std::coroutine_handle<> handle;
+        };
+
+        // Orders the pending heap earliest deadline first
+        struct Later
+        {
+            inline bool operator()(const Entry& lhs, const Entry& rhs) const noexcept { return lhs.deadline > rhs.deadline; }
+        };
+
+        inline void add(clock::time_point deadline, std::coroutine_handle<> h)
+        {
+            bool earliest;
+            {
+                std::scoped_lock lock{ m_mutex };
+                m_pending.push_back(Entry{ deadline, h });
+                std::push_heap(m_pending.begin(), m_pending.end(), Later{});
+                earliest = m_pending.front().handle == h;
+            }
+            if (earliest)
+                m_wake.notify_one();
+        }
+
+        inline void dispatch(std::coroutine_handle<> h)
+        {
+            if (m_enqueue != nullptr)
+                m_enqueue(m_executor, h);
+            else
+                h.resume();
+        }
+
+        // Sleeps on the condition variable until slack before the earliest deadline, then spins outside the lock
+        void run()
+        {
+            std::unique_lock lock{ m_mutex };
+            while (true)
+            {
+                if (m_pending.empty())
+                {
+                    if (m_stopping)
+                        break;
+                    m_wake.wait(lock);
+                    continue;
+                }
+                Entry next = m_pending.front();
+                if (!m_stopping && clock::now() < next.deadline - precise::calibration().slack)
+                {
+                    m_wake.wait_until(lock, next.deadline - precise::calibration().slack);
+                    continue;
+                }
+                std::pop_heap(m_pending.begin(), m_pending.end(), Later{});
+                m_pending.pop_back();
+                bool stopping = m_stopping;
+                lock.unlock();
+                if (!stopping)
+                    precise::sleep_until(next.deadline);
+                dispatch(next.handle);
+                lock.lock();
+            }
+        }
+
+        void* m_executor;
+        void (*m_enqueue)(void*, std::coroutine_handle<>);
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::vector<Entry> m_pending;
+        bool m_stopping;
+        std::thread m_thread;
+    };
+
+    // sleep hands the whole wait to the kernel; precise spins through its last stretch (see precise::sleep_until)
+    enum class WaitMode { sleep, precise };
+
+    template<Arithmetic T> 
+    class wait_for
+    {
+    public:
+        wait_for() = delete;
+        wait_for(T value, WaitMode mode = WaitMode::sleep) :m_value{ value }, m_mode{ mode } {}
+        inline void nanoseconds() { wait(std::chrono::duration<double, std::ratio<1, 1'000'000'000>>(m_value)); }
+        inline void microseconds() { wait(std::chrono::duration<double, std::ratio<1, 1'000'000>>(m_value)); }
+        inline void milliseconds() { wait(std::chrono::duration<double, std::ratio<1, 1'000>>(m_value)); }
+        inline void seconds() { wait(std::chrono::duration<double, std::ratio<1>>(m_value)); }
+        inline void minutes() { wait(std::chrono::duration<double, std::ratio<60>>(m_value)); }
+        inline void hours() { wait(std::chrono::duration<double, std::ratio<3'600>>(m_value)); }
+        inline void days() { wait(std::chrono::duration<double, std::ratio<86'400>>(m_value)); }
+    private:
+        template<class Period> inline void wait(std::chrono::duration<double, Period> duration)
+        {
+            if (m_mode == WaitMode::precise)
+                precise::sleep_for(duration);
+            else
+                std::this_thread::sleep_for(duration);
+        }
+        T m_value;
+        WaitMode m_mode;
+    };
+
+    // Waits until an absolute deadline (precise by default, so fixed-rate loops neither drift nor overshoot)
+    template<class Clock, class Duration>
+    inline void wait_until(const std::chrono::time_point<Clock, Duration>& deadline, WaitMode mode = WaitMode::precise)
+    {
+        if (mode == WaitMode::precise)
+            precise::sleep_until(deadline);
+        else
+            std::this_thread::sleep_until(deadline);
+    }
+
+    // Wall time of a single call in seconds; bench::run (bench.hpp) warms up, repeats and summarizes instead
+    template<typename F, typename... Args> 
+    constexpr decltype(auto) runtime(F&& f, Args&&... args)
+    {
+        if constexpr (std::is_void_v<std::invoke_result_t<F, Args...>>)
+        {
+            auto ti{ std::chrono::high_resolution_clock::now() };
+            std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+            auto tf{ std::chrono::high_resolution_clock::now() };
+            return std::chrono::duration<double>(tf - ti).count();
+        }
+        else if constexpr (!std::is_void_v<std::invoke_result_t<F, Args...>>)
+        {
+            auto ti{ std::chrono::high_resolution_clock::now() };
+            auto retval{ std::invoke(std::forward<F>(f), std::forward<Args>(args)...) };
+            auto tf{ std::chrono::high_resolution_clock::now() };
+            return std::make_pair(std::move(retval), std::chrono::duration<double>(tf - ti).count());
+        }
+    }
+
+    namespace convert
+    {
+        template<std::floating_point T> constexpr T degrees_to_radians(T x) { return x * std::numbers::pi_v<T> / (T)180; }
+        template<std::floating_point T> constexpr T radians_to_degrees(T x) { return x * (T)180 / std::numbers::pi_v<T>; }
+        template<std::floating_point T> constexpr T Celsius_to_Fahrenheit(T x) { return (x * (T)9 / (T)5) + (T)32; }
+        template<std::floating_point T> constexpr T Fahrenheit_to_Celsius(T x) { return (x - (T)32) * (T)5 / (T)9; }
+    }
+
+    template<std::integral I> 
+    constexpr void countdown(I nsec)
+    {
+        std::cout << "\nT-" << nsec << ' ';
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        for (auto i{ static_cast<int64_t>(nsec) - static_cast<int64_t>(1) }; i >= static_cast<int64_t>(0); --i)
+        {
+            std::cout << i << ' ';
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+
+    // Execution policies for iterate, named after std::execution's. <execution> itself is not used: with libstdc++ its
+    // parallel policies need TBB, at link time and in module interfaces alike
+    namespace execution
+    {
+        struct sequenced_policy {};
+        struct unsequenced_policy {};
+        struct parallel_policy {};
+        struct parallel_unsequenced_policy {};
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr unsequenced_policy unseq{};
+        inline constexpr parallel_policy par{};
+        inline constexpr parallel_unsequenced_policy par_unseq{};
+
+        template<class T> inline constexpr bool is_execution_policy_v =
+            std::is_same_v<T, sequenced_policy> || std::is_same_v<T, unsequenced_policy> ||
+            std::is_same_v<T, parallel_policy> || std::is_same_v<T, parallel_unsequenced_policy>;
+    }
+
+    namespace detail
+    {
+        // Calls f on elements first ... last - 1 of a strided random-access sequence. Indices are computed directly,
+        // so the loop has a known trip count the compiler can vectorize; contiguous iterators can prefetch the element
+        // prefetch_distance steps ahead (useful once the stride outruns the hardware prefetcher)
+        template<std::random_access_iterator It, class F>
+        inline void iterate_strided(It begin, size_t first, size_t last, size_t step_size, size_t prefetch_distance, F& f)
+        {
+            using difference_type = std::iter_difference_t<It>;
+            if constexpr (std::contiguous_iterator<It>)
+            {
+                if (prefetch_distance != 0)
+                {
+                    auto* base = std::to_address(begin);
+                    size_t prefetched = last - first > prefetch_distance ? last - prefetch_distance : first;
+                    for (; first < prefetched; ++first)
+                    {
+                        __builtin_prefetch(base + (first + prefetch_distance) * step_size);
+                        std::invoke(f, begin[static_cast<difference_type>(first * step_size)]);
+                    }
+                }
+            }
+            for (size_t i = first; i < last; ++i)
+                std::invoke(f, begin[static_cast<difference_type>(i * step_size)]);
+        }
+
+        // The same, with the iterations declared independent as an unsequenced execution policy allows
+        template<std::random_access_iterator It, class F>
+        inline void iterate_strided_unsequenced(It begin, size_t n, size_t step_size, F& f)
+        {
+            using difference_type = std::iter_difference_t<It>;
+#if defined(__GNUC__)
+#pragma GCC ivdep
+#endif
+            for (size_t i = 0; i < n; ++i)
+                std::invoke(f, begin[static_cast<difference_type>(i * step_size)]);
+        }
+
+        // One contiguous block of the strided sequence per worker
+        template<std::random_access_iterator It, class F>
+        struct IterateBlock
+        {
+            It begin;
+            size_t n;
+            size_t step_size;
+            size_t prefetch_distance;
+            size_t workers;
+            F& f;
+
+            inline void operator()(size_t w) const
+            {
+                iterate_strided(begin, w * n / workers, (w + 1) * n / workers, step_size, prefetch_distance, f);
+            }
+        };
+
+        template<class F>
+        struct BlockThunk
+        {
+            static void run(void* f, size_t w) { (*static_cast<F*>(f))(w); }
+        };
+
+        // Fire-and-forget coroutine: runs one block on whichever executor thread resumes it, then frees its frame
+        struct DetachedBlock
+        {
+            struct promise_type
+            {
+                inline DetachedBlock get_return_object() noexcept { return DetachedBlock{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+                constexpr std::suspend_always initial_suspend() noexcept { return {}; }
+                constexpr std::suspend_never final_suspend() noexcept { return {}; }
+                constexpr void return_void() noexcept {}
+                inline void unhandled_exception() noexcept { std::terminate(); }
+            };
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        // Nothing of task, error or done is touched after the count-down that may let the caller return
+        inline DetachedBlock run_block(const ParallelTask& task, size_t w, std::exception_ptr& error, std::latch& done)
+        {
+            try
+            {
+                task.run(task.f, w);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            done.count_down();
+            co_return;
+        }
+
+        // Runs f(0) ... f(n - 1) as coroutines handed to executor.enqueue (the caller runs the last) and rethrows the first exception
+        template<class Executor, class F>
+        void run_on_executor(Executor& executor, size_t n, F& f)
+        {
+            ParallelTask task{ BlockThunk<F>::run, const_cast<void*>(static_cast<const void*>(std::addressof(f))) };
+            std::vector<std::exception_ptr> errors(n);
+            std::latch done{ static_cast<std::ptrdiff_t>(n) };
+            for (size_t w = 0; w + 1 < n; ++w)
+                executor.enqueue(run_block(task, w, errors[w], done).handle);
+            run_block(task, n - 1, errors[n - 1], done).handle.resume();
+            done.wait();
+            for (auto& error : errors)
+                if (error)
+                    std::rethrow_exception(error);
+        }
+    }
+
+    // Calls f on n elements starting at begin, step_size apart. Random-access iterators are indexed directly
+    // (a vectorizable loop); other iterators are advanced one step at a time and never past the last element.
+    template<std::input_or_output_iterator It, std::invocable<std::iter_value_t<It>&> F>
+    constexpr void iterate(It begin, size_t n, size_t step_size, F&& f)
+    {
+        if constexpr (std::random_access_iterator<It>)
+        {
+            detail::iterate_strided(begin, 0, n, step_size, 0, f);
+        }
+        else
+        {
+            auto it = begin;
+            for (size_t c = 0; c < n; ++c)
+            {
+                if (c != 0)
+                    it = std::ranges::next(it, static_cast<std::iter_difference_t<It>>(step_size));
+                std::invoke(f, *it);
+            }
+        }
+    }
+
+    // iterate under an execution policy (execution::seq, unseq, par, par_unseq). Parallel policies split the range into
+    // one contiguous block per core (one per 16Ki elements at most) on their own threads; unsequenced ones
+    // tell the compiler the calls are independent. prefetch_distance > 0 prefetches that many steps ahead on contiguous
+    // iterators. f must be safe to call concurrently under a parallel policy; non-random-access iterators run serially.
+    template<class ExecutionPolicy, std::input_or_output_iterator It, std::invocable<std::iter_value_t<It>&> F>
+        requires execution::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    void iterate(ExecutionPolicy&&, It begin, size_t n, size_t step_size, F&& f, size_t prefetch_distance = 0)
+    {
+        using Policy = std::remove_cvref_t<ExecutionPolicy>;
+        if constexpr (!std::random_access_iterator<It>)
+        {
+            iterate(begin, n, step_size, f);
+        }
+        else if constexpr (std::is_same_v<Policy, execution::parallel_policy> || std::is_same_v<Policy, execution::parallel_unsequenced_policy>)
+        {
+            size_t workers = detail::default_workers(n, size_t{ 1 } << 14);
+            if (workers == 1)
+            {
+                detail::iterate_strided(begin, 0, n, step_size, prefetch_distance, f);
+                return;
+            }
+            detail::IterateBlock<It, std::remove_reference_t<F>> block{ begin, n, step_size, prefetch_distance, workers, f };
+            detail::run_parallel(workers, block);
+        }
+        else if constexpr (std::is_same_v<Policy, execution::unsequenced_policy>)
+        {
+            if (prefetch_distance != 0)
+                detail::iterate_strided(begin, 0, n, step_size, prefetch_distance, f);
+            else
+                detail::iterate_strided_unsequenced(begin, n, step_size, f);
+        }
+        else
+        {
+            detail::iterate_strided(begin, 0, n, step_size, prefetch_distance, f);
+        }
+    }
+
+    // iterate on an executor such as asyncops.hpp's ThreadPool: blocks of at least 16Ki elements, one per executor
+    // thread, run as coroutines passed to executor.enqueue while the caller runs one block and then waits for the rest.
+    // Do not call it from one of the executor's own threads, which would wait on work queued behind it.
+    template<class Executor, std::random_access_iterator It, std::invocable<std::iter_value_t<It>&> F>
+        requires requires(Executor& executor, std::coroutine_handle<> h) { executor.enqueue(h); executor.size(); }
+    void iterate(Executor& executor, It begin, size_t n, size_t step_size, F&& f, size_t prefetch_distance = 0)
+    {
+        size_t workers = std::clamp<size_t>(n / (size_t{ 1 } << 14), 1, executor.size() + 1);
+        detail::IterateBlock<It, std::remove_reference_t<F>> block{ begin, n, step_size, prefetch_distance, workers, f };
+        if (workers == 1)
+            block(0);
+        else
+            detail::run_on_executor(executor, workers, block);
+    }
+
+    // Occurrences of every element of a range. Sized random-access ranges are cut into one slice per
+    // thread (threads = 0: one per 64Ki elements, up to the hardware concurrency) and counted with the
+    // sharded flat tables behind count_words; other ranges are counted on the calling thread.
+    // Elements must be default constructible.
+    template<std::ranges::input_range R, class Hash = std::hash<std::ranges::range_value_t<R>>, class KeyEqual = std::equal_to<std::ranges::range_value_t<R>>>
+    auto histogram(R&& range, size_t threads = 0)
+    {
+        using Key = std::ranges::range_value_t<R>;
+        std::vector<detail::CountTable<Key, Hash, KeyEqual>> shards{};
+        if constexpr (std::ranges::random_access_range<R> && std::ranges::sized_range<R>)
+        {
+            auto size = static_cast<size_t>(std::ranges::size(range));
+            size_t workers = threads != 0 ? threads : detail::default_workers(size, size_t{ 1 } << 16);
+            auto first = std::ranges::begin(range);
+            shards = detail::parallel_count<Key, Hash, KeyEqual>(workers, [&](size_t w, auto&& add)
+            {
+                auto begin = first + static_cast<ptrdiff_t>(w * size / workers);
+                auto end = first + static_cast<ptrdiff_t>((w + 1) * size / workers);
+                for (auto it = begin; it != end; ++it)
+                    add(*it);
+            });
+        }
+        else
+        {
+            shards = detail::parallel_count<Key, Hash, KeyEqual>(1, [&](size_t, auto&& add)
+            {
+                for (auto&& element : range)
+                    add(element);
+            });
+        }
+        std::unordered_map<Key, size_t, Hash, KeyEqual> counts{};
+        size_t distinct = 0;
+        for (const auto& shard : shards)
+            distinct += shard.size();
+        counts.reserve(distinct);
+        for (const auto& shard : shards)
+            shard.for_each_count([&](const Key& key, size_t count) { counts.emplace(key, count); });
+        return counts;
+    }
+
+    // Word frequencies of a text, counted in parallel (see count_words in stringformers.hpp); the keys view the text
+    inline std::unordered_map<std::string_view, size_t> frequencies(std::string_view text, std::string_view delim = " \t\n\v\f\r", size_t threads = 0)
+    {
+        std::unordered_map<std::string_view, size_t> counts{};
+        tokenize(text, DelimiterSet{ delim }, counts, threads);
+        return counts;
+    }
+
+    // The k most frequent words of a text, approximately and in bounded memory (see heavy_hitters)
+    inline std::vector<HeavyHitter> top_frequencies(std::string_view text, size_t k, std::string_view delim = " \t\n\v\f\r", size_t threads = 0)
+    {
+        return heavy_hitters(text, DelimiterSet{ delim }, k, 0, threads);
+    }
+
+    // Counter-based random bit generator (splitmix64 over a keyed counter): the i-th value of stream s of seed x
+    // depends only on (x, s, i), so every Monte Carlo repetition can own a stream and discard() jumps ahead in O(1)
+    class CounterRng
+    {
+    public:
+        using result_type = uint64_t;
+
+        explicit constexpr CounterRng(uint64_t seed = 0, uint64_t stream = 0) noexcept
+            :m_key{ mix(seed + mix(stream + 0x9E3779B97F4A7C15ull)) }, m_counter{ 0 } {}
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return UINT64_MAX; }
+
+        constexpr result_type operator()() noexcept { return mix(m_key + 0x9E3779B97F4A7C15ull * ++m_counter); }
+        constexpr void discard(uint64_t n) noexcept { m_counter += n; }
+        constexpr uint64_t counter() const noexcept { return m_counter; }
+
+    private:
+        static constexpr uint64_t mix(uint64_t z) noexcept
+        {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        uint64_t m_key;
+        uint64_t m_counter;
+    };
+
+    // Unbiased integer in [0, bound) by multiply-and-reject (Lemire). Unlike std::uniform_int_distribution,
+    // whose algorithm is up to the standard library, the result is the same everywhere.
+    template<class Rng>
+    constexpr uint64_t uniform_index(Rng& rng, uint64_t bound)
+    {
+        uint64_t lo = rng(), hi = bound;
+        detail::multiply_wide(lo, hi);
+        if (lo < bound)
+        {
+            uint64_t threshold = (0 - bound) % bound;
+            while (lo < threshold)
+            {
+                lo = rng();
+                hi = bound;
+                detail::multiply_wide(lo, hi);
+            }
+        }
+        return hi;
+    }
+
+    // Reproducible Fisher-Yates shuffle (std::shuffle's sequence differs between standard libraries)
+    template<std::ranges::random_access_range R, class Rng>
+    constexpr void shuffle(R&& range, Rng& rng)
+    {
+        auto first = std::ranges::begin(range);
+        auto n = static_cast<uint64_t>(std::ranges::distance(range));
+        for (uint64_t i = n; i > 1; --i)
+            std::ranges::iter_swap(first + static_cast<ptrdiff_t>(i - 1), first + static_cast<ptrdiff_t>(uniform_index(rng, i)));
+    }
+
+    // Appends k distinct indices drawn uniformly from [0, n) to out in O(k): Floyd's algorithm while k is at most
+    // half of n, a partial Fisher-Yates over the indices beyond that. seen is scratch space reused across calls.
+    template<class Rng>
+    void sample_indices(Rng& rng, size_t n, size_t k, std::vector<size_t>& out, flat_set<size_t>& seen)
+    {
+        if (k > n)
+            throw std::runtime_error("ERROR! sample_indices: cannot draw more samples than there are elements");
+        if (2 * k <= n)
+        {
+            seen.clear();
+            seen.reserve(k);
+            for (size_t j = n - k; j < n; ++j)
+            {
+                auto t = static_cast<size_t>(uniform_index(rng, j + 1));
+                size_t chosen = seen.insert(t).second ? t : j;
+                if (chosen == j)
+                    seen.insert(j);
+                out.push_back(chosen);
+            }
+        }
+        else
+        {
+            size_t first = out.size();
+            out.resize(first + n);
+            std::iota(out.begin() + static_cast<ptrdiff_t>(first), out.end(), size_t{ 0 });
+            auto indices = out.begin() + static_cast<ptrdiff_t>(first);
+            for (size_t i = 0; i < k; ++i)
+                std::iter_swap(indices + static_cast<ptrdiff_t>(i), indices + static_cast<ptrdiff_t>(i + uniform_index(rng, n - i)));
+            out.resize(first + k);
+        }
+    }
+
+    namespace detail
+    {
+        // Default parallelism for repetitions: one worker per repetition block of about 2^16 sampled elements
+        inline size_t repetition_workers(size_t n_times, size_t k, size_t threads) noexcept
+        {
+            if (threads != 0)
+                return std::clamp<size_t>(threads, 1, std::max<size_t>(1, n_times));
+            return std::min(std::max<size_t>(1, n_times), default_workers(n_times * std::max<size_t>(1, k), size_t{ 1 } << 16));
+        }
+
+        // Repetitions of one worker in do_n_times_shuffle_and_sample: repetition r draws from stream r
+        template<class It>
+        struct SampleRepetitions
+        {
+            It first;
+            size_t n;
+            size_t k;
+            size_t n_times;
+            size_t workers;
+            uint64_t seed;
+            std::vector<std::vector<std::iter_value_t<It>>>& samples;
+
+            inline void operator()(size_t w) const
+            {
+                std::vector<size_t> indices{};
+                flat_set<size_t> seen{};
+                for (size_t r = w * n_times / workers; r < (w + 1) * n_times / workers; ++r)
+                {
+                    CounterRng rng{ seed, r };
+                    indices.clear();
+                    sample_indices(rng, n, k, indices, seen);
+                    auto& sample = samples[r];
+                    sample.reserve(k);
+                    for (size_t i : indices)
+                        sample.push_back(first[static_cast<ptrdiff_t>(i)]);
+                }
+            }
+        };
+
+        // Per-worker bins of sample_histogram, summed once every worker is done
+        struct SampleCounts
+        {
+            size_t n;
+            size_t k;
+            size_t n_times;
+            size_t workers;
+            uint64_t seed;
+            std::vector<std::vector<size_t>>& bins;
+
+            inline void operator()(size_t w) const
+            {
+                std::vector<size_t> indices{};
+                flat_set<size_t> seen{};
+                auto& counts = bins[w];
+                counts.assign(n, 0);
+                for (size_t r = w * n_times / workers; r < (w + 1) * n_times / workers; ++r)
+                {
+                    CounterRng rng{ seed, r };
+                    indices.clear();
+                    sample_indices(rng, n, k, indices, seen);
+                    for (size_t i : indices)
+                        ++counts[i];
+                }
+            }
+        };
+    }
+
+    // n_times independent samples of k distinct elements of a range (k equal to the size: a shuffle), repeated in
+    // parallel (threads = 0: one worker per 2^16 sampled elements, up to the hardware concurrency). Repetition r draws
+    // from CounterRng{ seed, r }, so the result is bit-identical for every thread count.
+    template<std::ranges::random_access_range R>
+    auto do_n_times_shuffle_and_sample(R&& range, size_t n_times, size_t k, uint64_t seed = 0, size_t threads = 0)
+    {
+        using It = std::ranges::iterator_t<R>;
+        auto n = static_cast<size_t>(std::ranges::distance(range));
+        if (k > n)
+            throw std::runtime_error("ERROR! do_n_times_shuffle_and_sample: cannot draw more samples than there are elements");
+        std::vector<std::vector<std::iter_value_t<It>>> samples(n_times);
+        if (n_times == 0)
+            return samples;
+        size_t workers = detail::repetition_workers(n_times, k, threads);
+        detail::SampleRepetitions<It> repetitions{ std::ranges::begin(range), n, k, n_times, workers, seed, samples };
+        detail::run_parallel(workers, repetitions);
+        return samples;
+    }
+
+    // How often each position of a range of n elements is drawn over the samples do_n_times_shuffle_and_sample
+    // would take, without materializing them: every worker counts into its own bins, merged at the end
+    inline std::vector<size_t> sample_histogram(size_t n, size_t n_times, size_t k, uint64_t seed = 0, size_t threads = 0)
+    {
+        if (k > n)
+            throw std::runtime_error("ERROR! sample_histogram: cannot draw more samples than there are elements");
+        std::vector<size_t> counts(n, 0);
+        if (n_times == 0)
+            return counts;
+        size_t workers = detail::repetition_workers(n_times, k, threads);
+        std::vector<std::vector<size_t>> bins(workers);
+        detail::SampleCounts count{ n, k, n_times, workers, seed, bins };
+        detail::run_parallel(workers, count);
+        for (const auto& worker_counts : bins)
+            for (size_t i = 0; i < n; ++i)
+                counts[i] += worker_counts[i];
+        return counts;
+    }
+
+    // Types a Result can hold: objects other than arrays and std::exception_ptr, which would make the
+    // value and error constructors ambiguous. References go through std::reference_wrapper.
+    template<typename T>
+    concept ResultValue = std::is_object_v<T> && !std::is_array_v<T> && !std::same_as<std::remove_cv_t<T>, std::exception_ptr>;
+
+    // Expected value of a computation or the exception it ended with. value() rethrows the exception;
+    // has_value() and error() look without throwing. Result<void> holds only the exception, if any.
+    template<class T = void> requires std::is_void_v<T> || ResultValue<T>
+    struct Result
+    {
+        std::variant<T, std::exception_ptr> state;
+
+        Result(T value) : state{ std::in_place_index<0>, std::move(value) } {}
+        Result(std::exception_ptr error) : state{ std::in_place_index<1>, std::move(error) } {}
+
+        bool has_value() const noexcept { return state.index() == 0; }
+        explicit operator bool() const noexcept { return has_value(); }
+        std::exception_ptr error() const noexcept { return has_value() ? nullptr : std::get<1>(state); }
+
+        T& value() &
+        {
+            if (!has_value())
+                std::rethrow_exception(std::get<1>(state));
+            return std::get<0>(state);
+        }
+        const T& value() const&
+        {
+            if (!has_value())
+                std::rethrow_exception(std::get<1>(state));
+            return std::get<0>(state);
+        }
+        T&& value() &&
+        {
+            return std::move(value());
+        }
+        template<class U> T value_or(U&& fallback) const&
+        {
+            return has_value() ? std::get<0>(state) : static_cast<T>(std::forward<U>(fallback));
+        }
+    };
+
+    template<>
+    struct Result<void>
+    {
+        std::exception_ptr exception;
+
+        Result() = default;
+        Result(std::exception_ptr error) : exception{ std::move(error) } {}
+
+        bool has_value() const noexcept { return !exception; }
+        explicit operator bool() const noexcept { return has_value(); }
+        std::exception_ptr error() const noexcept { return exception; }
+
+        void value() const
+        {
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+    };
+
+    // What try_invoke keeps of a callable's return type R: lvalue references as std::reference_wrapper,
+    // everything else by value
+    template<class R>
+    using try_invoke_result_t = std::conditional_t<std::is_lvalue_reference_v<R>,
+        std::reference_wrapper<std::remove_reference_t<R>>, std::remove_cvref_t<R>>;
+
+    // Calls f(args...) and captures what it returns or throws
+    template<class F, class... Args> requires std::invocable<F, Args...>
+    Result<try_invoke_result_t<std::invoke_result_t<F, Args...>>> try_invoke(F&& f, Args&&... args) noexcept
+    {
+        using T = try_invoke_result_t<std::invoke_result_t<F, Args...>>;
+        try
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+                return Result<void>{};
+            }
+            else
+                return Result<T>{ std::invoke(std::forward<F>(f), std::forward<Args>(args)...) };
+        }
+        catch (...)
+        {
+            return Result<T>{ std::current_exception() };
+        }
+    }
+}
+
+// Specializations of std templates cannot be declared inside a named module's purview,
+// so the pooriayousefi.core.utilities interface unit leaves them out
+#if !defined(POORIAYOUSEFI_CORE_MODULE_INTERFACE)
+namespace std
+{
+	// Hashes the byte value directly: std::hash<size_t>::operator() is not constexpr
+	template<> struct hash<byte>
+	{
+		constexpr size_t operator()(const byte& b) const noexcept
+		{
+			return to_integer<size_t>(b);
+		}
+	};
+
+	template<> struct equal_to<byte>
+	{
+		constexpr bool operator()(const byte& lb, const byte& rb) const noexcept
+		{
+			return to_integer<size_t>(lb) == to_integer<size_t>(rb);
+		}
+	};
+
+	template<class T> struct hash<reference_wrapper<const T>>
+	{
+		constexpr size_t operator()(const reference_wrapper<const T>& ref) const
+		{
+			hash<T> hasher{};
+			return hasher(ref.get());
+		}
+	};
+
+	template<class T> struct equal_to<reference_wrapper<const T>>
+	{
+		constexpr bool operator()(const reference_wrapper<const T>& lhs, const reference_wrapper<const T>& rhs) const
+		{
+			return lhs.get() == rhs.get();
+		}
+	};
+}
+#endif
+)";
+
+        // bench.hpp content (statistical micro-benchmark harness)
+        constexpr std::string_view bench_content = R"(
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+#include <charconv>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <initializer_list>
+#include <stdexcept>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+/**********************************************************************************************
+*
+*                   			    Benchmark Header
+*                   			-----------------------
+*    		This header provides a statistical micro-benchmark harness.
+*    		It includes:
+*    		- do_not_optimize / escape / clobber_memory compiler barriers.
+*    		- CLOCK_MONOTONIC_RAW and serialized rdtsc (cntvct on AArch64) timers.
+*    		- A PerfCounters class reading cycles, instructions and cache misses via perf_event_open.
+*    		- A run function template with warmup, adaptive iteration counts and
+*    		  median / p99 / MAD statistics over many samples.
+*    		- A Suite class collecting results and reporting them as a table, JSON or CSV.
+*
+*                   			Developed by: Pooria Yousefi
+*				   				Date: 2025-06-26
+*				   				License: MIT
+*
+**********************************************************************************************/
+
+namespace pooriayousefi::core
+{
+    namespace bench
+    {
+        // Forces the compiler to materialize value (in a register or in memory) without emitting any code
+        template<class T> inline void do_not_optimize(const T& value)
+        {
+            if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(T*))
+                asm volatile("" : : "r,m"(value) : "memory");
+            else
+                asm volatile("" : : "m"(value) : "memory");
+        }
+
+        // Same, but the compiler must also assume value was modified, so it cannot hoist its computation out of a loop
+        template<class T> inline void do_not_optimize(T& value)
+        {
+            if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(T*))
+                asm volatile("" : "+m,r"(value) : : "memory");
+            else
+                asm volatile("" : "+m"(value) : : "memory");
+        }
+
+        // Makes the memory behind p observable, so stores into it are not eliminated
+        inline void escape(const void* p) { asm volatile("" : : "g"(p) : "memory"); }
+
+        // Makes every pending store observable
+        inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+        enum class Timer
+        {
+            monotonic_raw,  // clock_gettime(CLOCK_MONOTONIC_RAW): not slewed by NTP, ~20 ns per read
+            tsc             // rdtsc fenced by lfence (cntvct on AArch64), calibrated against monotonic_raw
+        };
+
+        inline uint64_t monotonic_raw_ns() noexcept
+        {
+            timespec ts{};
+            ::clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+            return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+        }
+
+        // Time-stamp counter; the fences keep the measured code from being reordered around the read
+        inline uint64_t tsc() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_lfence();
+            uint64_t ticks = __builtin_ia32_rdtsc();
+            __builtin_ia32_lfence();
+            return ticks;
+#elif defined(__aarch64__)
+            uint64_t ticks;
+            asm volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(ticks) : : "memory");
+            return ticks;
+#else
+            return monotonic_raw_ns();
+#endif
+        }
+
+        namespace detail
+        {
+            inline double calibrate_tsc() noexcept
+            {
+                uint64_t t0 = monotonic_raw_ns();
+                uint64_t c0 = tsc();
+                uint64_t t1 = t0;
+                while (t1 - t0 < 20'000'000)
+                    t1 = monotonic_raw_ns();
+                uint64_t c1 = tsc();
+                return static_cast<double>(c1 - c0) / static_cast<double>(t1 - t0);
+            }
+        }
+
+        // Time-stamp counter ticks per nanosecond, measured once over 20 ms
+        inline double tsc_ticks_per_ns() noexcept
+        {
+            static const double ratio = detail::calibrate_tsc();
+            return ratio;
+        }
+
+        // Hardware counters of the calling thread (user space only, so perf_event_paranoid <= 2 suffices).
+        // Counters the kernel or the machine refuses (containers, VMs) are reported as absent.
+        class PerfCounters
+        {
+        public:
+            struct Values
+            {
+                std::optional<uint64_t> cycles;
+                std::optional<uint64_t> instructions;
+                std::optional<uint64_t> cache_misses;
+            };
+
+            PerfCounters()
+                :m_fds{ -1, -1, -1 }, m_count{ 0 }
+            {
+                constexpr uint64_t configs[3] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES };
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    perf_event_attr attr{};
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.size = sizeof(perf_event_attr);
+                    attr.config = configs[i];
+                    attr.disabled = m_count == 0 ? 1 : 0;
+                    attr.exclude_kernel = 1;
+                    attr.exclude_hv = 1;
+                    attr.read_format = PERF_FORMAT_GROUP;
+                    int leader = m_count == 0 ? -1 : leader_fd();
+                    m_fds[i] = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+                    if (m_fds[i] >= 0)
+                        ++m_count;
+                }
+            }
+            PerfCounters(const PerfCounters&) = delete;
+            PerfCounters& operator=(const PerfCounters&) = delete;
+            ~PerfCounters()
+            {
+                for (int fd : m_fds)
+                    if (fd >= 0)
+                        ::close(fd);
+            }
+
+            bool available() const noexcept { return m_count != 0; }
+
+            void start() noexcept
+            {
+                if (m_count == 0)
+                    return;
+                ::ioctl(leader_fd(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ::ioctl(leader_fd(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+
+            Values stop() noexcept
+            {
+                Values values{};
+                if (m_count == 0)
+                    return values;
+                ::ioctl(leader_fd(), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+                // PERF_FORMAT_GROUP: the number of events, then one value per open event in opening order
+                uint64_t buffer[4]{};
+                if (::read(leader_fd(), buffer, sizeof(buffer)) < static_cast<ssize_t>(sizeof(uint64_t) * (1 + m_count)))
+                    return values;
+                std::optional<uint64_t>* fields[3] = { &values.cycles, &values.instructions, &values.cache_misses };
+                for (size_t i = 0, v = 1; i < 3; ++i)
+                    if (m_fds[i] >= 0)
+                        *fields[i] = buffer[v++];
+                return values;
+            }
+
+        private:
+            int leader_fd() const noexcept
+            {
+                for (int fd : m_fds)
+                    if (fd >= 0)
+                        return fd;
+                return -1;
+            }
+
+            int m_fds[3];
+            size_t m_count;
+        };
+
+        struct Options
+        {
+            std::chrono::nanoseconds warmup{ std::chrono::milliseconds{ 50 } };   // run before any sample is taken
+            std::chrono::nanoseconds min_time{ std::chrono::milliseconds{ 250 } }; // measured time over all samples
+            size_t min_samples{ 25 };
+            size_t max_samples{ 10'000 };
+            Timer timer{ Timer::monotonic_raw };
+            bool counters{ false };                                               // read PerfCounters around every sample
+        };
+
+        // Sample statistics in nanoseconds per iteration; mad is the median absolute deviation from the median
+        struct Statistics
+        {
+            double median{ 0.0 };
+            double mean{ 0.0 };
+            double p99{ 0.0 };
+            double mad{ 0.0 };
+            double min{ 0.0 };
+            double max{ 0.0 };
+            double stddev{ 0.0 };
+        };
+
+        struct Result
+        {
+            std::string name;
+            Timer timer;
+            size_t iterations;              // calls per sample
+            std::vector<double> samples;    // nanoseconds per call, one entry per sample
+            Statistics stats;
+            std::optional<double> cycles;   // per call, when the counters were requested and available
+            std::optional<double> instructions;
+            std::optional<double> cache_misses;
+        };
+
+        // Linearly interpolated percentile (0 to 100) of sorted values
+        inline double percentile(const std::vector<double>& sorted, double p) noexcept
+        {
+            if (sorted.empty())
+                return 0.0;
+            double rank = p / 100.0 * static_cast<double>(sorted.size() - 1);
+            size_t below = static_cast<size_t>(rank);
+            if (below + 1 >= sorted.size())
+                return sorted.back();
+            return sorted[below] + (rank - static_cast<double>(below)) * (sorted[below + 1] - sorted[below]);
+        }
+
+        inline Statistics summarize(std::vector<double> samples)
+        {
+            Statistics stats{};
+            if (samples.empty())
+                return stats;
+            std::sort(samples.begin(), samples.end());
+            double sum = 0.0;
+            for (double sample : samples)
+                sum += sample;
+            stats.mean = sum / static_cast<double>(samples.size());
+            double squares = 0.0;
+            for (double sample : samples)
+                squares += (sample - stats.mean) * (sample - stats.mean);
+            stats.stddev = samples.size() > 1 ? std::sqrt(squares / static_cast<double>(samples.size() - 1)) : 0.0;
+            stats.median = percentile(samples, 50.0);
+            stats.p99 = percentile(samples, 99.0);
+            stats.min = samples.front();
+            stats.max = samples.back();
+            for (double& sample : samples)
+                sample = std::fabs(sample - stats.median);
+            std::sort(samples.begin(), samples.end());
+            stats.mad = percentile(samples, 50.0);
+            return stats;
+        }
+
+        namespace detail
+        {
+            // Calls the benchmarked function 'iterations' times; see run
+            struct Body
+            {
+                void (*run)(void*, size_t);
+                void* f;
+            };
+
+            inline uint64_t read_timer(Timer timer) noexcept { return timer == Timer::tsc ? tsc() : monotonic_raw_ns(); }
+
+            inline double to_ns(uint64_t ticks, Timer timer) noexcept
+            {
+                return timer == Timer::tsc ? static_cast<double>(ticks) / tsc_ticks_per_ns() : static_cast<double>(ticks);
+            }
+
+            inline Result measure(std::string name, const Body& body, const Options& options)
+            {
+                if (options.min_samples == 0 || options.max_samples < options.min_samples)
+                    throw std::invalid_argument("ERROR! bench::run() needs 0 < min_samples <= max_samples.");
+                if (options.timer == Timer::tsc)
+                    tsc_ticks_per_ns();
+
+                // Warmup in doubling batches; also estimates the cost of one call
+                auto warmup = static_cast<uint64_t>(options.warmup.count());
+                uint64_t spent = 0;
+                size_t calls = 0;
+                for (size_t batch = 1;; batch *= 2)
+                {
+                    uint64_t t0 = monotonic_raw_ns();
+                    body.run(body.f, batch);
+                    spent += monotonic_raw_ns() - t0;
+                    calls += batch;
+                    if (spent >= warmup || batch >= (size_t{ 1 } << 30))
+                        break;
+                }
+
+                // Iterations per sample such that min_samples samples fill min_time
+                double per_call = static_cast<double>(spent) / static_cast<double>(calls);
+                double target = static_cast<double>(options.min_time.count()) / static_cast<double>(options.min_samples);
+                double iterations = per_call > 0.0 ? target / per_call : 1.0;
+                iterations = iterations < 1.0 ? 1.0 : iterations > 1e9 ? 1e9 : iterations;
+
+                Result result{ std::move(name), options.timer, static_cast<size_t>(iterations), {}, {}, {}, {}, {} };
+                std::optional<PerfCounters> counters{};
+                if (options.counters)
+                    counters.emplace();
+                uint64_t totals[3] = { 0, 0, 0 };
+                bool counted[3] = { false, false, false };
+
+                double measured = 0.0;
+                auto min_time = static_cast<double>(options.min_time.count());
+                while (result.samples.size() < options.max_samples && (result.samples.size() < options.min_samples || measured < min_time))
+                {
+                    if (counters)
+                        counters->start();
+                    uint64_t t0 = read_timer(options.timer);
+                    body.run(body.f, result.iterations);
+                    uint64_t t1 = read_timer(options.timer);
+                    if (counters)
+                    {
+                        auto values = counters->stop();
+                        const std::optional<uint64_t>* fields[3] = { &values.cycles, &values.instructions, &values.cache_misses };
+                        for (size_t i = 0; i < 3; ++i)
+                            if (*fields[i])
+                            {
+                                totals[i] += **fields[i];
+                                counted[i] = true;
+                            }
+                    }
+                    double elapsed = to_ns(t1 - t0, options.timer);
+                    measured += elapsed;
+                    result.samples.push_back(elapsed / static_cast<double>(result.iterations));
+                }
+
+                double executed = static_cast<double>(result.samples.size()) * static_cast<double>(result.iterations);
+                std::optional<double>* fields[3] = { &result.cycles, &result.instructions, &result.cache_misses };
+                for (size_t i = 0; i < 3; ++i)
+                    if (counted[i])
+                        *fields[i] = static_cast<double>(totals[i]) / executed;
+                result.stats = summarize(result.samples);
+                return result;
+            }
+
+            inline void append_number(std::string& out, double value)
+            {
+                char buffer[64];
+                auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 3);
+                out.append(buffer, error == std::errc{} ? end : buffer);
+            }
+
+            inline void append_optional(std::string& out, const std::optional<double>& value, const char* absent)
+            {
+                if (value)
+                    append_number(out, *value);
+                else
+                    out += absent;
+            }
+
+            inline void append_json_string(std::string& out, const std::string& value)
+            {
+                out += '"';
+                for (char c : value)
+                {
+                    if (c == '"' || c == '\\')
+                    {
+                        out += '\\';
+                        out += c;
+                    }
+                    else if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        constexpr char digits[] = "0123456789abcdef";
+                        out += "\\u00";
+                        out += digits[(c >> 4) & 0xf];
+                        out += digits[c & 0xf];
+                    }
+                    else
+                    {
+                        out += c;
+                    }
+                }
+                out += '"';
+            }
+
+            inline const char* timer_name(Timer timer) noexcept { return timer == Timer::tsc ? "tsc" : "monotonic_raw"; }
+
+            // value left- or right-aligned in a column of the given width
+            inline void append_padded(std::string& out, const std::string& value, size_t width, bool left)
+            {
+                size_t padding = value.size() < width ? width - value.size() : 0;
+                if (!left)
+                    out.append(padding, ' ');
+                out.append(value);
+                if (left)
+                    out.append(padding, ' ');
+            }
+
+            // nanoseconds with a readable unit
+            inline std::string format_duration(double ns)
+            {
+                const char* unit = "ns";
+                if (ns >= 1e9) { ns /= 1e9; unit = "s"; }
+                else if (ns >= 1e6) { ns /= 1e6; unit = "ms"; }
+                else if (ns >= 1e3) { ns /= 1e3; unit = "us"; }
+                std::string out{};
+                append_number(out, ns);
+                return out + ' ' + unit;
+            }
+        }
+
+        // Measures f(): warms it up for options.warmup, then takes samples of N back-to-back calls, with N chosen
+        // so that options.min_samples samples take options.min_time, until both minimums are met (or max_samples).
+        // A non-void result of f is passed through do_not_optimize, so the call cannot be optimized away.
+        template<class F> Result run(std::string name, F&& f, const Options& options = {})
+        {
+            using Function = std::remove_reference_t<F>;
+            detail::Body body{ [](void* p, size_t iterations)
+            {
+                auto& function = *static_cast<Function*>(p);
+                for (size_t i = 0; i < iterations; ++i)
+                {
+                    if constexpr (std::is_void_v<std::invoke_result_t<Function&>>)
+                        std::invoke(function);
+                    else
+                        do_not_optimize(std::invoke(function));
+                }
+            }, const_cast<void*>(static_cast<const void*>(std::addressof(f))) };
+            return detail::measure(std::move(name), body, options);
+        }
+
+        // Reports are returned as strings rather than written to a std::ostream: GCC 12 fails to compile
+        // importers of a module that includes <ostream> next to the <iostream> of pooriayousefi.core.utilities
+
+        // One JSON document {"benchmarks": [...]}, times in nanoseconds per call, absent counters as null
+        inline std::string to_json(const std::vector<Result>& results)
+        {
+            std::string out{ "{\n  \"benchmarks\": [" };
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                const auto& result = results[i];
+                out += i == 0 ? "\n    {" : ",\n    {";
+                out += "\"name\": ";
+                detail::append_json_string(out, result.name);
+                out += ", \"timer\": \"";
+                out += detail::timer_name(result.timer);
+                out += "\", \"iterations\": " + std::to_string(result.iterations);
+                out += ", \"samples\": " + std::to_string(result.samples.size());
+                const std::pair<const char*, double> fields[] = {
+                    { "median_ns", result.stats.median }, { "mean_ns", result.stats.mean }, { "p99_ns", result.stats.p99 },
+                    { "mad_ns", result.stats.mad }, { "min_ns", result.stats.min }, { "max_ns", result.stats.max },
+                    { "stddev_ns", result.stats.stddev }
+                };
+                for (const auto& [key, value] : fields)
+                {
+                    out += ", \"";
+                    out += key;
+                    out += "\": ";
+                    detail::append_number(out, value);
+                }
+                out += ", \"cycles\": ";
+                detail::append_optional(out, result.cycles, "null");
+                out += ", \"instructions\": ";
+                detail::append_optional(out, result.instructions, "null");
+                out += ", \"cache_misses\": ";
+                detail::append_optional(out, result.cache_misses, "null");
+                out += '}';
+            }
+            out += results.empty() ? "]\n}\n" : "\n  ]\n}\n";
+            return out;
+        }
+
+        // A header row, then one row per result; absent counters are empty fields
+        inline std::string to_csv(const std::vector<Result>& results)
+        {
+            std::string out{ "name,timer,iterations,samples,median_ns,mean_ns,p99_ns,mad_ns,min_ns,max_ns,stddev_ns,cycles,instructions,cache_misses\n" };
+            for (const auto& result : results)
+            {
+                out += '"';
+                for (char c : result.name)
+                {
+                    if (c == '"')
+                        out += '"';
+                    out += c;
+                }
+                out += "\",";
+                out += detail::timer_name(result.timer);
+                out += ',' + std::to_string(result.iterations) + ',' + std::to_string(result.samples.size());
+                for (double value : { result.stats.median, result.stats.mean, result.stats.p99, result.stats.mad,
+                    result.stats.min, result.stats.max, result.stats.stddev })
+                {
+                    out += ',';
+                    detail::append_number(out, value);
+                }
+                for (const auto* value : { &result.cycles, &result.instructions, &result.cache_misses })
+                {
+                    out += ',';
+                    detail::append_optional(out, *value, "");
+                }
+                out += '\n';
+            }
+            return out;
+        }
+
+        // Human-readable table: median, p99 and MAD per call, and instructions per cycle when counted
+        inline std::string to_table(const std::vector<Result>& results)
+        {
+            size_t width = 9;
+            for (const auto& result : results)
+                width = std::max(width, result.name.size());
+            std::string out{};
+            detail::append_padded(out, "benchmark", width, true);
+            const std::pair<const char*, size_t> columns[] = { { "median", 14 }, { "p99", 14 }, { "mad", 14 }, { "samples x calls", 22 }, { "ipc", 8 } };
+            for (const auto& [title, column] : columns)
+                detail::append_padded(out, title, column, false);
+            out += '\n';
+            for (const auto& result : results)
+            {
+                std::string ipc{ "-" };
+                if (result.cycles && result.instructions && *result.cycles > 0.0)
+                {
+                    ipc.clear();
+                    detail::append_number(ipc, *result.instructions / *result.cycles);
+                }
+                detail::append_padded(out, result.name, width, true);
+                detail::append_padded(out, detail::format_duration(result.stats.median), 14, false);
+                detail::append_padded(out, detail::format_duration(result.stats.p99), 14, false);
+                detail::append_padded(out, detail::format_duration(result.stats.mad), 14, false);
+                detail::append_padded(out, std::to_string(result.samples.size()) + " x " + std::to_string(result.iterations), 22, false);
+                detail::append_padded(out, ipc, 8, false);
+                out += '\n';
+            }
+            return out;
+        }
+
+        // Runs benchmarks with shared options and keeps their results for reporting
+        class Suite
+        {
+        public:
+            Suite() = default;
+            explicit Suite(const Options& options) :m_options{ options }, m_results{} {}
+
+            template<class F> const Result& run(std::string name, F&& f)
+            {
+                return run(std::move(name), std::forward<F>(f), m_options);
+            }
+
+            template<class F> const Result& run(std::string name, F&& f, const Options& options)
+            {
+                m_results.push_back(bench::run(std::move(name), std::forward<F>(f), options));
+                return m_results.back();
+            }
+
+            const std::vector<Result>& results() const noexcept { return m_results; }
+            Options& options() noexcept { return m_options; }
+
+            std::string to_table() const { return bench::to_table(m_results); }
+            std::string to_json() const { return bench::to_json(m_results); }
+            std::string to_csv() const { return bench::to_csv(m_results); }
+
+        private:
+            Options m_options{};
+            std::vector<Result> m_results{};
+        };
+    }
+}
+)";
+
+        // core.hpp content (umbrella header, precompiled by ./builder --pch)
+        constexpr std::string_view core_content = R"(
+// Include guard instead of #pragma once: GCC warns about #pragma once when precompiling this file as the main file
+#ifndef POORIAYOUSEFI_CORE_CORE_HPP
+#define POORIAYOUSEFI_CORE_CORE_HPP
+
+/**********************************************************************************************
+*
+*                   			    Core Umbrella Header
+*                   			-----------------------
+*    		This header includes every embedded core header at once.
+*    		./builder --pch precompiles it and force-includes it in every source,
+*    		so the heavy standard headers are parsed a single time per build.
+*
+*                   			Developed by: Pooria Yousefi
+*				   				Date: 2025-06-26
+*				   				License: MIT
+*
+**********************************************************************************************/
+
+#include "tracing.hpp"
+#include "asyncops.hpp"
+#include "raiiiofsw.hpp"
+#include "containers.hpp"
+#include "memory.hpp"
+#include "stringformers.hpp"
+#include "utilities.hpp"
+#include "bench.hpp"
+
+#endif
+)";
+
+        // Write all header files
+        // Embedded headers, written as they are
+        constexpr std::pair<std::string_view, std::string_view> headers[] = {
+            { "tracing", tracing_content },
+            { "asyncops", asyncops_content },
+            { "raiiiofsw", raiiiofsw_content },
+            { "containers", containers_content },
+            { "memory", memory_content },
+            { "stringformers", stringformers_content },
+            { "utilities", utilities_content },
+            { "bench", bench_content },
+            { "core", core_content }
+        };
+        for (const auto& [name, content] : headers)
+        {
+            write_file(project_path + "/include/core/" + std::string(name) + ".hpp", content);
+        }
+
+        if (use_modules)
+        {
+            // One named module per header: the global module fragment repeats the header's standard includes,
+            // the purview exports the header itself. Partitions of a single module would be the natural layout,
+            // but GCC 12 fails with an internal compiler error on 'export import :partition'.
+            // Headers compiled as part of the unit of the header that includes them rather than as modules of their own:
+            // GCC 12 miscompiles std::string_view members inlined from one module's global module fragment into
+            // another module, and stringformers.hpp hashes string views with containers.hpp on its hot path;
+            // asyncops.hpp instruments its resume points with tracing.hpp and allocates pools from memory.hpp
+            constexpr std::pair<std::string_view, std::string_view> folded[] = {
+                { "containers", containers_content },
+                { "memory", memory_content },
+                { "tracing", tracing_content }
+            };
+
+            auto make_module_unit = [&folded](std::string_view name, std::string_view content)
+            {
+                std::string unit = "module;\n";
+                std::string imports;
+                std::string purview;
+                // The header's prologue (includes and the conditionals around them) up to its banner;
+                // an include of a sibling header becomes an import of that header's module, or, for a folded
+                // header, brings in that header's prologue here and the header itself into the purview
+                auto add_prologue = [&](std::string_view header, auto& self) -> void
+                {
+                    for (size_t begin = 0, end; begin < header.size(); begin = end + 1)
+                    {
+                        end = std::min(header.find('\n', begin), header.size());
+                        std::string_view line = header.substr(begin, end - begin);
+                        if (line.starts_with("/*"))
+                        {
+                            break;
+                        }
+                        if (line.starts_with("#include \""))
+                        {
+                            std::string_view sibling = line.substr(10, line.find(".hpp\"") - 10);
+                            auto it = std::find_if(std::begin(folded), std::end(folded), [&](const auto& entry) { return entry.first == sibling; });
+                            if (it != std::end(folded))
+                            {
+                                self(it->second, self);
+                                purview += "#include \"";
+                                purview += sibling;
+                                purview += ".hpp\"\n";
+                            }
+                            else
+                            {
+                                imports += "import pooriayousefi.core.";
+                                imports += sibling;
+                                imports += ";\n";
+                            }
+                        }
+                        else if (line.starts_with("#") && line != "#pragma once")
+                        {
+                            unit += line;
+                            unit += "\n";
+                        }
+                    }
+                };
+                add_prologue(content, add_prologue);
+                unit += "\nexport module pooriayousefi.core." + std::string(name) + ";\n";
+                unit += imports + "\n";
+                unit += "#define POORIAYOUSEFI_CORE_MODULE_INTERFACE\n";
+                unit += "export\n{\n" + purview + "#include \"" + std::string(name) + ".hpp\"\n}\n";
+                return unit;
+            };
+
+            constexpr std::pair<std::string_view, std::string_view> modules[] = {
+                { "asyncops", asyncops_content },
+                { "raiiiofsw", raiiiofsw_content },
+                { "stringformers", stringformers_content },
+                { "utilities", utilities_content },
+                { "bench", bench_content }
+            };
+
+            // core.cppm re-exports every module; ./builder compiles them in the order listed here
+            std::string core_module = "export module pooriayousefi.core;\n\n";
+            for (const auto& [name, content] : modules)
+            {
+                write_generated_file(project_path + "/include/core/modules/core." + std::string(name) + ".cppm", make_module_unit(name, content));
+                core_module += "export import pooriayousefi.core." + std::string(name) + ";\n";
+            }
+            write_generated_file(project_path + "/include/core/modules/core.cppm", std::move(core_module));
+        }
+        
+        if (!quiet)
+        {
+            std::cout << "Template header files created!\n";
+        }
+    };
+
+    // Create source file
+    auto create_source_files = [&]()
+    {
+        if (!quiet)
+        {
+            std::cout << "Creating source files...\n";
+        }
+        
+        // Main source file template; {{CORE_INCLUDES}} is substituted when the file is written
+        constexpr std::string_view main_cpp_template = R"({{CORE_INCLUDES}}
+// entry-point
+int main()
+{
+    try
+    {
+        // start here ...
+        
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& xxx)
+    {
+        std::cerr << "Error: " << xxx.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
+    )";
+        
+        // Standard headers must be included before the import; GCC 12 rejects textual
+        // standard includes that follow an imported module using the same headers
+        constexpr std::string_view module_includes = R"(
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+
+#ifdef POORIAYOUSEFI_CORE_USE_MODULES
+import pooriayousefi.core;
+#else
+#include "asyncops.hpp"
+#include "raiiiofsw.hpp"
+#include "containers.hpp"
+#include "stringformers.hpp"
+#include "utilities.hpp"
+#include "bench.hpp"
+#include "tracing.hpp"
+#include "memory.hpp"
+#endif
+)";
+        constexpr std::string_view header_includes = R"(
+#include "asyncops.hpp"
+#include "raiiiofsw.hpp"
+#include "containers.hpp"
+#include "stringformers.hpp"
+#include "utilities.hpp"
+#include "bench.hpp"
+#include "tracing.hpp"
+#include "memory.hpp"
+)";
+        
+        write_generated_file(project_path + "/src/main.cpp", render(main_cpp_template, {
+            { "{{CORE_INCLUDES}}", use_modules ? module_includes : header_includes } }));
+    };
+
+    // Create benchmark suite
+    auto create_bench_files = [&]()
+    {
+        if (!quiet)
+        {
+            std::cout << "Creating benchmark suite...\n";
+        }
+        
+        // One source per embedded core header, all run by bench/main.cpp through core::bench (./builder --bench)
+        constexpr std::string_view bench_benchmarks_hpp = R"(
+#pragma once
+#include "bench.hpp"
+
+// Every embedded core header registers its kernels with the suite run by bench/main.cpp
+void bench_asyncops(pooriayousefi::core::bench::Suite& suite);
+void bench_raiiiofsw(pooriayousefi::core::bench::Suite& suite);
+void bench_stringformers(pooriayousefi::core::bench::Suite& suite);
+)";
+        
+        constexpr std::string_view bench_main_cpp = R"(
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include "benchmarks.hpp"
+
+namespace bench = pooriayousefi::core::bench;
+
+// Median nanoseconds per benchmark name from a CSV written by bench::to_csv
+static std::map<std::string, double> read_medians(const std::filesystem::path& csv)
+{
+    std::map<std::string, double> medians;
+    std::ifstream in(csv);
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line))
+    {
+        // "name" with doubled quotes, then timer, iterations, samples, median_ns, ...
+        std::string name;
+        size_t i = 1;
+        for (; i < line.size(); ++i)
+        {
+            if (line[i] == '"' && (i + 1 >= line.size() || line[i + 1] != '"'))
+                break;
+            if (line[i] == '"')
+                ++i;
+            name += line[i];
+        }
+        std::istringstream fields(line.substr(std::min(i + 2, line.size())));
+        std::string field;
+        for (int column = 0; column < 4 && std::getline(fields, field, ','); ++column)
+        {
+        }
+        if (!field.empty())
+            medians[name] = std::stod(field);
+    }
+    return medians;
+}
+
+// usage: bench [output_dir] [baseline_csv]
+// Writes results.json and results.csv to output_dir (default build/bench) and compares the medians with
+// the baseline (default bench/baseline.csv); the first run pins its results as the baseline.
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const std::filesystem::path output_dir = argc > 1 ? argv[1] : "build/bench";
+        const std::filesystem::path baseline = argc > 2 ? argv[2] : "bench/baseline.csv";
+
+        bench::Suite suite{};
+        bench_asyncops(suite);
+        bench_raiiiofsw(suite);
+        bench_stringformers(suite);
+        std::cout << suite.to_table();
+
+        std::filesystem::create_directories(output_dir);
+        std::ofstream(output_dir / "results.json") << suite.to_json();
+        std::ofstream(output_dir / "results.csv") << suite.to_csv();
+        std::cout << "\nResults: " << (output_dir / "results.json").string() << ", " << (output_dir / "results.csv").string() << std::endl;
+
+        if (!std::filesystem::exists(baseline))
+        {
+            std::filesystem::copy_file(output_dir / "results.csv", baseline);
+            std::cout << "Pinned performance baseline: " << baseline.string() << std::endl;
+            return EXIT_SUCCESS;
+        }
+        auto medians = read_medians(baseline);
+        std::cout << "\nMedian vs " << baseline.string() << ":\n";
+        for (const auto& result : suite.results())
+        {
+            auto it = medians.find(result.name);
+            std::cout << "  " << result.name << ": ";
+            if (it == medians.end() || it->second <= 0.0)
+                std::cout << "new\n";
+            else
+                std::cout << std::showpos << std::fixed << std::setprecision(1) << (result.stats.median / it->second - 1.0) * 100.0 << std::noshowpos << "%\n";
+        }
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& xxx)
+    {
+        std::cerr << "Error: " << xxx.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
+)";
+        
+        constexpr std::string_view bench_asyncops_cpp = R"(
+#include <array>
+#include "benchmarks.hpp"
+#include "asyncops.hpp"
+
+using namespace pooriayousefi::core;
+
+static Generator<int> iota(int n)
+{
+    for (int i = 0; i < n; ++i)
+        co_yield i;
+}
+
+static Task<int> answer()
+{
+    co_return 42;
+}
+
+// Each level awaits the next: depth nested frames, resumed by symmetric transfer on the way back up
+static Task<int> chain(int depth)
+{
+    if (depth == 0)
+        co_return 0;
+    co_return 1 + co_await chain(depth - 1);
+}
+
+static Task<int> await_in_loop(int n)
+{
+    int sum = 0;
+    for (int i = 0; i < n; ++i)
+        sum += co_await answer();
+    co_return sum;
+}
+
+void bench_asyncops(bench::Suite& suite)
+{
+    suite.run("Generator<int> iteration x1000", []
+    {
+        long sum = 0;
+        for (int i : iota(1000))
+            sum += i;
+        return sum;
+    });
+
+    GeneratorFactory<std::array<double, 8>> factory;
+    {
+        auto objects = factory.generate();
+        auto it = objects.begin();
+        suite.run("GeneratorFactory::generate next", [&]
+        {
+            ++it;
+            auto handle = std::move(*it);
+            bench::do_not_optimize(handle);
+        });
+    }
+
+    suite.run("sync_wait on Task<int>", [] { return sync_wait(answer()); });
+
+    // Per co_await: divide by 1000
+    suite.run("co_await chain depth 1000", [] { return sync_wait(chain(1000)); });
+    suite.run("co_await Task<int> x1000", [] { return sync_wait(await_in_loop(1000)); });
+}
+)";
+        
+        constexpr std::string_view bench_raiiiofsw_cpp = R"(
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+#include "benchmarks.hpp"
+#include "raiiiofsw.hpp"
+
+using namespace pooriayousefi::core;
+
+void bench_raiiiofsw(bench::Suite& suite)
+{
+    // 16 MiB scratch file, read back whole through each reader; after the first pass it is served from the page cache
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "core_bench_input.bin";
+    std::vector<std::byte> chunk(1 << 20, std::byte{ 0x5a });
+    {
+        raii::BinaryFileWriter writer{ path };
+        for (int i = 0; i < 16; ++i)
+            writer.write(std::span<const std::byte>{ chunk });
+    }
+
+    suite.run("BinaryFileReader::read_into 16 MiB", [&]
+    {
+        raii::BinaryFileReader reader{ path };
+        size_t total = 0;
+        while (size_t n = reader.read_into(std::span<std::byte>{ chunk }))
+            total += n;
+        return total;
+    });
+
+    suite.run("MappedFile 16 MiB open + touch", [&]
+    {
+        raii::MappedFile file{ path, raii::MappedFile::Mode::read_only, raii::MappedFile::Advice::sequential };
+        auto bytes = file.bytes();
+        size_t sum = 0;
+        for (size_t i = 0; i < bytes.size(); i += 4096)
+            sum += std::to_integer<size_t>(bytes[i]);
+        return sum;
+    });
+
+    std::vector<char> text(chunk.size());
+    suite.run("InputFileStreamWrapper::read_into 16 MiB", [&]
+    {
+        raii::native::narrow_encoded::InputFileStreamWrapper stream;
+        stream.open(path, std::ios_base::binary);
+        size_t total = 0;
+        while (size_t n = stream.read_into(std::span<char>{ text }))
+            total += n;
+        return total;
+    });
+
+    std::filesystem::remove(path);
+}
+)";
+        
+        constexpr std::string_view bench_stringformers_cpp = R"(
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <memory_resource>
+#include "benchmarks.hpp"
+#include "memory.hpp"
+#include "stringformers.hpp"
+
+using namespace pooriayousefi::core;
+
+// ~1 MiB of lowercase words of 1 to 12 letters separated by spaces and newlines
+static std::string make_text(size_t size)
+{
+    std::mt19937_64 rng{ 42 };
+    std::string text;
+    text.reserve(size + 16);
+    while (text.size() < size)
+    {
+        size_t length = 1 + rng() % 12;
+        for (size_t i = 0; i < length; ++i)
+            text += static_cast<char>('a' + rng() % 26);
+        text += rng() % 8 == 0 ? '\n' : ' ';
+    }
+    return text;
+}
+
+void bench_stringformers(bench::Suite& suite)
+{
+    static const std::string text = make_text(1 << 20);
+    static const std::string upper = to_uppercase(text);
+    const std::string_view view{ text };
+    const std::string_view delim{ " \n" };
+    const DelimiterSet delimiters{ delim };
+
+    std::vector<std::string_view> tokens;
+    suite.run("tokenize(view, delim, vector) 1 MiB", [&] { tokenize(view, delim, tokens); return tokens.size(); });
+    suite.run("tokenize(view, DelimiterSet, vector) 1 MiB", [&] { tokenize(view, delimiters, tokens); return tokens.size(); });
+    flat_map<std::string_view, size_t> counts;
+    suite.run("tokenize(view, DelimiterSet, flat_map) 1 MiB", [&] { tokenize(view, delimiters, counts); return counts.size(); });
+
+    // Delimiter scanning with each ISA the CPU has (the others are skipped), as GB/s of text scanned
+    const std::pair<DelimiterSet::Isa, const char*> isas[] = {
+        { DelimiterSet::Isa::scalar, "scalar" }, { DelimiterSet::Isa::ssse3, "ssse3" }, { DelimiterSet::Isa::avx2, "avx2" }, { DelimiterSet::Isa::neon, "neon" } };
+    for (const auto& [isa, isa_name] : isas)
+    {
+        const DelimiterSet scanner{ delim, isa };
+        if (scanner.isa() != isa)
+            continue;
+        const auto& result = suite.run(std::string{ "DelimiterSet::for_each_token 1 MiB, " } + isa_name, [&]
+        {
+            size_t count = 0;
+            scanner.for_each_token(view, [&](std::string_view) { ++count; });
+            return count;
+        });
+        std::printf("%s: %.2f GB/s\n", result.name.c_str(), static_cast<double>(view.size()) / result.stats.median);
+    }
+
+    std::string lowered;
+    suite.run("to_lowercase(view, string&) 1 MiB", [&] { to_lowercase(std::string_view{ upper }, lowered); return lowered.size(); });
+    std::vector<char> buffer(upper.size());
+    suite.run("to_lowercase(view, span) 1 MiB", [&] { return to_lowercase(std::string_view{ upper }, std::span<char>{ buffer }).size(); });
+
+    // Per-request work: fresh containers for a 4 KiB message, from the heap or from an arena rewound after each request
+    const std::string_view message = view.substr(0, 4096);
+    suite.run("request 4 KiB: tokenize + to_lowercase, heap", [&]
+    {
+        std::vector<std::string_view> words;
+        tokenize(message, delimiters, words);
+        return words.size() + to_lowercase(message).size();
+    });
+    memory::Arena arena{ 64 * 1024 };
+    suite.run("request 4 KiB: tokenize + to_lowercase, memory::Arena", [&]
+    {
+        memory::ArenaScope scope{ arena };
+        std::pmr::vector<std::string_view> words{ &arena };
+        tokenize(message, delimiters, words);
+        return words.size() + to_lowercase(message, std::pmr::polymorphic_allocator<char>{ &arena }).size();
+    });
+
+    // 1M integer tokens of 1 to 19 digits, parsed into a column and formatted back
+    static const std::string numbers = []
+    {
+        std::mt19937_64 rng{ 7 };
+        std::string out;
+        for (size_t i = 0; i < (1 << 20); ++i)
+        {
+            format_to(out, rng() >> (rng() % 60));
+            out += ' ';
+        }
+        return out;
+    }();
+    std::vector<std::string_view> number_tokens;
+    tokenize(std::string_view{ numbers }, delimiters, number_tokens);
+    std::vector<uint64_t> column;
+    suite.run("std::from_chars loop 1M integers", [&]
+    {
+        column.resize(number_tokens.size());
+        for (size_t i = 0; i < number_tokens.size(); ++i)
+            std::from_chars(number_tokens[i].data(), number_tokens[i].data() + number_tokens[i].size(), column[i]);
+        return column.back();
+    });
+    suite.run("parse_column<uint64_t> 1M integers, 1 thread", [&] { parse_column(number_tokens, column, 1); return column.back(); });
+    suite.run("parse_column<uint64_t> 1M integers", [&] { parse_column(number_tokens, column); return column.back(); });
+    std::string formatted;
+    suite.run("format_to(string&, uint64_t) 1M integers", [&]
+    {
+        formatted.clear();
+        for (uint64_t value : column)
+            format_to(formatted, value);
+        return formatted.size();
+    });
+}
+)";
+        
+        write_file(project_path + "/bench/benchmarks.hpp", bench_benchmarks_hpp);
+        write_file(project_path + "/bench/main.cpp", bench_main_cpp);
+        write_file(project_path + "/bench/asyncops.cpp", bench_asyncops_cpp);
+        write_file(project_path + "/bench/raiiiofsw.cpp", bench_raiiiofsw_cpp);
+        write_file(project_path + "/bench/stringformers.cpp", bench_stringformers_cpp);
+    };
+
+    // Create build system
+    auto create_build_system = [&]()
+    {
+        if (!quiet)
+        {
+            std::cout << "Creating build system...\n";
+        }
+        
+        // Create C++ build system executable
+        // builder.cpp; {{PROJECT_NAME}} is substituted when the file is written
+        constexpr std::string_view build_cpp = R"builder(#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <map>
+#include <cerrno>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace fs = std::filesystem;
+
+// 128-bit non-cryptographic content hash (two independently seeded 64-bit lanes) used to key cached objects
+class ContentHash
+{
+private:
+    uint64_t lo_ = 0x9E3779B97F4A7C15ull;
+    uint64_t hi_ = 0xC2B2AE3D27D4EB4Full;
+    
+    static uint64_t mix(uint64_t x)
+    {
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDull;
+        x ^= x >> 33;
+        x *= 0xC4CEB9FE1A85EC53ull;
+        x ^= x >> 33;
+        return x;
+    }
+    
+    void update_word(uint64_t word)
+    {
+        lo_ = mix(lo_ ^ word) + 0x632BE59BD9B4E019ull;
+        hi_ = mix(hi_ + word * 0x9FB21C651E98DF25ull) ^ (lo_ >> 29);
+    }
+    
+public:
+    ContentHash& update(std::string_view data)
+    {
+        // Length prefix keeps field boundaries unambiguous
+        update_word(data.size());
+        size_t i = 0;
+        for (; i + 8 <= data.size(); i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, data.data() + i, 8);
+            update_word(word);
+        }
+        uint64_t tail = 0;
+        std::memcpy(&tail, data.data() + i, data.size() - i);
+        update_word(tail);
+        return *this;
+    }
+    
+    std::string hex() const
+    {
+        char buffer[33];
+        std::snprintf(buffer, sizeof(buffer), "%016llx%016llx", static_cast<unsigned long long>(mix(hi_ ^ lo_)), static_cast<unsigned long long>(mix(lo_)));
+        return buffer;
+    }
+};
+
+class BuildSystem
+{
+private:
+    struct CompileUnit
+    {
+        std::string source;
+        fs::path obj_file;
+        fs::path dep_file;
+    };
+    
+    // One command measured by --time-report; the phases are filled in from -ftime-report (--time-report=phases)
+    struct CommandTiming
+    {
+        std::string kind;       // "pch", "module", "compile", "archive" or "link"
+        std::string target;     // the source compiled or the file linked
+        std::string dep_file;   // depfile of a compile, for the header summary
+        double wall_seconds = 0.0;
+        double user_seconds = 0.0;
+        double system_seconds = 0.0;
+        long peak_rss_kb = 0;
+        bool has_phases = false;
+        double parsing_seconds = 0.0;
+        double template_seconds = 0.0;
+        double codegen_seconds = 0.0;
+    };
+    
+    std::string build_type_;
+    std::string output_type_;
+    unsigned jobs_;
+    bool use_cache_;
+    bool use_pch_;
+    fs::path cache_dir_;
+    bool use_modules_;
+    bool bench_;
+    bool trace_;
+    bool lto_;
+    bool native_;
+    std::string pgo_;       // "", "gen" (instrument) or "use" (optimize with the profile in build/pgo)
+    std::string linker_;    // passed to -fuse-ld=, empty for the default linker
+    bool time_report_ = false;
+    bool time_phases_ = false;
+    mutable std::vector<CommandTiming> timings_;
+    std::vector<std::string> implicit_dependencies_;
+    std::string compiler_id_;
+    mutable std::mutex output_mutex_;
+    mutable std::atomic<size_t> cache_hits_{ 0 };
+    mutable std::atomic<size_t> cache_misses_{ 0 };
+    
+    // Run a command; with --time-report, a command given a kind is also timed (wall, CPU and peak RSS of it and its
+    // children, from wait4). A time_file receives the command's standard error: its -ftime-report phases are parsed
+    // and the diagnostics before them are passed on.
+    int execute_command(const std::string& command, const std::string& kind = "", const std::string& target = "", const std::string& dep_file = "", const std::string& time_file = "") const
+    {
+        const std::string full_command = time_file.empty() ? command : command + " 2> " + time_file;
+        {
+            std::lock_guard<std::mutex> lock(output_mutex_);
+            std::cout << "Executing: " << full_command << std::endl;
+        }
+        if (!time_report_ || kind.empty())
+        {
+            return std::system(full_command.c_str());
+        }
+        
+        CommandTiming timing{ kind, target, dep_file };
+        rusage usage{};
+        auto start = std::chrono::steady_clock::now();
+        int status = spawn_and_wait(full_command, usage);
+        timing.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        timing.user_seconds = static_cast<double>(usage.ru_utime.tv_sec) + static_cast<double>(usage.ru_utime.tv_usec) * 1e-6;
+        timing.system_seconds = static_cast<double>(usage.ru_stime.tv_sec) + static_cast<double>(usage.ru_stime.tv_usec) * 1e-6;
+        timing.peak_rss_kb = usage.ru_maxrss;
+        if (!time_file.empty())
+        {
+            read_time_report(time_file, timing);
+        }
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        timings_.push_back(std::move(timing));
+        return status;
+    }
+    
+    // std::system without the shell's signal handling, but with the child's resource usage (including the compiler
+    // processes it waited for) from wait4; returns the wait status like std::system
+    static int spawn_and_wait(const std::string& command, rusage& usage)
+    {
+        const char* argv[] = { "sh", "-c", command.c_str(), nullptr };
+        pid_t pid;
+        if (posix_spawn(&pid, "/bin/sh", nullptr, nullptr, const_cast<char* const*>(argv), environ) != 0)
+        {
+            return -1;
+        }
+        int status = 0;
+        while (wait4(pid, &status, 0, &usage) < 0)
+        {
+            if (errno != EINTR)
+            {
+                return -1;
+            }
+        }
+        return status;
+    }
+    
+    // Split the standard error of a -ftime-report compile into its diagnostics, echoed to std::cerr, and the wall
+    // times of the parsing, template instantiation and code generation phases
+    void read_time_report(const std::string& time_file, CommandTiming& timing) const
+    {
+        std::ifstream in(time_file);
+        std::string line;
+        std::string diagnostics;
+        bool in_report = false;
+        auto wall_time = [](const std::string& text)
+        {
+            double user = 0.0, system = 0.0, wall = 0.0;
+            std::sscanf(text.c_str() + text.find(':') + 1, " %lf ( %*[^)]) %lf ( %*[^)]) %lf", &user, &system, &wall);
+            return wall;
+        };
+        while (std::getline(in, line))
+        {
+            if (line.rfind("Time variable", 0) == 0)
+            {
+                in_report = true;
+                timing.has_phases = true;
+            }
+            else if (!in_report)
+            {
+                diagnostics += line + "\n";
+            }
+            else if (line.rfind(" phase parsing ", 0) == 0)
+            {
+                timing.parsing_seconds = wall_time(line);
+            }
+            else if (line.rfind(" template instantiation ", 0) == 0)
+            {
+                timing.template_seconds = wall_time(line);
+            }
+            else if (line.rfind(" phase opt and generate ", 0) == 0)
+            {
+                timing.codegen_seconds = wall_time(line);
+            }
+        }
+        // -ftime-report separates its table from the diagnostics with a blank line
+        while (!diagnostics.empty() && diagnostics.back() == '\n')
+        {
+            diagnostics.pop_back();
+        }
+        if (!diagnostics.empty())
+        {
+            std::lock_guard<std::mutex> lock(output_mutex_);
+            std::cerr << diagnostics << std::endl;
+        }
+    }
+    
+    // Run a command and capture its standard output; returns the exit status
+    int capture_command(const std::string& command, std::string& output, bool echo = true) const
+    {
+        if (echo)
+        {
+            std::lock_guard<std::mutex> lock(output_mutex_);
+            std::cout << "Executing: " << command << std::endl;
+        }
+        FILE* pipe = popen(command.c_str(), "r");
+        if (!pipe)
+        {
+            return -1;
+        }
+        char buffer[65536];
+        size_t n;
+        while ((n = std::fread(buffer, 1, sizeof(buffer), pipe)) > 0)
+        {
+            output.append(buffer, n);
+        }
+        int status = pclose(pipe);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+    
+    static bool read_file(const fs::path& path, std::string& content)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open())
+        {
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        content = buffer.str();
+        return true;
+    }
+    
+    // Publish a file into the cache under its final name atomically, so concurrent builders never see partial objects
+    static void store_in_cache(const fs::path& from, const fs::path& to)
+    {
+        std::error_code ec;
+        fs::create_directories(to.parent_path(), ec);
+        // mkstemp makes the temporary name unique across threads, processes and the builders sharing the cache
+        std::string name = to.string() + ".tmp.XXXXXX";
+        int fd = mkstemp(name.data());
+        if (fd < 0)
+        {
+            return;
+        }
+        close(fd);
+        fs::path tmp = name;
+        fs::copy_file(from, tmp, fs::copy_options::overwrite_existing, ec);
+        if (!ec)
+        {
+            fs::rename(tmp, to, ec);
+        }
+        if (ec)
+        {
+            fs::remove(tmp, ec);
+        }
+    }
+    
+    static bool fetch_from_cache(const fs::path& cached_obj, const CompileUnit& unit)
+    {
+        fs::path cached_dep = cached_obj;
+        cached_dep.replace_extension(".d");
+        std::error_code ec;
+        if (!fs::exists(cached_obj, ec) || !fs::exists(cached_dep, ec))
+        {
+            return false;
+        }
+        fs::copy_file(cached_obj, unit.obj_file, fs::copy_options::overwrite_existing, ec);
+        if (!ec)
+        {
+            fs::copy_file(cached_dep, unit.dep_file, fs::copy_options::overwrite_existing, ec);
+        }
+        return !ec;
+    }
+    
+    fs::path cache_object_path(const std::string& key) const
+    {
+        return cache_dir_ / key.substr(0, 2) / (key + ".o");
+    }
+    
+    // Key shared by every lookup of this unit: compiler version, full flag set and (for -g builds) the directory baked into debug info
+    ContentHash base_key(const std::string& compile_flags) const
+    {
+        ContentHash hash;
+        hash.update(compiler_id_).update(compile_flags);
+        if (compile_flags.find("-g") != std::string::npos)
+        {
+            hash.update(fs::current_path().string());
+        }
+        return hash;
+    }
+    
+    // Direct mode: hash the source and every header it included last time, so a hit skips g++ entirely
+    bool direct_key(const CompileUnit& unit, const std::string& compile_flags, std::string& key, std::string& manifest_key) const
+    {
+        std::string content;
+        if (!read_file(unit.source, content))
+        {
+            return false;
+        }
+        ContentHash hash = base_key(compile_flags);
+        hash.update(unit.source).update(content);
+        manifest_key = hash.hex();
+        
+        std::string manifest;
+        if (!read_file(cache_dir_ / "manifests" / manifest_key.substr(0, 2) / manifest_key, manifest))
+        {
+            return false;
+        }
+        std::istringstream headers(manifest);
+        std::string header;
+        while (std::getline(headers, header))
+        {
+            if (!read_file(header, content))
+            {
+                return false;
+            }
+            hash.update(header).update(content);
+        }
+        // Headers pulled in through the PCH or module interfaces never show up in the unit's own depfile
+        for (const auto& pch_header : implicit_dependencies_)
+        {
+            if (fs::path(pch_header).extension() == ".gch" || fs::path(pch_header).extension() == ".gcm")
+            {
+                continue;
+            }
+            if (!read_file(pch_header, content))
+            {
+                return false;
+            }
+            hash.update(pch_header).update(content);
+        }
+        key = hash.hex();
+        return true;
+    }
+    
+    // Record which headers the unit included so the next run can look it up in direct mode
+    void store_manifest(const CompileUnit& unit, const std::string& compile_flags, const std::string& manifest_key) const
+    {
+        std::string manifest;
+        for (const auto& header : read_depfile(unit.dep_file))
+        {
+            if (header != unit.source && fs::path(header).extension() != ".gch")
+            {
+                manifest += header + "\n";
+            }
+        }
+        fs::path manifest_path = cache_dir_ / "manifests" / manifest_key.substr(0, 2) / manifest_key;
+        fs::path tmp = unit.obj_file;
+        tmp.replace_extension(".manifest");
+        {
+            std::ofstream out(tmp, std::ios::binary);
+            out << manifest;
+        }
+        store_in_cache(tmp, manifest_path);
+        fs::remove(tmp);
+        
+        std::string key, ignored;
+        if (direct_key(unit, compile_flags, key, ignored))
+        {
+            fs::path cached_obj = cache_object_path(key);
+            fs::path cached_dep = cached_obj;
+            cached_dep.replace_extension(".d");
+            store_in_cache(unit.obj_file, cached_obj);
+            store_in_cache(unit.dep_file, cached_dep);
+        }
+    }
+    
+    // Precompile the include/core umbrella header once per build type and flag set; returns the flags that force-include it
+    bool build_pch(const std::string& build_dir, const std::string& compile_flags, std::string& pch_flags)
+    {
+        const fs::path header = "include/core/core.hpp";
+        if (!fs::exists(header))
+        {
+            std::cerr << "--pch requires " << header.string() << std::endl;
+            return false;
+        }
+        fs::path pch_dir = fs::path(build_dir) / "pch" / ContentHash{}.update(compile_flags).hex();
+        fs::path gch_file = pch_dir / "core.hpp.gch";
+        fs::path dep_file = pch_dir / "core.hpp.d";
+        if (is_stale(header, gch_file, dep_file))
+        {
+            fs::create_directories(pch_dir);
+            std::string pch_cmd = "g++ " + compile_flags + " -x c++-header " + header.string() + " -MMD -MF " + dep_file.string() + " -o " + gch_file.string();
+            if (execute_command(pch_cmd, "pch", header.string(), dep_file.string()) != 0)
+            {
+                return false;
+            }
+        }
+        implicit_dependencies_ = read_depfile(dep_file);
+        implicit_dependencies_.push_back(gch_file.string());
+        // The PCH directory must be searched before include/core so that core.hpp.gch shadows core.hpp
+        pch_flags = "-I" + pch_dir.string() + " -include core.hpp -Winvalid-pch ";
+        return true;
+    }
+    
+    // Compile the include/core/modules interface units before any importer: every pooriayousefi.core.* unit listed
+    // in core.cppm (in order), then core.cppm itself. CMIs live per build type and flag set, found through a mapper file.
+    bool build_modules(const std::string& build_dir, const std::string& compile_flags, std::string& module_flags, std::vector<std::string>& module_objects)
+    {
+        const fs::path module_dir = "include/core/modules";
+        const fs::path primary = module_dir / "core.cppm";
+        if (!fs::exists(primary))
+        {
+            std::cerr << "--modules requires " << primary.string() << " (create the project with initcpp --modules)" << std::endl;
+            return false;
+        }
+        
+        std::vector<std::pair<std::string, fs::path>> units;
+        std::ifstream in(primary);
+        std::string line;
+        const std::string prefix = "export import ";
+        while (std::getline(in, line))
+        {
+            if (line.rfind(prefix, 0) == 0 && line.back() == ';')
+            {
+                std::string name = line.substr(prefix.size(), line.size() - prefix.size() - 1);
+                units.emplace_back(name, module_dir / ("core." + name.substr(name.rfind('.') + 1) + ".cppm"));
+            }
+        }
+        units.emplace_back("pooriayousefi.core", primary);
+        
+        fs::path cmi_dir = fs::path(build_dir) / "modules" / ContentHash{}.update(compile_flags).hex();
+        fs::create_directories(cmi_dir);
+        fs::path mapper = cmi_dir / "module.map";
+        {
+            std::ofstream map(mapper);
+            for (const auto& [name, file] : units)
+            {
+                map << name << ' ' << (cmi_dir / (name + ".gcm")).string() << '\n';
+            }
+        }
+        module_flags = " -fmodules-ts -fmodule-mapper=" + mapper.string() + " -DPOORIAYOUSEFI_CORE_USE_MODULES";
+        
+        implicit_dependencies_.clear();
+        bool rebuilt = false;
+        for (const auto& [name, file] : units)
+        {
+            fs::path obj_file = cmi_dir / (name + ".o");
+            fs::path dep_file = cmi_dir / (name + ".d");
+            fs::path cmi_file = cmi_dir / (name + ".gcm");
+            if (rebuilt || !fs::exists(cmi_file) || is_stale(file, obj_file, dep_file))
+            {
+                std::string module_cmd = "g++ " + compile_flags + module_flags + " -x c++ -MMD -MF " + dep_file.string() + " -c " + file.string() + " -o " + obj_file.string();
+                if (execute_command(module_cmd, "module", file.string(), dep_file.string()) != 0)
+                {
+                    return false;
+                }
+                // Importers of a rebuilt interface, including later interface units, must be rebuilt too
+                rebuilt = true;
+            }
+            auto prerequisites = read_depfile(dep_file);
+            implicit_dependencies_.insert(implicit_dependencies_.end(), prerequisites.begin(), prerequisites.end());
+            implicit_dependencies_.push_back(cmi_file.string());
+            module_objects.push_back(obj_file.string());
+        }
+        return true;
+    }
+    
+    // Compile one translation unit (timed with --time-report; -ftime-report stays out of the flags the cache is keyed on)
+    bool run_compiler(const CompileUnit& unit, const std::string& compile_flags) const
+    {
+        std::string compile_cmd = "g++ " + compile_flags + (time_phases_ ? " -ftime-report" : "") + " -MMD -MF " + unit.dep_file.string() + " -c " + unit.source + " -o " + unit.obj_file.string();
+        std::string time_file = time_phases_ ? unit.obj_file.string() + ".time" : "";
+        return execute_command(compile_cmd, "compile", unit.source, unit.dep_file.string(), time_file) == 0;
+    }
+    
+    bool compile_unit(const CompileUnit& unit, const std::string& compile_flags) const
+    {
+        if (!use_cache_)
+        {
+            return run_compiler(unit, compile_flags);
+        }
+        
+        std::string key, manifest_key;
+        if (direct_key(unit, compile_flags, key, manifest_key) && fetch_from_cache(cache_object_path(key), unit))
+        {
+            ++cache_hits_;
+            std::lock_guard<std::mutex> lock(output_mutex_);
+            std::cout << "Cache hit: " << unit.source << std::endl;
+            return true;
+        }
+        
+        // Preprocessed mode: key on the fully preprocessed translation unit, which also refreshes the depfile
+        std::string preprocessed;
+        std::string preprocess_cmd = "g++ " + compile_flags + " -E -MMD -MF " + unit.dep_file.string() + " -MT " + unit.obj_file.string() + " " + unit.source;
+        if (capture_command(preprocess_cmd, preprocessed, false) != 0)
+        {
+            return run_compiler(unit, compile_flags);
+        }
+        key = base_key(compile_flags).update(preprocessed).hex();
+        fs::path cached_obj = cache_object_path(key);
+        if (fetch_from_cache(cached_obj, unit))
+        {
+            ++cache_hits_;
+            {
+                std::lock_guard<std::mutex> lock(output_mutex_);
+                std::cout << "Cache hit (preprocessed): " << unit.source << std::endl;
+            }
+            store_manifest(unit, compile_flags, manifest_key);
+            return true;
+        }
+        
+        ++cache_misses_;
+        if (!run_compiler(unit, compile_flags))
+        {
+            return false;
+        }
+        fs::path cached_dep = cached_obj;
+        cached_dep.replace_extension(".d");
+        store_in_cache(unit.obj_file, cached_obj);
+        store_in_cache(unit.dep_file, cached_dep);
+        store_manifest(unit, compile_flags, manifest_key);
+        return true;
+    }
+    
+    // Run every job on a pool of up to jobs_ worker threads; stops handing out work after the first failure
+    bool execute_parallel(const std::vector<std::function<bool()>>& jobs) const
+    {
+        std::atomic<size_t> next_command{ 0 };
+        std::atomic<bool> failed{ false };
+        auto worker = [&]()
+        {
+            while (!failed)
+            {
+                size_t i = next_command++;
+                if (i >= jobs.size())
+                {
+                    break;
+                }
+                if (!jobs[i]())
+                {
+                    failed = true;
+                }
+            }
+        };
+        
+        size_t worker_count = std::min<size_t>(jobs_, jobs.size());
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < worker_count; ++i)
+        {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (auto& t : workers)
+        {
+            t.join();
+        }
+        return !failed;
+    }
+    
+    // Read the prerequisites of a make-style depfile written by -MMD -MF
+    static std::vector<std::string> read_depfile(const fs::path& dep_file)
+    {
+        std::ifstream in(dep_file);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        std::string text = buffer.str();
+        
+        std::vector<std::string> prerequisites;
+        size_t pos = text.find(": ");
+        if (pos == std::string::npos)
+        {
+            return prerequisites;
+        }
+        std::string current;
+        for (size_t i = pos + 2; i < text.size(); ++i)
+        {
+            char c = text[i];
+            if (c == '\\' && i + 1 < text.size() && (text[i + 1] == ' ' || text[i + 1] == '#'))
+            {
+                current += text[++i];
+            }
+            else if (c == '\\' && i + 1 < text.size() && text[i + 1] == '\n')
+            {
+                ++i;
+            }
+            else if (c == '\n')
+            {
+                // Only the first rule lists prerequisites; -fmodules-ts appends extra module mapping rules
+                break;
+            }
+            else if (c == '$' && i + 1 < text.size() && text[i + 1] == '$')
+            {
+                current += text[++i];
+            }
+            else if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+            {
+                if (!current.empty())
+                {
+                    prerequisites.push_back(current);
+                    current.clear();
+                }
+            }
+            else
+            {
+                current += c;
+            }
+        }
+        if (!current.empty())
+        {
+            prerequisites.push_back(current);
+        }
+        return prerequisites;
+    }
+    
+    // An object is stale when it is missing, or when its source or any header recorded in its depfile (or in the PCH) is newer
+    static bool is_stale(const fs::path& source, const fs::path& obj_file, const fs::path& dep_file, const std::vector<std::string>& extra_prerequisites = {})
+    {
+        if (!fs::exists(obj_file) || !fs::exists(dep_file))
+        {
+            return true;
+        }
+        auto obj_time = fs::last_write_time(obj_file);
+        if (fs::last_write_time(source) > obj_time)
+        {
+            return true;
+        }
+        auto prerequisites = read_depfile(dep_file);
+        prerequisites.insert(prerequisites.end(), extra_prerequisites.begin(), extra_prerequisites.end());
+        for (const auto& prerequisite : prerequisites)
+        {
+            std::error_code ec;
+            auto time = fs::last_write_time(prerequisite, ec);
+            if (ec || time > obj_time)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+public:
+    BuildSystem() : build_type_("debug"), output_type_("executable"), jobs_(std::max(1u, std::thread::hardware_concurrency())), use_cache_(true), use_pch_(false), use_modules_(fs::exists("include/core/modules/core.cppm")), bench_(false), trace_(false), lto_(false), native_(false)
+    {
+        // BUILDER_CACHE_DIR lets several checkouts (and CI runners) share one object cache
+        const char* cache_dir = std::getenv("BUILDER_CACHE_DIR");
+        cache_dir_ = (cache_dir && *cache_dir) ? fs::path(cache_dir) : fs::path("build/cache");
+    }
+    
+    void set_build_type(const std::string& type)
+    {
+        build_type_ = type;
+    }
+    
+    void set_output_type(const std::string& type)
+    {
+        output_type_ = type;
+    }
+    
+    void set_jobs(unsigned jobs)
+    {
+        jobs_ = std::max(1u, jobs);
+    }
+    
+    void set_cache(bool enabled)
+    {
+        use_cache_ = enabled;
+    }
+    
+    void set_pch(bool enabled)
+    {
+        use_pch_ = enabled;
+    }
+    
+    void set_modules(bool enabled)
+    {
+        use_modules_ = enabled;
+    }
+    
+    void set_bench(bool enabled)
+    {
+        bench_ = enabled;
+    }
+    
+    void set_trace(bool enabled)
+    {
+        trace_ = enabled;
+    }
+    
+    void set_lto(bool enabled)
+    {
+        lto_ = enabled;
+    }
+    
+    void set_native(bool enabled)
+    {
+        native_ = enabled;
+    }
+    
+    void set_pgo(const std::string& stage)
+    {
+        pgo_ = stage;
+    }
+    
+    void set_linker(const std::string& linker)
+    {
+        linker_ = linker;
+    }
+    
+    void set_time_report(bool enabled, bool phases)
+    {
+        time_report_ = enabled;
+        time_phases_ = phases;
+    }
+    
+    int build()
+    {
+        int result = build_targets();
+        if (time_report_)
+        {
+            write_time_report("build/" + (bench_ ? std::string("bench") : build_type_));
+        }
+        return result;
+    }
+    
+    // Print the slowest translation units and the headers that cost the most, and write every measured command to
+    // <build_dir>/time_report.json. GCC has no per-header timing, so a header is charged the parsing time (the wall
+    // time without -ftime-report) of every translation unit that includes it.
+    void write_time_report(const std::string& build_dir) const
+    {
+        std::vector<const CommandTiming*> units;
+        std::map<std::string, std::pair<size_t, double>> headers;
+        double total_wall = 0.0;
+        for (const auto& timing : timings_)
+        {
+            total_wall += timing.wall_seconds;
+            if (timing.dep_file.empty())
+            {
+                continue;
+            }
+            units.push_back(&timing);
+            double cost = timing.has_phases ? timing.parsing_seconds : timing.wall_seconds;
+            for (const auto& prerequisite : read_depfile(timing.dep_file))
+            {
+                if (prerequisite != timing.target)
+                {
+                    auto& [count, seconds] = headers[prerequisite];
+                    ++count;
+                    seconds += cost;
+                }
+            }
+        }
+        std::sort(units.begin(), units.end(), [](const CommandTiming* a, const CommandTiming* b) { return a->wall_seconds > b->wall_seconds; });
+        std::vector<std::pair<std::string, std::pair<size_t, double>>> ranked(headers.begin(), headers.end());
+        std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) { return a.second.second > b.second.second; });
+        
+        char line[512];
+        std::snprintf(line, sizeof(line), "\nTime report: %zu commands, %.2f s of command wall time", timings_.size(), total_wall);
+        std::cout << line << (cache_hits_ ? " (cache hits are not timed)\n" : "\n");
+        std::cout << "Slowest translation units:\n";
+        std::snprintf(line, sizeof(line), "  %9s %9s %9s %10s%s  %s\n", "wall s", "user s", "sys s", "peak RSS", time_phases_ ? "   parse s   templ s   gen s" : "", "source");
+        std::cout << line;
+        for (size_t i = 0; i < std::min<size_t>(units.size(), 10); ++i)
+        {
+            const CommandTiming& unit = *units[i];
+            char phases[64] = "";
+            if (unit.has_phases)
+            {
+                std::snprintf(phases, sizeof(phases), " %9.2f %9.2f %7.2f", unit.parsing_seconds, unit.template_seconds, unit.codegen_seconds);
+            }
+            std::snprintf(line, sizeof(line), "  %9.2f %9.2f %9.2f %7ld MB%s  %s (%s)\n", unit.wall_seconds, unit.user_seconds, unit.system_seconds, unit.peak_rss_kb / 1024, phases, unit.target.c_str(), unit.kind.c_str());
+            std::cout << line;
+        }
+        if (!ranked.empty())
+        {
+            std::cout << "Most expensive headers (" << (time_phases_ ? "parsing" : "wall") << " time of the translation units including them):\n";
+            for (size_t i = 0; i < std::min<size_t>(ranked.size(), 10); ++i)
+            {
+                std::snprintf(line, sizeof(line), "  %9.2f s in %3zu TUs  %s\n", ranked[i].second.second, ranked[i].second.first, ranked[i].first.c_str());
+                std::cout << line;
+            }
+        }
+        for (const auto& timing : timings_)
+        {
+            if (timing.kind == "link" || timing.kind == "archive")
+            {
+                std::snprintf(line, sizeof(line), "%s: %.2f s wall, %.2f s user, %ld MB peak RSS (%s)\n", timing.kind == "link" ? "Link" : "Archive", timing.wall_seconds, timing.user_seconds, timing.peak_rss_kb / 1024, timing.target.c_str());
+                std::cout << line;
+            }
+        }
+        
+        auto quoted = [](const std::string& text)
+        {
+            std::string out = "\"";
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    out += '\\';
+                }
+                out += c;
+            }
+            return out + "\"";
+        };
+        fs::create_directories(build_dir);
+        const fs::path json_path = fs::path(build_dir) / "time_report.json";
+        std::ofstream json(json_path);
+        json << "{\n  \"commands\": [";
+        for (size_t i = 0; i < timings_.size(); ++i)
+        {
+            const CommandTiming& timing = timings_[i];
+            std::snprintf(line, sizeof(line), "\"wall_seconds\": %.4f, \"user_seconds\": %.4f, \"system_seconds\": %.4f, \"peak_rss_kb\": %ld", timing.wall_seconds, timing.user_seconds, timing.system_seconds, timing.peak_rss_kb);
+            json << (i ? "," : "") << "\n    { \"kind\": " << quoted(timing.kind) << ", \"target\": " << quoted(timing.target) << ", " << line;
+            if (timing.has_phases)
+            {
+                std::snprintf(line, sizeof(line), ", \"parsing_seconds\": %.4f, \"template_instantiation_seconds\": %.4f, \"opt_and_generate_seconds\": %.4f", timing.parsing_seconds, timing.template_seconds, timing.codegen_seconds);
+                json << line;
+            }
+            json << " }";
+        }
+        json << "\n  ],\n  \"headers\": [";
+        for (size_t i = 0; i < ranked.size(); ++i)
+        {
+            std::snprintf(line, sizeof(line), "\"translation_units\": %zu, \"seconds\": %.4f", ranked[i].second.first, ranked[i].second.second);
+            json << (i ? "," : "") << "\n    { \"path\": " << quoted(ranked[i].first) << ", " << line << " }";
+        }
+        json << "\n  ]\n}\n";
+        std::cout << "Time report: " << json_path.string() << std::endl;
+    }
+    
+    int build_targets()
+    {
+        // Benchmarks build bench/ instead of src/ into build/bench as an executable. They include the core headers
+        // textually, so the module interface units (compiled without -march=native) are not needed
+        if (bench_)
+        {
+            output_type_ = "executable";
+            use_modules_ = false;
+        }
+        const std::string source_dir = bench_ ? "bench" : "src";
+        std::string build_dir = "build/" + (bench_ ? std::string("bench") : build_type_);
+        fs::create_directories(build_dir);
+        
+        std::vector<std::string> source_files;
+        
+        // Collect all source files
+        for (const auto& entry : fs::recursive_directory_iterator(source_dir))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".cpp")
+            {
+                source_files.push_back(entry.path().string());
+            }
+        }
+        std::sort(source_files.begin(), source_files.end());
+        
+        std::string compile_flags;
+        std::string link_flags;
+        std::string output_name;
+        
+        if (bench_)
+        {
+            compile_flags = "-O3 -march=native -DNDEBUG";
+        }
+        else if (build_type_ == "debug")
+        {
+            compile_flags = "-g -O0 -DDEBUG";
+        }
+        else if (build_type_ == "release")
+        {
+            compile_flags = "-O3 -DNDEBUG";
+        }
+        
+        if (native_ && !bench_)
+        {
+            compile_flags += " -march=native";
+            if (use_modules_)
+            {
+                // GCC 12 runs out of module source locations (internal compiler error) when the core interfaces
+                // are compiled with -march=native, so native builds include the core headers textually
+                std::cout << "--native builds use textual includes of the core headers instead of modules" << std::endl;
+                use_modules_ = false;
+            }
+        }
+        
+        // Profile-guided optimization: --pgo-gen builds an instrumented binary whose runs write .gcda files
+        // under build/pgo (named after the object paths); --pgo-use rebuilds with them. The profile only matches
+        // code compiled the same way, so the options that shape the code are stamped next to it
+        const fs::path pgo_dir = fs::absolute("build/pgo");
+        const fs::path pgo_stamp = pgo_dir / "options.txt";
+        const std::string pgo_options = compile_flags + " " + output_type_ + (use_modules_ ? " modules" : "") + (trace_ ? " trace" : "") + (use_pch_ ? " pch" : "");
+        if (pgo_ == "gen")
+        {
+            compile_flags += " -fprofile-generate=" + pgo_dir.string() + " -fprofile-update=prefer-atomic";
+        }
+        else if (pgo_ == "use")
+        {
+            bool profiled = false;
+            if (fs::exists(pgo_dir))
+            {
+                for (const auto& entry : fs::directory_iterator(pgo_dir))
+                {
+                    profiled = profiled || entry.path().extension() == ".gcda";
+                }
+            }
+            if (!profiled)
+            {
+                std::cerr << "--pgo-use needs the profile in " << pgo_dir.string() << ": build with --pgo-gen and run the program first" << std::endl;
+                return 1;
+            }
+            std::string recorded;
+            {
+                std::ifstream stamp(pgo_stamp);
+                std::getline(stamp, recorded);
+            }
+            if (recorded != pgo_options)
+            {
+                std::cerr << "The profile in " << pgo_dir.string() << " was recorded from a build with other options (" << recorded << "); rebuild with --pgo-gen and the options of this build (" << pgo_options << ")" << std::endl;
+                return 1;
+            }
+            compile_flags += " -fprofile-use=" + pgo_dir.string() + " -fprofile-correction -Wno-missing-profile";
+        }
+        if (!pgo_.empty())
+        {
+            // The profile is an input the cache key does not cover
+            use_cache_ = false;
+        }
+        
+        // The optimization flags are repeated at link time, where -flto compiles the whole program
+        // (-flto=auto runs the LTRANS partitions in parallel)
+        if (lto_)
+        {
+            compile_flags += " -flto=auto";
+            if (output_type_ == "static")
+            {
+                // Fat objects keep regular code next to the LTO bytecode, so non-LTO links of the library work
+                compile_flags += " -ffat-lto-objects";
+            }
+        }
+        if (lto_ || !pgo_.empty())
+        {
+            link_flags += " " + compile_flags;
+        }
+        if (!linker_.empty())
+        {
+            link_flags += " -fuse-ld=" + linker_;
+        }
+        
+        // Common flags
+        compile_flags += " -std=c++23 -Wall -Wextra -Wpedantic -Iinclude -Iinclude/core";
+        if (trace_)
+        {
+            // Turns on core::trace zones, counters and histograms (and the asyncops resume points)
+            compile_flags += " -DPOORIAYOUSEFI_CORE_TRACING";
+        }
+        
+        if (output_type_ == "executable")
+        {
+            output_name = build_dir + "/" + "{{PROJECT_NAME}}" + (bench_ ? "_bench" : "");
+            link_flags += " -static";  // Static executable
+        }
+        else if (output_type_ == "static")
+        {
+            output_name = build_dir + "/lib" + "{{PROJECT_NAME}}" + ".a";
+        }
+        else if (output_type_ == "dynamic")
+        {
+            output_name = build_dir + "/lib" + "{{PROJECT_NAME}}" + ".so";
+            compile_flags += " -fPIC";
+            link_flags += " -shared";
+        }
+        
+        std::string profile = bench_ ? std::string("bench") : build_type_;
+        profile += std::string(lto_ ? "+lto" : "") + (native_ ? "+native" : "") + (pgo_.empty() ? "" : "+pgo-" + pgo_);
+        std::cout << "Building {{PROJECT_NAME}} (" << profile << ", " << output_type_ << ", -j " << jobs_ << ")..." << std::endl;
+        
+        std::vector<std::string> module_objects;
+        if (use_pch_ && use_modules_)
+        {
+            std::cerr << "--pch and --modules are mutually exclusive (use --no-modules to build the textual-include path)" << std::endl;
+            return 1;
+        }
+        if (use_modules_ && time_phases_)
+        {
+            // GCC 12 fails with an internal compiler error in its phase timers while compiling a module importer
+            std::cout << "--time-report=phases is not available in module builds; timing commands without phases" << std::endl;
+            time_phases_ = false;
+        }
+        if (use_modules_)
+        {
+            std::string module_flags;
+            if (!build_modules(build_dir, compile_flags, module_flags, module_objects))
+            {
+                return 1;
+            }
+            compile_flags += module_flags;
+            // Importing sources cannot be preprocessed on their own, so module builds bypass the object cache
+            use_cache_ = false;
+        }
+        if (use_pch_)
+        {
+            std::string pch_flags;
+            if (!build_pch(build_dir, compile_flags, pch_flags))
+            {
+                return 1;
+            }
+            compile_flags = pch_flags + compile_flags;
+        }
+        
+        // Objects built with different flags (e.g. switching to --dynamic adds -fPIC) are all stale
+        fs::path flags_stamp = fs::path(build_dir) / "compile_flags.txt";
+        std::string previous_flags;
+        {
+            std::ifstream stamp(flags_stamp);
+            std::getline(stamp, previous_flags);
+        }
+        bool flags_changed = previous_flags != compile_flags;
+        
+        if (use_cache_)
+        {
+            fs::create_directories(cache_dir_);
+            std::string version;
+            capture_command("g++ --version", version, false);
+            compiler_id_ = version;
+        }
+        
+        // Compile every stale translation unit to its own object file, mirroring the src/ tree
+        std::vector<std::string> object_files;
+        std::vector<std::function<bool()>> compile_jobs;
+        for (const auto& source : source_files)
+        {
+            fs::path obj_path = fs::path(build_dir) / "obj" / fs::relative(source, source_dir);
+            obj_path.replace_extension(".o");
+            fs::path dep_path = obj_path;
+            dep_path.replace_extension(".d");
+            object_files.push_back(obj_path.string());
+            if (flags_changed || is_stale(source, obj_path, dep_path, implicit_dependencies_))
+            {
+                fs::create_directories(obj_path.parent_path());
+                compile_jobs.push_back([this, unit = CompileUnit{ source, obj_path, dep_path }, &compile_flags]()
+                {
+                    return compile_unit(unit, compile_flags);
+                });
+            }
+        }
+        
+        if (pgo_ == "gen" && !compile_jobs.empty())
+        {
+            // Counters of the previous instrumented build no longer match the new objects
+            fs::remove_all(pgo_dir);
+            fs::create_directories(pgo_dir);
+            std::ofstream stamp(pgo_stamp);
+            stamp << pgo_options << '\n';
+        }
+        
+        std::cout << "Compiling " << compile_jobs.size() << " of " << source_files.size() << " translation units" << std::endl;
+        bool compiled = execute_parallel(compile_jobs);
+        if (use_cache_ && !compile_jobs.empty())
+        {
+            std::cout << "Cache: " << cache_hits_ << " hits, " << cache_misses_ << " misses (" << cache_dir_.string() << ")" << std::endl;
+        }
+        if (!compiled)
+        {
+            return 1;
+        }
+        if (flags_changed)
+        {
+            std::ofstream stamp(flags_stamp);
+            stamp << compile_flags << '\n';
+        }
+        
+        object_files.insert(object_files.end(), module_objects.begin(), module_objects.end());
+        
+        // The whole archive or link command goes into a stamp next to compile_flags.txt, so switching
+        // the linker, -static/-shared or the LTO/PGO link flags relinks even when no object changed
+        std::string link_cmd;
+        if (output_type_ == "static")
+        {
+            // gcc-ar loads the LTO plugin, so the archive indexes LTO objects
+            link_cmd = (lto_ ? "gcc-ar rcs " : "ar rcs ") + output_name;
+            for (const auto& obj : object_files)
+            {
+                link_cmd += " " + obj;
+            }
+        }
+        else
+        {
+            link_cmd = "g++ ";
+            for (const auto& obj : object_files)
+            {
+                link_cmd += obj + " ";
+            }
+            link_cmd += link_flags + " -o " + output_name;
+        }
+        fs::path link_stamp = fs::path(build_dir) / "link_flags.txt";
+        std::string previous_link;
+        {
+            std::ifstream stamp(link_stamp);
+            std::getline(stamp, previous_link);
+        }
+        
+        // Relink only when an object or the link command changed or the output is missing/older than its objects
+        bool relink = !compile_jobs.empty() || previous_link != link_cmd || !fs::exists(output_name);
+        for (const auto& obj : object_files)
+        {
+            if (relink)
+            {
+                break;
+            }
+            relink = fs::last_write_time(obj) > fs::last_write_time(output_name);
+        }
+        if (!relink)
+        {
+            std::cout << "Up to date: " << output_name << std::endl;
+            return 0;
         }
-        else if constexpr (!std::is_void_v<std::invoke_result_t<F, Args...>>)
+        
+        if (output_type_ == "static")
         {
-            auto ti{ std::chrono::high_resolution_clock::now() };
-            auto retval{ std::invoke(std::forward<F>(f), std::forward<Args>(args)...) };
-            auto tf{ std::chrono::high_resolution_clock::now() };
-            return std::make_pair(std::move(retval), std::chrono::duration<double>(tf - ti).count());
+            // Create static library
+            fs::remove(output_name);
+            if (execute_command(link_cmd, "archive", output_name) != 0)
+            {
+                return 1;
+            }
+            std::cout << "Static library built: " << output_name << std::endl;
         }
-    }
-
-    namespace convert
-    {
-        template<std::floating_point T> constexpr T degrees_to_radians(T x) { return x * std::numbers::pi_v<T> / (T)180; }
-        template<std::floating_point T> constexpr T radians_to_degrees(T x) { return x * (T)180 / std::numbers::pi_v<T>; }
-        template<std::floating_point T> constexpr T Celsius_to_Fahrenheit(T x) { return (x * (T)9 / (T)5) + (T)32; }
-        template<std::floating_point T> constexpr T Fahrenheit_to_Celsius(T x) { return (x - (T)32) * (T)5 / (T)9; }
-    }
-
-    template<std::integral I> 
-    constexpr void countdown(I nsec)
-    {
-        std::cout << "\nT-" << nsec << ' ';
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        for (auto i{ static_cast<int64_t>(nsec) - static_cast<int64_t>(1) }; i >= static_cast<int64_t>(0); --i)
+        else
         {
-            std::cout << i << ' ';
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            // Link executable or dynamic library
+            if (execute_command(link_cmd, "link", output_name) != 0)
+            {
+                return 1;
+            }
+            if (output_type_ == "executable")
+            {
+                std::cout << "Executable built: " << output_name << std::endl;
+                if (pgo_ == "gen")
+                {
+                    std::cout << "Run it on a representative workload, then rebuild with --pgo-use" << std::endl;
+                }
+            }
+            else
+            {
+                std::cout << "Dynamic library built: " << output_name << std::endl;
+            }
         }
+        
+        // Written only after a successful link, so a failed one is retried on the next build
+        std::ofstream stamp(link_stamp);
+        stamp << link_cmd << '\n';
+        return 0;
     }
-
-    template<std::input_or_output_iterator It, std::invocable<std::iter_value_t<It>&> F>
-    constexpr void iterate(It begin, size_t n, size_t step_size, F&& f)
+    
+    // Runs the benchmark executable from the project root; it writes build/bench/results.{json,csv} and compares
+    // the medians with bench/baseline.csv, which its first run pins
+    int run_benchmarks() const
     {
-        size_t c(0);
-        auto it = begin;
-        do
-        {
-            std::invoke(std::forward<F>(f), *it);
-            c++;
-        } while (c < n && [&]() { it = std::ranges::next(it, step_size); return true; }());
+        return execute_command("./build/bench/{{PROJECT_NAME}}_bench build/bench bench/baseline.csv") == 0 ? 0 : 1;
     }
-}
-
-namespace std
-{
-	template<> struct hash<byte>
-	{
-		constexpr const size_t operator()(const byte& b) const
-		{
-			hash<size_t> hasher{};
-            return hasher(to_integer<size_t>(b));
-		}
-	};
-
-	template<> struct equal_to<byte>
-	{
-		constexpr const bool operator()(const byte& lb, const byte& rb) const
-		{
-			return to_integer<size_t>(lb) == to_integer<size_t>(rb);
-		}
-	};
-
-	template<class T> struct hash<reference_wrapper<const T>>
-	{
-		constexpr const size_t operator()(const reference_wrapper<const T>& ref) const
-		{
-			hash<T> hasher{};
-			return hasher(ref.get());
-		}
-	};
+};
 
-	template<class T> struct equal_to<reference_wrapper<const T>>
-	{
-		constexpr const bool operator()(const reference_wrapper<const T>& lhs, const reference_wrapper<const T>& rhs) const
-		{
-			return lhs.get() == rhs.get();
-		}
-	};
-}
-)";
-
-        // Write all header files
-        write_file(project_path + "/include/core/asyncops.hpp", asyncops_content);
-        write_file(project_path + "/include/core/raiiiofsw.hpp", raiiiofsw_content);
-        write_file(project_path + "/include/core/stringformers.hpp", stringformers_content);
-        write_file(project_path + "/include/core/utilities.hpp", utilities_content);
-        
-        std::cout << "Template header files created!" << std::endl;
-    };
-
-    // Create source file
-    auto create_source_files = [&]()
-    {
-        std::cout << "Creating source files..." << std::endl;
-        
-        // Main source file template
-        std::string main_cpp_template = R"(
-#include "asyncops.hpp"
-#include "raiiiofsw.hpp"
-#include "stringformers.hpp"
-#include "utilities.hpp"
-
-// entry-point
-int main()
+int main(int argc, char* argv[])
 {
     try
     {
-        // start here ...
+        BuildSystem builder;
+        bool bench = false;
         
-        return EXIT_SUCCESS;
+        // Parse command line arguments
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--debug")
+            {
+                builder.set_build_type("debug");
+            }
+            else if (arg == "--release")
+            {
+                builder.set_build_type("release");
+            }
+            else if (arg == "--release-lto")
+            {
+                builder.set_build_type("release");
+                builder.set_lto(true);
+            }
+            else if (arg == "--pgo-gen" || arg == "--pgo-use")
+            {
+                builder.set_build_type("release");
+                builder.set_pgo(arg.substr(6));
+            }
+            else if (arg == "--native")
+            {
+                builder.set_native(true);
+            }
+            else if (arg.rfind("--linker=", 0) == 0)
+            {
+                std::string linker = arg.substr(9);
+                if (linker != "mold" && linker != "lld" && linker != "gold" && linker != "bfd")
+                {
+                    std::cerr << "Unknown linker: " << linker << " (expected mold, lld, gold or bfd)" << std::endl;
+                    return 1;
+                }
+                builder.set_linker(linker);
+            }
+            else if (arg == "--executable")
+            {
+                builder.set_output_type("executable");
+            }
+            else if (arg == "--static")
+            {
+                builder.set_output_type("static");
+            }
+            else if (arg == "--dynamic")
+            {
+                builder.set_output_type("dynamic");
+            }
+            else if (arg == "--pch")
+            {
+                builder.set_pch(true);
+            }
+            else if (arg == "--modules")
+            {
+                builder.set_modules(true);
+            }
+            else if (arg == "--no-modules")
+            {
+                builder.set_modules(false);
+            }
+            else if (arg == "--bench")
+            {
+                builder.set_bench(true);
+                bench = true;
+            }
+            else if (arg == "--trace")
+            {
+                builder.set_trace(true);
+            }
+            else if (arg == "--time-report" || arg == "--time-report=phases")
+            {
+                builder.set_time_report(true, arg == "--time-report=phases");
+            }
+            else if (arg == "--no-cache")
+            {
+                builder.set_cache(false);
+            }
+            else if (arg == "-j" || arg == "--jobs")
+            {
+                if (i + 1 >= argc)
+                {
+                    std::cerr << "Missing value for " << arg << std::endl;
+                    return 1;
+                }
+                builder.set_jobs(static_cast<unsigned>(std::stoul(argv[++i])));
+            }
+            else if (arg.rfind("-j", 0) == 0)
+            {
+                builder.set_jobs(static_cast<unsigned>(std::stoul(arg.substr(2))));
+            }
+            else if (arg == "--help")
+            {
+                std::cout << "Usage: " << argv[0] << " [options]\n";
+                std::cout << "Options:\n";
+                std::cout << "  --debug          Build in debug mode\n";
+                std::cout << "  --release        Build in release mode\n";
+                std::cout << "  --release-lto    Release build with link-time optimization (-flto=auto, parallel LTRANS)\n";
+                std::cout << "  --pgo-gen        Release build instrumented to write a profile to build/pgo when it runs\n";
+                std::cout << "  --pgo-use        Release build optimized with the profile in build/pgo (combines with --release-lto)\n";
+                std::cout << "  --native         Tune for the build machine's CPU (-march=native)\n";
+                std::cout << "  --linker=NAME    Link with mold, lld, gold or bfd (-fuse-ld=NAME)\n";
+                std::cout << "  --executable     Build static executable (default)\n";
+                std::cout << "  --static         Build static library\n";
+                std::cout << "  --dynamic        Build dynamic library\n";
+                std::cout << "  -j, --jobs N     Compile up to N translation units in parallel (default: all cores)\n";
+                std::cout << "  --pch            Precompile include/core/core.hpp and force-include it in every source\n";
+                std::cout << "  --modules        Build include/core/modules and import pooriayousefi.core (default if present; with GCC 12\n";
+                std::cout << "                   the SSSE3/AVX2 kernels of stringformers.hpp are then left out and DelimiterSet runs scalar)\n";
+                std::cout << "  --no-modules     Use textual #include of the core headers even if modules are present\n";
+                std::cout << "  --bench          Build bench/ at -O3 -march=native into build/bench and run it against bench/baseline.csv\n";
+                std::cout << "  --trace          Define POORIAYOUSEFI_CORE_TRACING so core::trace records (see include/core/tracing.hpp)\n";
+                std::cout << "  --time-report    Time every compile and link (wall, CPU, peak RSS); print the slowest TUs and headers\n";
+                std::cout << "                   and write build/<type>/time_report.json (=phases adds GCC's -ftime-report phases)\n";
+                std::cout << "  --no-cache       Bypass the object cache ($BUILDER_CACHE_DIR, default build/cache)\n";
+                std::cout << "  --help           Show this help message\n";
+                return 0;
+            }
+            else
+            {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return 1;
+            }
+        }
+        
+        int result = builder.build();
+        if (result == 0)
+        {
+            std::cout << "Build completed!" << std::endl;
+        }
+        if (result == 0 && bench)
+        {
+            result = builder.run_benchmarks();
+        }
+        return result;
     }
-    catch (const std::exception& xxx)
+    catch (const std::exception& e)
     {
-        std::cerr << "Error: " << xxx.what() << std::endl;
-        return EXIT_FAILURE;
+        std::cerr << "Build failed: " << e.what() << std::endl;
+        return 1;
     }
 }
-    )";
-        
-        write_file(project_path + "/src/main.cpp", main_cpp_template);
-    };
-
-    // Create build system
-    auto create_build_system = [&]()
-    {
-        std::cout << "Creating build system..." << std::endl;
+)builder";
         
-        // Create C++ build system executable
-        std::string build_cpp = "#include <iostream>\n";
-        build_cpp += "#include <string>\n";
-        build_cpp += "#include <vector>\n";
-        build_cpp += "#include <cstdlib>\n";
-        build_cpp += "#include <filesystem>\n\n";
-        build_cpp += "namespace fs = std::filesystem;\n\n";
-        build_cpp += "class BuildSystem\n";
-        build_cpp += "{\n";
-        build_cpp += "private:\n";
-        build_cpp += "    std::string build_type_;\n";
-        build_cpp += "    std::string output_type_;\n";
-        build_cpp += "    \n";
-        build_cpp += "    int execute_command(const std::string& command) const\n";
-        build_cpp += "    {\n";
-        build_cpp += "        std::cout << \"Executing: \" << command << std::endl;\n";
-        build_cpp += "        return std::system(command.c_str());\n";
-        build_cpp += "    }\n";
-        build_cpp += "    \n";
-        build_cpp += "public:\n";
-        build_cpp += "    BuildSystem() : build_type_(\"debug\"), output_type_(\"executable\")\n";
-        build_cpp += "    {\n";
-        build_cpp += "    }\n";
-        build_cpp += "    \n";
-        build_cpp += "    void set_build_type(const std::string& type)\n";
-        build_cpp += "    {\n";
-        build_cpp += "        build_type_ = type;\n";
-        build_cpp += "    }\n";
-        build_cpp += "    \n";
-        build_cpp += "    void set_output_type(const std::string& type)\n";
-        build_cpp += "    {\n";
-        build_cpp += "        output_type_ = type;\n";
-        build_cpp += "    }\n";
-        build_cpp += "    \n";
-        build_cpp += "    int build()\n";
-        build_cpp += "    {\n";
-        build_cpp += "        std::string build_dir = \"build/\" + build_type_;\n";
-        build_cpp += "        fs::create_directories(build_dir);\n";
-        build_cpp += "        \n";
-        build_cpp += "        std::vector<std::string> source_files;\n";
-        build_cpp += "        \n";
-        build_cpp += "        // Collect all source files\n";
-        build_cpp += "        for (const auto& entry : fs::recursive_directory_iterator(\"src\"))\n";
-        build_cpp += "        {\n";
-        build_cpp += "            if (entry.is_regular_file() && entry.path().extension() == \".cpp\")\n";
-        build_cpp += "            {\n";
-        build_cpp += "                source_files.push_back(entry.path().string());\n";
-        build_cpp += "            }\n";
-        build_cpp += "        }\n";
-        build_cpp += "        \n";
-        build_cpp += "        std::string compile_flags;\n";
-        build_cpp += "        std::string link_flags;\n";
-        build_cpp += "        std::string output_name;\n";
-        build_cpp += "        \n";
-        build_cpp += "        if (build_type_ == \"debug\")\n";
-        build_cpp += "        {\n";
-        build_cpp += "            compile_flags = \"-g -O0 -DDEBUG\";\n";
-        build_cpp += "        }\n";
-        build_cpp += "        else if (build_type_ == \"release\")\n";
-        build_cpp += "        {\n";
-        build_cpp += "            compile_flags = \"-O3 -DNDEBUG\";\n";
-        build_cpp += "        }\n";
-        build_cpp += "        \n";
-        build_cpp += "        // Common flags\n";
-        build_cpp += "        compile_flags += \" -std=c++23 -Wall -Wextra -Wpedantic -Iinclude -Iinclude/core\";\n";
-        build_cpp += "        \n";
-        build_cpp += "        if (output_type_ == \"executable\")\n";
-        build_cpp += "        {\n";
-        build_cpp += "            output_name = build_dir + \"/\" + \"" + project_name + "\";\n";
-        build_cpp += "        }\n";
-        build_cpp += "        else if (output_type_ == \"static\")\n";
-        build_cpp += "        {\n";
-        build_cpp += "            output_name = build_dir + \"/lib\" + \"" + project_name + "\" + \".a\";\n";
-        build_cpp += "            compile_flags += \" -c\";\n";
-        build_cpp += "        }\n";
-        build_cpp += "        else if (output_type_ == \"dynamic\")\n";
-        build_cpp += "        {\n";
-        build_cpp += "            output_name = build_dir + \"/lib\" + \"" + project_name + "\" + \".so\";\n";
-        build_cpp += "            compile_flags += \" -fPIC\";\n";
-        build_cpp += "            link_flags += \" -shared\";\n";
-        build_cpp += "        }\n";
-        build_cpp += "        \n";
-        build_cpp += "        std::cout << \"Building " + project_name + " (\" << build_type_ << \", \" << output_type_ << \")...\" << std::endl;\n";
-        build_cpp += "        \n";
-        build_cpp += "        if (output_type_ == \"static\")\n";
-        build_cpp += "        {\n";
-        build_cpp += "            // Compile to object files first\n";
-        build_cpp += "            std::vector<std::string> object_files;\n";
-        build_cpp += "            for (const auto& source : source_files)\n";
-        build_cpp += "            {\n";
-        build_cpp += "                std::string obj_file = build_dir + \"/\" + fs::path(source).stem().string() + \".o\";\n";
-        build_cpp += "                object_files.push_back(obj_file);\n";
-        build_cpp += "                \n";
-        build_cpp += "                std::string compile_cmd = \"g++ \" + compile_flags + \" \" + source + \" -o \" + obj_file;\n";
-        build_cpp += "                if (execute_command(compile_cmd) != 0)\n";
-        build_cpp += "                {\n";
-        build_cpp += "                    return 1;\n";
-        build_cpp += "                }\n";
-        build_cpp += "            }\n";
-        build_cpp += "            \n";
-        build_cpp += "            // Create static library\n";
-        build_cpp += "            std::string ar_cmd = \"ar rcs \" + output_name;\n";
-        build_cpp += "            for (const auto& obj : object_files)\n";
-        build_cpp += "            {\n";
-        build_cpp += "                ar_cmd += \" \" + obj;\n";
-        build_cpp += "            }\n";
-        build_cpp += "            \n";
-        build_cpp += "            if (execute_command(ar_cmd) == 0)\n";
-        build_cpp += "            {\n";
-        build_cpp += "                std::cout << \"Static library built: \" << output_name << std::endl;\n";
-        build_cpp += "                return 0;\n";
-        build_cpp += "            }\n";
-        build_cpp += "            return 1;\n";
-        build_cpp += "        }\n";
-        build_cpp += "        else\n";
-        build_cpp += "        {\n";
-        build_cpp += "            // Build executable or dynamic library\n";
-        build_cpp += "            std::string build_cmd = \"g++ \" + compile_flags + \" \";\n";
-        build_cpp += "            for (const auto& source : source_files)\n";
-        build_cpp += "            {\n";
-        build_cpp += "                build_cmd += source + \" \";\n";
-        build_cpp += "            }\n";
-        build_cpp += "            build_cmd += link_flags + \" -o \" + output_name;\n";
-        build_cpp += "            \n";
-        build_cpp += "            if (output_type_ == \"executable\")\n";
-        build_cpp += "            {\n";
-        build_cpp += "                build_cmd += \" -static\";  // Static executable\n";
-        build_cpp += "            }\n";
-        build_cpp += "            \n";
-        build_cpp += "            if (execute_command(build_cmd) == 0)\n";
-        build_cpp += "            {\n";
-        build_cpp += "                if (output_type_ == \"executable\")\n";
-        build_cpp += "                {\n";
-        build_cpp += "                    std::cout << \"Executable built: \" << output_name << std::endl;\n";
-        build_cpp += "                }\n";
-        build_cpp += "                else\n";
-        build_cpp += "                {\n";
-        build_cpp += "                    std::cout << \"Dynamic library built: \" << output_name << std::endl;\n";
-        build_cpp += "                }\n";
-        build_cpp += "                return 0;\n";
-        build_cpp += "            }\n";
-        build_cpp += "            return 1;\n";
-        build_cpp += "        }\n";
-        build_cpp += "    }\n";
-        build_cpp += "};\n\n";
-        build_cpp += "int main(int argc, char* argv[])\n";
-        build_cpp += "{\n";
-        build_cpp += "    try\n";
-        build_cpp += "    {\n";
-        build_cpp += "        BuildSystem builder;\n";
-        build_cpp += "        \n";
-        build_cpp += "        // Parse command line arguments\n";
-        build_cpp += "        for (int i = 1; i < argc; ++i)\n";
-        build_cpp += "        {\n";
-        build_cpp += "            std::string arg = argv[i];\n";
-        build_cpp += "            if (arg == \"--debug\")\n";
-        build_cpp += "            {\n";
-        build_cpp += "                builder.set_build_type(\"debug\");\n";
-        build_cpp += "            }\n";
-        build_cpp += "            else if (arg == \"--release\")\n";
-        build_cpp += "            {\n";
-        build_cpp += "                builder.set_build_type(\"release\");\n";
-        build_cpp += "            }\n";
-        build_cpp += "            else if (arg == \"--executable\")\n";
-        build_cpp += "            {\n";
-        build_cpp += "                builder.set_output_type(\"executable\");\n";
-        build_cpp += "            }\n";
-        build_cpp += "            else if (arg == \"--static\")\n";
-        build_cpp += "            {\n";
-        build_cpp += "                builder.set_output_type(\"static\");\n";
-        build_cpp += "            }\n";
-        build_cpp += "            else if (arg == \"--dynamic\")\n";
-        build_cpp += "            {\n";
-        build_cpp += "                builder.set_output_type(\"dynamic\");\n";
-        build_cpp += "            }\n";
-        build_cpp += "            else if (arg == \"--help\")\n";
-        build_cpp += "            {\n";
-        build_cpp += "                std::cout << \"Usage: \" << argv[0] << \" [options]\\n\";\n";
-        build_cpp += "                std::cout << \"Options:\\n\";\n";
-        build_cpp += "                std::cout << \"  --debug          Build in debug mode\\n\";\n";
-        build_cpp += "                std::cout << \"  --release        Build in release mode\\n\";\n";
-        build_cpp += "                std::cout << \"  --executable     Build static executable (default)\\n\";\n";
-        build_cpp += "                std::cout << \"  --static         Build static library\\n\";\n";
-        build_cpp += "                std::cout << \"  --dynamic        Build dynamic library\\n\";\n";
-        build_cpp += "                std::cout << \"  --help           Show this help message\\n\";\n";
-        build_cpp += "                return 0;\n";
-        build_cpp += "            }\n";
-        build_cpp += "            else\n";
-        build_cpp += "            {\n";
-        build_cpp += "                std::cerr << \"Unknown option: \" << arg << std::endl;\n";
-        build_cpp += "                return 1;\n";
-        build_cpp += "            }\n";
-        build_cpp += "        }\n";
-        build_cpp += "        \n";
-        build_cpp += "        int result = builder.build();\n";
-        build_cpp += "        if (result == 0)\n";
-        build_cpp += "        {\n";
-        build_cpp += "            std::cout << \"Build completed!\" << std::endl;\n";
-        build_cpp += "        }\n";
-        build_cpp += "        return result;\n";
-        build_cpp += "    }\n";
-        build_cpp += "    catch (const std::exception& e)\n";
-        build_cpp += "    {\n";
-        build_cpp += "        std::cerr << \"Build failed: \" << e.what() << std::endl;\n";
-        build_cpp += "        return 1;\n";
-        build_cpp += "    }\n";
-        build_cpp += "}\n";
-        
-        write_file(project_path + "/builder.cpp", build_cpp);
+        write_generated_file(project_path + "/builder.cpp", render(build_cpp, { { "{{PROJECT_NAME}}", project_name } }));
     };
     
     // Create VSCode configuration
     auto create_vscode_config = [&]()
     {
-        std::cout << "Creating VSCode configuration..." << std::endl;
-        
-        // Create .vscode directory
-        fs::create_directories(fs::path(project_path) / fs::path(".vscode"));
-        
-        std::string vscode_settings = "{\n";
-        vscode_settings += "    \"C_Cpp.default.compilerPath\": \"/usr/bin/g++\",\n";
-        vscode_settings += "    \"C_Cpp.default.intelliSenseMode\": \"linux-gcc-x64\",\n";
-        vscode_settings += "    \"C_Cpp.default.cppStandard\": \"c++23\",\n";
-        vscode_settings += "    \"C_Cpp.default.cStandard\": \"c17\",\n";
-        vscode_settings += "    \"C_Cpp.default.includePath\": [\n";
-        vscode_settings += "        \"${workspaceFolder}/include\",\n";
-        vscode_settings += "        \"${workspaceFolder}/include/core\"\n";
-        vscode_settings += "    ],\n";
-        vscode_settings += "    \"C_Cpp.default.defines\": [],\n";
-        vscode_settings += "    \"editor.formatOnSave\": true,\n";
-        vscode_settings += "    \"files.associations\": {\n";
-        vscode_settings += "        \"*.hpp\": \"cpp\",\n";
-        vscode_settings += "        \"*.cpp\": \"cpp\",\n";
-        vscode_settings += "        \"*.h\": \"c\",\n";
-        vscode_settings += "        \"*.c\": \"c\"\n";
-        vscode_settings += "    },\n";
-        vscode_settings += "    \"C_Cpp.clang_format_style\": \"{ BasedOnStyle: LLVM, IndentWidth: 4, ColumnLimit: 100, BreakBeforeBraces: Allman }\"\n";
-        vscode_settings += "}";
+        if (!quiet)
+        {
+            std::cout << "Creating VSCode configuration...\n";
+        }
+        
+        constexpr std::string_view vscode_settings = R"({
+    "C_Cpp.default.compilerPath": "/usr/bin/g++",
+    "C_Cpp.default.intelliSenseMode": "linux-gcc-x64",
+    "C_Cpp.default.cppStandard": "c++23",
+    "C_Cpp.default.cStandard": "c17",
+    "C_Cpp.default.includePath": [
+        "${workspaceFolder}/include",
+        "${workspaceFolder}/include/core"
+    ],
+    "C_Cpp.default.defines": [],
+    "editor.formatOnSave": true,
+    "files.associations": {
+        "*.hpp": "cpp",
+        "*.cpp": "cpp",
+        "*.h": "c",
+        "*.c": "c"
+    },
+    "C_Cpp.clang_format_style": "{ BasedOnStyle: LLVM, IndentWidth: 4, ColumnLimit: 100, BreakBeforeBraces: Allman }"
+})";
         
         write_file(project_path + "/.vscode/settings.json", vscode_settings);
         
-        std::string vscode_tasks = "{\n";
-        vscode_tasks += "    \"version\": \"2.0.0\",\n";
-        vscode_tasks += "    \"tasks\": [\n";
-        vscode_tasks += "        {\n";
-        vscode_tasks += "            \"type\": \"shell\",\n";
-        vscode_tasks += "            \"label\": \"Compile Build System\",\n";
-        vscode_tasks += "            \"command\": \"g++\",\n";
-        vscode_tasks += "            \"args\": [\"-std=c++23\", \"builder.cpp\", \"-o\", \"builder\"],\n";
-        vscode_tasks += "            \"group\": \"build\",\n";
-        vscode_tasks += "            \"presentation\": {\n";
-        vscode_tasks += "                \"echo\": true,\n";
-        vscode_tasks += "                \"reveal\": \"always\",\n";
-        vscode_tasks += "                \"focus\": false,\n";
-        vscode_tasks += "                \"panel\": \"shared\",\n";
-        vscode_tasks += "                \"showReuseMessage\": true,\n";
-        vscode_tasks += "                \"clear\": false\n";
-        vscode_tasks += "            },\n";
-        vscode_tasks += "            \"problemMatcher\": \"$gcc\"\n";
-        vscode_tasks += "        },\n";
-        vscode_tasks += "        {\n";
-        vscode_tasks += "            \"type\": \"shell\",\n";
-        vscode_tasks += "            \"label\": \"Build Debug Executable\",\n";
-        vscode_tasks += "            \"command\": \"./builder\",\n";
-        vscode_tasks += "            \"args\": [\"--debug\", \"--executable\"],\n";
-        vscode_tasks += "            \"group\": {\n";
-        vscode_tasks += "                \"kind\": \"build\",\n";
-        vscode_tasks += "                \"isDefault\": true\n";
-        vscode_tasks += "            },\n";
-        vscode_tasks += "            \"dependsOn\": \"Compile Build System\",\n";
-        vscode_tasks += "            \"presentation\": {\n";
-        vscode_tasks += "                \"echo\": true,\n";
-        vscode_tasks += "                \"reveal\": \"always\",\n";
-        vscode_tasks += "                \"focus\": false,\n";
-        vscode_tasks += "                \"panel\": \"shared\",\n";
-        vscode_tasks += "                \"showReuseMessage\": true,\n";
-        vscode_tasks += "                \"clear\": false\n";
-        vscode_tasks += "            },\n";
-        vscode_tasks += "            \"problemMatcher\": \"$gcc\"\n";
-        vscode_tasks += "        },\n";
-        vscode_tasks += "        {\n";
-        vscode_tasks += "            \"type\": \"shell\",\n";
-        vscode_tasks += "            \"label\": \"Build Release Executable\",\n";
-        vscode_tasks += "            \"command\": \"./builder\",\n";
-        vscode_tasks += "            \"args\": [\"--release\", \"--executable\"],\n";
-        vscode_tasks += "            \"group\": \"build\",\n";
-        vscode_tasks += "            \"dependsOn\": \"Compile Build System\",\n";
-        vscode_tasks += "            \"presentation\": {\n";
-        vscode_tasks += "                \"echo\": true,\n";
-        vscode_tasks += "                \"reveal\": \"always\",\n";
-        vscode_tasks += "                \"focus\": false,\n";
-        vscode_tasks += "                \"panel\": \"shared\",\n";
-        vscode_tasks += "                \"showReuseMessage\": true,\n";
-        vscode_tasks += "                \"clear\": false\n";
-        vscode_tasks += "            },\n";
-        vscode_tasks += "            \"problemMatcher\": \"$gcc\"\n";
-        vscode_tasks += "        },\n";
-        vscode_tasks += "        {\n";
-        vscode_tasks += "            \"type\": \"shell\",\n";
-        vscode_tasks += "            \"label\": \"Build Static Library\",\n";
-        vscode_tasks += "            \"command\": \"./builder\",\n";
-        vscode_tasks += "            \"args\": [\"--release\", \"--static\"],\n";
-        vscode_tasks += "            \"group\": \"build\",\n";
-        vscode_tasks += "            \"dependsOn\": \"Compile Build System\",\n";
-        vscode_tasks += "            \"presentation\": {\n";
-        vscode_tasks += "                \"echo\": true,\n";
-        vscode_tasks += "                \"reveal\": \"always\",\n";
-        vscode_tasks += "                \"focus\": false,\n";
-        vscode_tasks += "                \"panel\": \"shared\",\n";
-        vscode_tasks += "                \"showReuseMessage\": true,\n";
-        vscode_tasks += "                \"clear\": false\n";
-        vscode_tasks += "            },\n";
-        vscode_tasks += "            \"problemMatcher\": \"$gcc\"\n";
-        vscode_tasks += "        }\n";
-        vscode_tasks += "    ]\n";
-        vscode_tasks += "}";
+        constexpr std::string_view vscode_tasks = R"({
+    "version": "2.0.0",
+    "tasks": [
+        {
+            "type": "shell",
+            "label": "Compile Build System",
+            "command": "g++",
+            "args": ["-std=c++23", "builder.cpp", "-o", "builder"],
+            "group": "build",
+            "presentation": {
+                "echo": true,
+                "reveal": "always",
+                "focus": false,
+                "panel": "shared",
+                "showReuseMessage": true,
+                "clear": false
+            },
+            "problemMatcher": "$gcc"
+        },
+        {
+            "type": "shell",
+            "label": "Build Debug Executable",
+            "command": "./builder",
+            "args": ["--debug", "--executable"],
+            "group": {
+                "kind": "build",
+                "isDefault": true
+            },
+            "dependsOn": "Compile Build System",
+            "presentation": {
+                "echo": true,
+                "reveal": "always",
+                "focus": false,
+                "panel": "shared",
+                "showReuseMessage": true,
+                "clear": false
+            },
+            "problemMatcher": "$gcc"
+        },
+        {
+            "type": "shell",
+            "label": "Build Release Executable",
+            "command": "./builder",
+            "args": ["--release", "--executable"],
+            "group": "build",
+            "dependsOn": "Compile Build System",
+            "presentation": {
+                "echo": true,
+                "reveal": "always",
+                "focus": false,
+                "panel": "shared",
+                "showReuseMessage": true,
+                "clear": false
+            },
+            "problemMatcher": "$gcc"
+        },
+        {
+            "type": "shell",
+            "label": "Build Static Library",
+            "command": "./builder",
+            "args": ["--release", "--static"],
+            "group": "build",
+            "dependsOn": "Compile Build System",
+            "presentation": {
+                "echo": true,
+                "reveal": "always",
+                "focus": false,
+                "panel": "shared",
+                "showReuseMessage": true,
+                "clear": false
+            },
+            "problemMatcher": "$gcc"
+        }
+    ]
+})";
         
         write_file(project_path + "/.vscode/tasks.json", vscode_tasks);
     };
@@ -1224,139 +9983,293 @@ int main()
     // Create README file
     auto create_readme = [&]()
     {
-        std::cout << "Creating README..." << std::endl;
-        
-        std::string readme_content = "# " + project_name + "\n\n";
-        readme_content += "A minimalistic C++ project with command-line build system.\n\n";
-        readme_content += "## Features\n\n";
-        readme_content += "- Modern C++23 support\n";
-        readme_content += "- Command-line build system (no CMake/Makefile required)\n";
-        readme_content += "- Support for static executables, static libraries, and dynamic libraries\n";
-        readme_content += "- VSCode configuration\n";
-        readme_content += "- Template header files (asyncops.hpp, raiiiofsw.hpp, stringformers.hpp, utilities.hpp)\n";
-        readme_content += "- Pythonic naming convention (PascalCase for classes, snake_case for everything else)\n";
-        readme_content += "- Allman indentation style\n\n";
-        readme_content += "## Project Structure\n\n";
-        readme_content += "```\n";
-        readme_content += project_name + "/\n";
-        readme_content += "├── include/                 # Header files (including template headers)\n";
-        readme_content += "│   └── core/               # Core template headers\n";
-        readme_content += "│       ├── asyncops.hpp    # Async operations & coroutines\n";
-        readme_content += "│       ├── raiiiofsw.hpp   # RAII filesystem wrappers\n";
-        readme_content += "│       ├── stringformers.hpp # String formatting utilities\n";
-        readme_content += "│       └── utilities.hpp   # General utility functions\n";
-        readme_content += "├── src/                     # Source files\n";
-        readme_content += "├── tests/                   # Test files\n";
-        readme_content += "├── build/                   # Build outputs\n";
-        readme_content += "│   ├── debug/              # Debug builds\n";
-        readme_content += "│   └── release/            # Release builds\n";
-        readme_content += "├── .vscode/                 # VSCode configuration\n";
-        readme_content += "├── builder.cpp              # Build system source\n";
-        readme_content += "└── README.md                # This file\n";
-        readme_content += "```\n\n";
-        readme_content += "## Build Instructions\n\n";
-        readme_content += "### Initial Setup\n\n";
-        readme_content += "1. Compile the build system:\n";
-        readme_content += "```bash\n";
-        readme_content += "g++ -std=c++23 builder.cpp -o builder\n";
-        readme_content += "```\n\n";
-        readme_content += "### Building the Project\n\n";
-        readme_content += "#### Build static executable (default):\n";
-        readme_content += "```bash\n";
-        readme_content += "./builder --release --executable\n";
-        readme_content += "```\n\n";
-        readme_content += "#### Build in debug mode:\n";
-        readme_content += "```bash\n";
-        readme_content += "./builder --debug --executable\n";
-        readme_content += "```\n\n";
-        readme_content += "#### Build static library:\n";
-        readme_content += "```bash\n";
-        readme_content += "./builder --release --static\n";
-        readme_content += "```\n\n";
-        readme_content += "#### Build dynamic library:\n";
-        readme_content += "```bash\n";
-        readme_content += "./builder --release --dynamic\n";
-        readme_content += "```\n\n";
-        readme_content += "### Build Options\n\n";
-        readme_content += "- `--debug`: Build in debug mode (with debugging symbols)\n";
-        readme_content += "- `--release`: Build in release mode (optimized)\n";
-        readme_content += "- `--executable`: Build static executable (default)\n";
-        readme_content += "- `--static`: Build static library\n";
-        readme_content += "- `--dynamic`: Build dynamic library\n\n";
-        readme_content += "## Template Headers\n\n";
-        readme_content += "The following header files are automatically copied to `include/core/`:\n";
-        readme_content += "- `core/asyncops.hpp`: Async operations and coroutines utilities\n";
-        readme_content += "- `core/raiiiofsw.hpp`: RAII filesystem wrappers\n";
-        readme_content += "- `core/stringformers.hpp`: String formatting and manipulation utilities\n";
-        readme_content += "- `core/utilities.hpp`: General utility functions\n\n";
-        readme_content += "## Development\n\n";
-        readme_content += "The project follows these conventions:\n";
-        readme_content += "- **Classes/Structs**: PascalCase (e.g., `ExampleClass`)\n";
-        readme_content += "- **Methods/Variables/Constants**: snake_case (e.g., `get_name()`, `project_name_`)\n";
-        readme_content += "- **Indentation**: Allman style (braces on new lines)\n\n";
-        readme_content += "## Requirements\n\n";
-        readme_content += "- GCC 11+ or Clang 14+ with C++23 support\n";
-        readme_content += "- Linux x64 (Ubuntu/Debian)\n";
-        readme_content += "- Git (for vcpkg management)\n";
-        readme_content += "- Internet connection (for initial package downloads)\n\n";
-        readme_content += "## License\n\n";
-        readme_content += "This project is provided as-is for educational and development purposes.\n";
-        
-        write_file(project_path + "/README.md", readme_content);
-    };
-
-    try
-    {
-        if (argc != 2)
+        if (!quiet)
         {
-            std::string errmsg{ "Usage: "};
-            errmsg += argv[0];
-            errmsg += " <project_path>\n";
-            errmsg += "Example: ";
-            errmsg += argv[0];
-            errmsg += " ~/projects/my-new-project\n";
-            throw std::runtime_error(errmsg.c_str());
+            std::cout << "Creating README...\n";
         }
         
-        project_path = argv[1];
+        // {{PROJECT_NAME}} and {{CORE_TREE}} are substituted when the file is written
+        constexpr std::string_view readme_content = R"(# {{PROJECT_NAME}}
+
+A minimalistic C++ project with command-line build system.
+
+## Features
+
+- Modern C++23 support
+- Command-line build system (no CMake/Makefile required)
+- Support for static executables, static libraries, and dynamic libraries
+- VSCode configuration
+- Template header files (asyncops.hpp, raiiiofsw.hpp, containers.hpp, stringformers.hpp, utilities.hpp, bench.hpp, tracing.hpp, memory.hpp)
+- Pythonic naming convention (PascalCase for classes, snake_case for everything else)
+- Allman indentation style
+
+## Project Structure
+
+```
+{{PROJECT_NAME}}/
+├── include/                 # Header files (including template headers)
+│   └── core/               # Core template headers
+│       ├── asyncops.hpp    # Async operations & coroutines
+│       ├── raiiiofsw.hpp   # RAII filesystem wrappers
+│       ├── containers.hpp  # Flat hash containers and fast hashing
+│       ├── stringformers.hpp # String formatting utilities
+│       ├── utilities.hpp   # General utility functions
+│       ├── bench.hpp       # Micro-benchmark harness
+│       ├── tracing.hpp     # Hot-path tracing (Chrome trace / Perfetto)
+│       ├── memory.hpp      # Arenas and size-class pools (std::pmr)
+{{CORE_TREE}}├── src/                     # Source files
+├── tests/                   # Test files
+├── bench/                   # Benchmarks of the core headers (./builder --bench)
+├── build/                   # Build outputs
+│   ├── debug/              # Debug builds
+│   ├── release/            # Release builds
+│   └── bench/              # Benchmark build and results
+├── .vscode/                 # VSCode configuration
+├── builder.cpp              # Build system source
+└── README.md                # This file
+```
+
+## Build Instructions
+
+### Initial Setup
+
+1. Compile the build system:
+```bash
+g++ -std=c++23 builder.cpp -o builder
+```
+
+### Building the Project
+
+#### Build static executable (default):
+```bash
+./builder --release --executable
+```
+
+#### Build in debug mode:
+```bash
+./builder --debug --executable
+```
+
+#### Build static library:
+```bash
+./builder --release --static
+```
+
+#### Build dynamic library:
+```bash
+./builder --release --dynamic
+```
+
+### Build Options
+
+- `--debug`: Build in debug mode (with debugging symbols)
+- `--release`: Build in release mode (optimized)
+- `--release-lto`: Release build with link-time optimization (`-flto=auto`, LTRANS partitions in parallel)
+- `--pgo-gen`, `--pgo-use`: Two-stage profile-guided optimization: build instrumented, run the program on a representative workload (it writes `.gcda` files to `build/pgo`), then rebuild with the profile; `--pgo-use` combines with `--release-lto` and needs the other options of the `--pgo-gen` build
+- `--native`: Tune for the build machine's CPU (`-march=native`; the core headers are then included textually instead of imported as modules)
+- `--linker=mold|lld|gold|bfd`: Link with another linker (`-fuse-ld=`)
+- `--executable`: Build static executable (default)
+- `--static`: Build static library
+- `--dynamic`: Build dynamic library
+- `-j N`, `--jobs N`: Compile up to N translation units in parallel (default: all cores)
+- `--pch`: Precompile `include/core/core.hpp` and force-include it in every source
+- `--modules`, `--no-modules`: Import `pooriayousefi.core` from `include/core/modules` or use textual includes (modules are the default when present). GCC 12 cannot compile run-time ISA dispatch into a module, so module builds leave out the SSSE3/AVX2 kernels of `stringformers.hpp` (`DelimiterSet` runs scalar); use `--no-modules` or `--native` for them
+- `--bench`: Build `bench/` at `-O3 -march=native` into `build/bench` and run it; results go to `build/bench/results.{json,csv}` and are compared with `bench/baseline.csv`, which the first run pins
+- `--trace`: Define `POORIAYOUSEFI_CORE_TRACING` so `core::trace` zones, counters and histograms record (they compile to nothing otherwise)
+- `--time-report`: Time every compile and link (wall and CPU time, peak RSS), print the slowest translation units and headers, and write `build/<type>/time_report.json`; `--time-report=phases` adds GCC's `-ftime-report` parsing, template and code generation times (not in module builds)
+- `--no-cache`: Bypass the object cache (`$BUILDER_CACHE_DIR`, default `build/cache`)
+
+Rebuilds are incremental: only sources whose file or included headers changed are recompiled.
+
+## Template Headers
+
+The following header files are automatically copied to `include/core/`:
+- `core/asyncops.hpp`: Async operations and coroutines utilities
+- `core/raiiiofsw.hpp`: RAII filesystem wrappers
+- `core/containers.hpp`: Flat hash set/map and fast hashing
+- `core/stringformers.hpp`: String formatting and manipulation utilities
+- `core/utilities.hpp`: General utility functions
+- `core/bench.hpp`: Micro-benchmark harness (warmup, adaptive iterations, median/p99/MAD, perf counters, JSON/CSV)
+- `core/tracing.hpp`: Hot-path tracing (`CORE_TRACE_SCOPE` zones, counters, histograms) exported as Chrome trace / Perfetto JSON
+- `core/memory.hpp`: Bump arenas, size-class pools and per-thread instances of both as `std::pmr::memory_resource`
+- `core/core.hpp`: Umbrella header including all of the above (precompiled by `./builder --pch`)
+
+## Development
+
+The project follows these conventions:
+- **Classes/Structs**: PascalCase (e.g., `ExampleClass`)
+- **Methods/Variables/Constants**: snake_case (e.g., `get_name()`, `project_name_`)
+- **Indentation**: Allman style (braces on new lines)
+
+## Requirements
+
+- GCC 11+ or Clang 14+ with C++23 support
+- Linux x64 (Ubuntu/Debian)
+- Git (for vcpkg management)
+- Internet connection (for initial package downloads)
+
+## License
+
+This project is provided as-is for educational and development purposes.
+)";
+        constexpr std::string_view core_tree_modules = R"(│       ├── core.hpp        # Umbrella header (precompiled by --pch)
+│       └── modules/        # Module interface units (import pooriayousefi.core;)
+)";
+        constexpr std::string_view core_tree_headers = R"(│       └── core.hpp        # Umbrella header (precompiled by --pch)
+)";
         
-        // Expand ~ to home directory if needed
-        if (project_path.front() == '~')
+        write_generated_file(project_path + "/README.md", render(readme_content, {
+            { "{{PROJECT_NAME}}", project_name },
+            { "{{CORE_TREE}}", use_modules ? core_tree_modules : core_tree_headers } }));
+    };
+
+    // Create one project at the given path
+    // Expand ~ to home directory if needed
+    auto expand_path = [](std::string path)
+    {
+        if (path.front() == '~')
         {
             const char* home = std::getenv("HOME");
             if (home)
             {
-                project_path = std::string(home) + project_path.substr(1);
+                path = std::string(home) + path.substr(1);
             }
         }
-        
-        if (fs::exists(project_path))
+        return path;
+    };
+    
+    // Create one project at the given (expanded, validated) path
+    auto create_project = [&](const std::string& path)
+    {
+        project_path = path;
+        if (!quiet)
         {
-            std::string errmsg{ "Error: Directory already exists: " };
-            errmsg += project_path;
-            throw std::runtime_error(errmsg.c_str());
+            std::cout << "Creating C++ project: " << project_path << '\n';
         }
         
-        std::cout << "Creating C++ project: " << project_path << std::endl;
-        
-        fs::path path(project_path);
-        project_name = sanitize_cpp_name(path.stem().string());
+        fs::path project(project_path);
+        project_name = sanitize_cpp_name(project.stem().string());
         
         create_directory_structure();
         create_source_files();
+        create_bench_files();
         copy_template_headers();
         create_build_system();
         create_vscode_config();
         create_readme();
-            
-        std::cout << "\n=== Project Setup Complete ===" << std::endl;
-        std::cout << "Project: " << project_name << std::endl;
-        std::cout << "Location: " << fs::absolute(project_path) << std::endl;
-        std::cout << "\nNext steps:" << std::endl;
-        std::cout << "1. cd " << project_path << std::endl;
-        std::cout << "2. g++ -std=c++23 builder.cpp -o builder" << std::endl;
-        std::cout << "3. ./builder --release --executable" << std::endl;
-        std::cout << "4. ./build/release/" << project_name << std::endl;
+        
+        if (!quiet)
+        {
+            std::cout << "\n=== Project Setup Complete ===\n";
+            std::cout << "Project: " << project_name << '\n';
+            std::cout << "Location: " << fs::absolute(project_path) << '\n';
+            std::cout << "\nNext steps:\n";
+            std::cout << "1. cd " << project_path << '\n';
+            std::cout << "2. g++ -std=c++23 builder.cpp -o builder\n";
+            std::cout << "3. ./builder --release --executable\n";
+            std::cout << "4. ./build/release/" << project_name << std::endl;
+        }
+    };
+    
+    try
+    {
+        std::vector<std::string> project_paths;
+        bool many = false;
+        bool usage_error = false;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--modules")
+            {
+                use_modules = true;
+            }
+            else if (arg == "--quiet")
+            {
+                quiet = true;
+            }
+            else if (arg == "--batch")
+            {
+                batch = true;
+                quiet = true;
+            }
+            else if (arg == "--many")
+            {
+                many = true;
+            }
+            else if (arg.rfind("--", 0) != 0 && !arg.empty())
+            {
+                project_paths.push_back(arg);
+            }
+            else
+            {
+                usage_error = true;
+                break;
+            }
+        }
+        
+        if (usage_error || project_paths.empty() || (!many && project_paths.size() > 1))
+        {
+            std::string errmsg{ "Usage: "};
+            errmsg += argv[0];
+            errmsg += " <project_path> [--modules] [--quiet] [--batch]\n";
+            errmsg += "       ";
+            errmsg += argv[0];
+            errmsg += " --many <project_path>... [--modules] [--quiet] [--batch]\n";
+            errmsg += "  --modules  Also generate C++20 module interface units (include/core/modules)\n";
+            errmsg += "  --quiet    Print nothing but errors\n";
+            errmsg += "  --batch    Generate every file in memory first, then write them all concurrently (implies --quiet)\n";
+            errmsg += "  --many     Create every project path given, in one process\n";
+            errmsg += "Example: ";
+            errmsg += argv[0];
+            errmsg += " ~/projects/my-new-project\n";
+            throw std::runtime_error(errmsg.c_str());
+        }
+        
+        // Validate every path before creating anything, so a bad one does not leave earlier projects half-made
+        std::vector<fs::path> seen;
+        for (auto& path : project_paths)
+        {
+            path = expand_path(path);
+            if (fs::exists(path))
+            {
+                std::string errmsg{ "Error: Directory already exists: " };
+                errmsg += path;
+                throw std::runtime_error(errmsg.c_str());
+            }
+            fs::path normalized = fs::absolute(path).lexically_normal();
+            if (!normalized.has_filename())
+            {
+                normalized = normalized.parent_path();
+            }
+            if (std::find(seen.begin(), seen.end(), normalized) != seen.end())
+            {
+                std::string errmsg{ "Error: Project path given twice: " };
+                errmsg += path;
+                throw std::runtime_error(errmsg.c_str());
+            }
+            seen.push_back(normalized);
+        }
+        
+        // A failure while writing (e.g. a full disk) removes the project directories this run created
+        std::vector<std::string> created;
+        try
+        {
+            for (const auto& path : project_paths)
+            {
+                created.push_back(path);
+                create_project(path);
+            }
+            write_pending_files();
+        }
+        catch (...)
+        {
+            for (const auto& path : created)
+            {
+                std::error_code ignored;
+                fs::remove_all(path, ignored);
+            }
+            throw;
+        }
         
         return EXIT_SUCCESS;
     }